@@ -0,0 +1,81 @@
+/// @file
+/// @brief Minimal timing helpers shared by the cli benchmarks.
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+
+namespace bench
+{
+
+
+/// @brief Prevents the compiler from optimizing away a computed value.
+template <typename T> void DoNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r"(&value) : "memory");
+#else
+	const volatile void *volatile sink = &value;
+	(void)sink;
+#endif
+}
+
+
+/// @brief Repeatedly calls a function until enough time has passed to get a
+/// stable measurement.
+/// @param function The function to time.
+/// @returns The average number of nanoseconds taken by a single call.
+template <typename Function> double NanosecondsPerCall(Function &&function)
+{
+	using Clock = std::chrono::steady_clock;
+	constexpr std::chrono::milliseconds minimumDuration(200);
+
+	// warm up caches and any lazily initialized state
+	function();
+
+	std::size_t iterations = 1;
+	while(true)
+	{
+		const Clock::time_point start = Clock::now();
+		for(std::size_t i = 0; i < iterations; ++i)
+		{
+			function();
+		}
+		const Clock::duration elapsed = Clock::now() - start;
+		if(elapsed >= minimumDuration)
+		{
+			const double nanoseconds =
+			    std::chrono::duration<double, std::nano>(elapsed).count();
+			return nanoseconds / static_cast<double>(iterations);
+		}
+		iterations *= 2;
+	}
+}
+
+
+/// @brief Times a single call of a function.
+/// @returns The number of nanoseconds the call took.
+template <typename Function> double NanosecondsOnce(Function &&function)
+{
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start = Clock::now();
+	function();
+	return std::chrono::duration<double, std::nano>(Clock::now() - start)
+	    .count();
+}
+
+
+/// @brief Prints a single result line.
+/// @param name The name of the measured case.
+/// @param parameter The size parameter of the measured case.
+/// @param nanoseconds The measured time.
+inline void
+Report(const char *name, std::size_t parameter, double nanoseconds)
+{
+	std::printf("%-40s %10zu %14.1f ns\n", name, parameter, nanoseconds);
+}
+
+
+} // namespace bench
@@ -0,0 +1,99 @@
+/// @file
+/// @brief Measures runs of a command line with ten thousand generated
+/// options: exact flags with and without cli::abbreviations, abbreviated
+/// flags, and unknown flags that search for a suggestion.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+constexpr std::size_t optionCount = 10000;
+
+} // namespace
+
+
+int main()
+{
+	// names like a generated tool's, sharing long prefixes
+	std::vector<std::string> names;
+	names.reserve(optionCount);
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		names.push_back(
+		    "--module" + std::to_string(i / 100) + "-setting"
+		    + std::to_string(i % 100) + "-value");
+	}
+	std::vector<int> values(optionCount, 0);
+	std::vector<cli::GenericArgument> arguments;
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		arguments.push_back(cli::Argument(
+		    names[i].c_str(), values[i], cli::arity = cli::Arity::Unbounded()));
+	}
+	cli::CommandLine exact("benchmark", arguments.begin(), arguments.end());
+	cli::CommandLine abbreviating(
+	    "benchmark",
+	    arguments.begin(),
+	    arguments.end(),
+	    cli::abbreviations = true);
+
+	const std::array<const char *, 4> exactArgs{
+	    "--module7-setting42-value", "1", "--module99-setting99-value", "2"};
+	const std::array<const char *, 4> abbreviatedArgs{
+	    "--module7-setting42-v", "1", "--module99-setting99-v", "2"};
+	const std::array<const char *, 1> typo{"--module7-setting42-valeu"};
+	const std::array<const char *, 1> nearMiss{"--module7-setting42-vXYZe"};
+	const std::array<const char *, 1> unrelated{"--something-else"};
+
+	bench::Report(
+	    "exact flags:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(
+		        exact.TryRun("benchmark", exactArgs.size(), exactArgs.data()));
+	    }));
+	bench::Report(
+	    "exact flags, abbreviations enabled:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(abbreviating.TryRun(
+		        "benchmark", exactArgs.size(), exactArgs.data()));
+	    }));
+	bench::Report(
+	    "abbreviated flags:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(abbreviating.TryRun(
+		        "benchmark", abbreviatedArgs.size(), abbreviatedArgs.data()));
+	    }));
+	bench::Report(
+	    "unknown flag, typo suggested:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(
+		        exact.TryRun("benchmark", typo.size(), typo.data()));
+	    }));
+	bench::Report(
+	    "unknown flag, near miss:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(
+		        exact.TryRun("benchmark", nearMiss.size(), nearMiss.data()));
+	    }));
+	bench::Report(
+	    "unknown flag, nothing suggested:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(
+		        exact.TryRun("benchmark", unrelated.size(), unrelated.data()));
+	    }));
+	return 0;
+}
@@ -0,0 +1,80 @@
+/// @file
+/// @brief Measures the throughput of cli::CommandLine::Run() over a
+/// cli::ArgumentStream reading ten million null delimited positional values
+/// from a file descriptor.  The values are counted by a destination that does
+/// not allocate, so memory use stays at the size of the stream's buffer.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace
+{
+
+constexpr std::size_t entries = 10000000;
+constexpr const char *path = "argument_stream_benchmark.bin";
+
+struct Counter
+{
+	std::size_t count = 0;
+};
+
+bool CLIParse(Counter &counter, const char *input)
+{
+	counter.count += input[0] != '\0';
+	return true;
+}
+
+// writes the input file, returning its size in bytes
+std::size_t Write()
+{
+	std::FILE *file = std::fopen(path, "wb");
+	std::size_t size = 0;
+	char line[64];
+	for(std::size_t i = 0; i < entries; ++i)
+	{
+		const int length = std::snprintf(
+		    line, sizeof(line), "data/shard%zu/record%zu", i % 64, i);
+		std::fwrite(line, 1, length + 1, file);
+		size += length + 1;
+	}
+	std::fclose(file);
+	return size;
+}
+
+} // namespace
+
+
+int main()
+{
+	const std::size_t size = Write();
+	for(const std::size_t bufferSize : {4096U, 65536U, 1048576U})
+	{
+		Counter counter;
+		cli::CommandLine commandLine(
+		    "benchmark",
+		    {cli::Argument(
+		        "values", counter, cli::arity = cli::Arity::Unbounded())});
+
+		const int fd = ::open(path, O_RDONLY);
+		cli::ArgumentStream stream(
+		    fd, cli::ArgumentStream::Delimiter::NUL, bufferSize);
+		const double nanoseconds = bench::NanosecondsOnce(
+		    [&]() { commandLine.TryRun("benchmark", stream); });
+		::close(fd);
+
+		bench::Report("stream run, buffer size", bufferSize, nanoseconds);
+		std::printf(
+		    "%-40s %10zu %14.1f MB/s\n",
+		    "  throughput",
+		    counter.count,
+		    size / (nanoseconds / 1e9) / 1e6);
+	}
+	std::remove(path);
+	return 0;
+}
@@ -0,0 +1,105 @@
+/// @file
+/// @brief Measures cli::RunBatch() over two million command lines with pools
+/// of increasing size.  Throughput should scale with the number of threads up
+/// to the number of hardware threads.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+constexpr std::size_t lineCount = 2000000;
+
+struct Request
+{
+	std::optional<int> id;
+	bool verbose;
+	std::optional<std::string> user;
+	std::vector<std::string> paths;
+};
+
+std::string MakeLines()
+{
+	std::string lines;
+	char line[128];
+	for(std::size_t i = 0; i < lineCount; ++i)
+	{
+		const int length = std::snprintf(
+		    line,
+		    sizeof(line),
+		    "--id %zu %s--user user%zu src/a%zu.cpp src/b.cpp\n",
+		    i,
+		    i % 3 == 0 ? "--verbose " : "",
+		    i % 100,
+		    i % 1000);
+		lines.append(line, length);
+	}
+	return lines;
+}
+
+} // namespace
+
+
+int main()
+{
+	const cli::CommandLine commandLine(
+	    "benchmark",
+	    {cli::Argument<&Request::id>("--id"),
+	     cli::StoreTrue<&Request::verbose>("--verbose"),
+	     cli::Argument<&Request::user>("--user"),
+	     cli::Argument<&Request::paths>("paths")});
+
+	const std::string lines = MakeLines();
+	// lines are tokenized in place, so each run gets a fresh copy
+	std::string copy;
+
+	std::vector<std::size_t> threadCounts{1, 2, 4, 8};
+	const std::size_t hardwareThreads = std::thread::hardware_concurrency();
+	if(hardwareThreads > 8)
+	{
+		threadCounts.push_back(hardwareThreads);
+	}
+
+	for(const std::size_t threadCount : threadCounts)
+	{
+		cli::ThreadPool pool(threadCount);
+		copy = lines;
+		cli::BatchInput input(copy.data(), copy.size());
+		std::atomic<std::size_t> failures(0);
+		const double nanoseconds = bench::NanosecondsOnce([&]() {
+			cli::RunBatch<Request>(
+			    commandLine,
+			    "benchmark",
+			    input,
+			    pool,
+			    [&](std::size_t, Request &request, const cli::ParseResult &r) {
+				    if(!r)
+				    {
+					    ++failures;
+				    }
+				    bench::DoNotOptimize(request);
+			    });
+		});
+		if(failures.load() != 0)
+		{
+			std::printf("%zu lines failed\n", failures.load());
+			return 1;
+		}
+		bench::Report(
+		    "wall time per line, threads:",
+		    threadCount,
+		    nanoseconds / static_cast<double>(lineCount));
+	}
+	return 0;
+}
@@ -0,0 +1,99 @@
+/// @file
+/// @brief Measures parse throughput when many threads share one immutable
+/// cli::CommandLine, each parsing into its own object with its own
+/// cli::ParseContext.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+struct Request
+{
+	bool verbose;
+	std::optional<std::string> user;
+	std::optional<std::string> mode;
+	std::vector<std::string> paths;
+};
+
+constexpr std::array<const char *, 9> argv{
+    "--verbose",
+    "--user",
+    "admin",
+    "--mode",
+    "fast",
+    "a.txt",
+    "b.txt",
+    "c.txt",
+    "d.txt"};
+
+constexpr std::size_t parsesPerThread = 200000;
+
+} // namespace
+
+
+int main()
+{
+	const cli::CommandLine commandLine(
+	    "benchmark",
+	    {cli::StoreTrue<&Request::verbose>("--verbose"),
+	     cli::Argument<&Request::user>("--user"),
+	     cli::Argument<&Request::mode>("--mode"),
+	     cli::Argument<&Request::paths>("paths")});
+
+	std::vector<std::size_t> threadCounts{1, 2, 4, 8};
+	const std::size_t hardwareThreads = std::thread::hardware_concurrency();
+	if(hardwareThreads > 8)
+	{
+		threadCounts.push_back(hardwareThreads);
+	}
+
+	for(const std::size_t threadCount : threadCounts)
+	{
+		std::atomic<bool> start(false);
+		std::vector<std::thread> threads;
+		for(std::size_t t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&]() {
+				cli::ParseContext context;
+				Request request;
+				while(!start.load())
+				{
+					std::this_thread::yield();
+				}
+				for(std::size_t i = 0; i < parsesPerThread; ++i)
+				{
+					request.paths.clear();
+					context.Bind(request);
+					commandLine.Run(
+					    context, "benchmark", argv.size(), argv.data());
+					bench::DoNotOptimize(request);
+				}
+			});
+		}
+
+		const double nanoseconds = bench::NanosecondsOnce([&]() {
+			start.store(true);
+			for(std::thread &thread : threads)
+			{
+				thread.join();
+			}
+		});
+		const double parses =
+		    static_cast<double>(parsesPerThread * threadCount);
+		bench::Report(
+		    "wall time per parse, threads:", threadCount, nanoseconds / parses);
+	}
+	return 0;
+}
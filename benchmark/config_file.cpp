@@ -0,0 +1,114 @@
+/// @file
+/// @brief Measures filling a hundred thousand options from a config file,
+/// against giving the same values on the command line, and reading a config
+/// file with a single array of a hundred thousand elements.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+constexpr std::size_t sectionCount = 100;
+constexpr std::size_t keyCount = 1000;
+constexpr std::size_t optionCount = sectionCount * keyCount;
+
+// writes a file to the working directory, returning its path
+std::string WriteFile(const char *path, const std::string &contents)
+{
+	std::FILE *file = std::fopen(path, "wb");
+	std::fwrite(contents.data(), 1, contents.size(), file);
+	std::fclose(file);
+	return path;
+}
+
+} // namespace
+
+
+int main()
+{
+	std::string contents;
+	std::vector<std::string> flags;
+	for(std::size_t section = 0; section < sectionCount; ++section)
+	{
+		contents += "[section" + std::to_string(section) + "]\n";
+		for(std::size_t key = 0; key < keyCount; ++key)
+		{
+			const std::string name = "key" + std::to_string(key);
+			contents += name + " = " + std::to_string(key) + '\n';
+			flags.push_back(
+			    "--section" + std::to_string(section) + '.' + name);
+		}
+	}
+	const std::string entriesPath =
+	    WriteFile("config_file_entries.ini", contents);
+
+	std::vector<int> values(optionCount, 0);
+	std::vector<cli::GenericArgument> arguments;
+	std::vector<std::string> valueStrings;
+	std::vector<const char *> args;
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		arguments.push_back(cli::Argument(
+		    flags[i].c_str(),
+		    values[i],
+		    cli::arity = cli::Arity::Optional()));
+		valueStrings.push_back(std::to_string(i % keyCount));
+	}
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		args.push_back(flags[i].c_str());
+		args.push_back(valueStrings[i].c_str());
+	}
+	cli::CommandLine test("benchmark", arguments.begin(), arguments.end());
+	cli::ParseContext context = test.MakeContext();
+	const char *const noArgs[] = {nullptr};
+
+	context.SetConfigFile(entriesPath.c_str());
+	bench::Report(
+	    "config file entries:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(test.TryRun(context, "benchmark", 0, noArgs));
+	    }));
+	context.SetConfigFile(nullptr);
+	bench::Report(
+	    "command line values:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(
+		        test.TryRun(context, "benchmark", args.size(), args.data()));
+	    }));
+
+	contents = "ids = [";
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		contents += std::to_string(i) + (i % 16 == 15 ? ",\n" : ", ");
+	}
+	contents += "]\n";
+	const std::string arrayPath = WriteFile("config_file_array.ini", contents);
+	std::vector<int> ids;
+	cli::CommandLine list(
+	    "benchmark",
+	    {cli::Argument("--ids", ids, cli::arity = cli::Arity::Unbounded())});
+	cli::ParseContext listContext = list.MakeContext();
+	listContext.SetConfigFile(arrayPath.c_str());
+	bench::Report(
+	    "config file array:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    ids.clear();
+		    bench::DoNotOptimize(
+		        list.TryRun(listContext, "benchmark", 0, noArgs));
+	    }));
+
+	std::remove(entriesPath.c_str());
+	std::remove(arrayPath.c_str());
+	return 0;
+}
@@ -0,0 +1,73 @@
+/// @file
+/// @brief Measures filling a hundred options bound to environment variables,
+/// with a process environment of a few hundred variables, against looking
+/// each one up with getenv() and parsing it separately.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+constexpr std::size_t optionCount = 100;
+constexpr std::size_t unrelatedCount = 200;
+
+} // namespace
+
+
+int main()
+{
+	std::vector<std::string> flags;
+	std::vector<std::string> variables;
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		flags.push_back("--setting" + std::to_string(i));
+		variables.push_back("APP_SETTING" + std::to_string(i));
+		::setenv(variables.back().c_str(), std::to_string(i).c_str(), 1);
+	}
+	for(std::size_t i = 0; i < unrelatedCount; ++i)
+	{
+		::setenv(("UNRELATED" + std::to_string(i)).c_str(), "value", 1);
+	}
+
+	std::vector<int> values(optionCount, 0);
+	std::vector<cli::GenericArgument> arguments;
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		arguments.push_back(cli::Argument(
+		    flags[i].c_str(),
+		    values[i],
+		    cli::arity = cli::Arity::Optional(),
+		    cli::environment = variables[i].c_str()));
+	}
+	cli::CommandLine test("benchmark", arguments.begin(), arguments.end());
+	cli::ParseContext context = test.MakeContext();
+	const char *const noArgs[] = {nullptr};
+
+	bench::Report(
+	    "environment keyword:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(test.TryRun(context, "benchmark", 0, noArgs));
+	    }));
+	bench::Report(
+	    "getenv per option:",
+	    optionCount,
+	    bench::NanosecondsPerCall([&]() {
+		    for(std::size_t i = 0; i < optionCount; ++i)
+		    {
+			    const char *const value = std::getenv(variables[i].c_str());
+			    if(value != nullptr)
+			    {
+				    bench::DoNotOptimize(cli::Parse(values[i], value));
+			    }
+		    }
+	    }));
+	return 0;
+}
@@ -0,0 +1,61 @@
+/// @file
+/// @brief Compares the cost of a failed run reported by a thrown exception with
+/// cli::CommandLine::TryRun(), which reports it in a cli::ParseResult.  Only
+/// TryRun() is measured when exceptions are disabled.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <stdexcept>
+
+
+int main()
+{
+	int count = 0;
+	bool verbose = false;
+	cli::CommandLine commandLine(
+	    "benchmark",
+	    {cli::Argument("--count", count),
+	     cli::StoreTrue("--verbose", verbose)});
+
+	const std::array<const char *, 3> unknown{"--verbose", "--cuont", "1"};
+	const std::array<const char *, 3> invalid{"--verbose", "--count", "x"};
+	const std::array<const char *, 3> valid{"--verbose", "--count", "1"};
+
+	bench::Report(
+	    "successful TryRun",
+	    0,
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(
+		        commandLine.TryRun("benchmark", valid.size(), valid.data()));
+	    }));
+
+	const auto measure = [&](const char *throwing,
+	                         const char *structured,
+	                         const std::array<const char *, 3> &argv) {
+#ifndef CLI_NO_EXCEPTIONS
+		bench::Report(throwing, 0, bench::NanosecondsPerCall([&]() {
+			              try
+			              {
+				              commandLine.Run(
+				                  "benchmark", argv.size(), argv.data());
+			              }
+			              catch(const std::exception &e)
+			              {
+				              bench::DoNotOptimize(e);
+			              }
+		              }));
+#else
+		(void)throwing;
+#endif
+		bench::Report(structured, 0, bench::NanosecondsPerCall([&]() {
+			              bench::DoNotOptimize(commandLine.TryRun(
+			                  "benchmark", argv.size(), argv.data()));
+		              }));
+	};
+	measure("unknown flag, Run and catch", "unknown flag, TryRun", unknown);
+	measure("invalid value, Run and catch", "invalid value, TryRun", invalid);
+	return 0;
+}
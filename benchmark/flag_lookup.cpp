@@ -0,0 +1,72 @@
+/// @file
+/// @brief Measures the cost of cli::CommandLine::Run() as the number of options
+/// grows.  The flag lookup table is built once per command line so the cost of
+/// a run should stay flat, unlike rebuilding a map on every run.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+int main()
+{
+	for(const std::size_t count : {10U, 100U, 1000U, 10000U})
+	{
+		std::vector<std::string> names;
+		std::vector<int> values(count, 0);
+		std::vector<cli::GenericArgument> arguments;
+		names.reserve(count);
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			names.push_back("--option" + std::to_string(i));
+		}
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			arguments.push_back(cli::Argument(
+			    names[i].c_str(),
+			    values[i],
+			    cli::arity = cli::Arity::Unbounded()));
+		}
+		cli::CommandLine commandLine(
+		    "benchmark", arguments.begin(), arguments.end());
+
+		const std::string last = names.back();
+		const std::array<const char *, 8> argv{
+		    "--option0",
+		    "1",
+		    "--option1",
+		    "2",
+		    last.c_str(),
+		    "3",
+		    "--option0",
+		    "4"};
+
+		bench::Report(
+		    "run with prebuilt lookup",
+		    count,
+		    bench::NanosecondsPerCall([&]() {
+			    commandLine.Run("benchmark", argv.size(), argv.data());
+			    bench::DoNotOptimize(values);
+		    }));
+
+		// what every run used to pay before parsing a single argument
+		bench::Report(
+		    "rebuild lookup map (old per-run cost)",
+		    count,
+		    bench::NanosecondsPerCall([&]() {
+			    std::unordered_map<std::string_view, std::size_t> lookup;
+			    for(std::size_t i = 0; i < count; ++i)
+			    {
+				    lookup.emplace(names[i], i);
+			    }
+			    bench::DoNotOptimize(lookup);
+		    }));
+	}
+	return 0;
+}
@@ -0,0 +1,76 @@
+/// @file
+/// @brief Measures runs of a command line with flag values given as separate
+/// arguments, as "--name=value", and as "--name=value" split into a newly
+/// allocated argv before running, as wrappers had to before it was supported.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+int main()
+{
+	int threads = 0;
+	double ratio = 0;
+	std::string_view name;
+	std::string_view output;
+	cli::CommandLine test(
+	    "benchmark",
+	    {cli::Argument("--threads", threads),
+	     cli::Argument("--ratio", ratio),
+	     cli::Argument("--name", name),
+	     cli::Argument("--output", output)});
+
+	const std::array<const char *, 8> separateArgs{
+	    "--threads",
+	    "8",
+	    "--ratio",
+	    "0.5",
+	    "--name",
+	    "job",
+	    "--output",
+	    "out.txt"};
+	const std::array<const char *, 4> inlineArgs{
+	    "--threads=8", "--ratio=0.5", "--name=job", "--output=out.txt"};
+
+	bench::Report(
+	    "separate values:",
+	    separateArgs.size(),
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(test.TryRun(
+		        "benchmark", separateArgs.size(), separateArgs.data()));
+	    }));
+	bench::Report(
+	    "inline values:",
+	    inlineArgs.size(),
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(test.TryRun(
+		        "benchmark", inlineArgs.size(), inlineArgs.data()));
+	    }));
+	bench::Report(
+	    "inline values, split first:",
+	    inlineArgs.size(),
+	    bench::NanosecondsPerCall([&]() {
+		    std::vector<std::string> strings;
+		    for(const char *arg : inlineArgs)
+		    {
+			    const char *const equals = std::strchr(arg, '=');
+			    strings.emplace_back(arg, equals);
+			    strings.emplace_back(equals + 1);
+		    }
+		    std::vector<const char *> split;
+		    for(const std::string &string : strings)
+		    {
+			    split.push_back(string.c_str());
+		    }
+		    bench::DoNotOptimize(
+		        test.TryRun("benchmark", split.size(), split.data()));
+	    }));
+	return 0;
+}
@@ -0,0 +1,85 @@
+/// @file
+/// @brief Measures running a command line with an option holding one hundred
+/// thousand comma separated numbers, converted eagerly and with a cli::Lazy
+/// that is read or left unread.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace
+{
+
+constexpr std::size_t weightCount = 100000;
+
+// an option value that is expensive to convert
+struct Weights
+{
+	std::vector<int> values;
+};
+
+bool CLIParse(Weights &weights, std::string_view input)
+{
+	weights.values.clear();
+	const char *position = input.data();
+	const char *const end = input.data() + input.size();
+	while(position != end)
+	{
+		int value = 0;
+		const std::from_chars_result result =
+		    std::from_chars(position, end, value);
+		if(result.ec != std::errc())
+		{
+			return false;
+		}
+		weights.values.push_back(value);
+		position = result.ptr == end ? end : result.ptr + 1;
+	}
+	return true;
+}
+
+template <typename T, typename Read>
+void Measure(const char *name, const std::string &weights, Read &&read)
+{
+	T destination;
+	cli::CommandLine commandLine(
+	    "benchmark", {cli::Argument("--weights", destination)});
+	const std::array<const char *, 2> args{"--weights", weights.c_str()};
+	const double nanoseconds = bench::NanosecondsPerCall([&]() {
+		commandLine.Run("benchmark", args.size(), args.data());
+		read(destination);
+		bench::DoNotOptimize(destination);
+	});
+	bench::Report(name, weightCount, nanoseconds);
+}
+
+} // namespace
+
+
+int main()
+{
+	std::string weights;
+	for(std::size_t i = 0; i < weightCount; ++i)
+	{
+		weights += std::to_string(i * 7919 % 100000);
+		weights += ',';
+	}
+	weights.pop_back();
+
+	Measure<Weights>("eager, per run:", weights, [](Weights &) {});
+	Measure<cli::Lazy<Weights>>(
+	    "cli::Lazy unread, per run:", weights, [](cli::Lazy<Weights> &) {});
+	Measure<cli::Lazy<Weights>>(
+	    "cli::Lazy read, per run:", weights, [](cli::Lazy<Weights> &lazy) {
+		    bench::DoNotOptimize(lazy.Get());
+	    });
+	return 0;
+}
@@ -0,0 +1,122 @@
+/// @file
+/// @brief Measures constructing and running a small command line with std
+/// containers and with std::pmr containers that share a cli::memoryResource,
+/// and counts the global allocations of each.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+std::size_t allocationCount = 0;
+
+} // namespace
+
+
+void *operator new(std::size_t size)
+{
+	allocationCount++;
+	if(void *pointer = std::malloc(size == 0 ? 1 : size))
+	{
+		return pointer;
+	}
+#ifdef CLI_NO_EXCEPTIONS
+	std::abort();
+#else
+	throw std::bad_alloc();
+#endif
+}
+
+void operator delete(void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+
+namespace
+{
+
+const std::array<const char *, 9> args{
+    "--limit",
+    "connections-per-host=16",
+    "--mode",
+    "incremental-with-checksums",
+    "--verbose",
+    "/srv/data/archive/2024/input.bin",
+    "/srv/data/archive/2025/input.bin",
+    "/srv/data/archive/2026/input.bin",
+    "/srv/data/archive/latest/input.bin"};
+
+template <typename Function> void Measure(const char *name, Function &&run)
+{
+	const double nanoseconds = bench::NanosecondsPerCall(run);
+	allocationCount = 0;
+	run();
+	const std::size_t allocations = allocationCount;
+	bench::Report(name, args.size(), nanoseconds);
+	std::printf("  allocations per run: %zu\n", allocations);
+}
+
+void RunDefault()
+{
+	std::vector<std::string> files;
+	std::map<std::string, int> limits;
+	std::string mode;
+	bool verbose = false;
+	cli::CommandLine commandLine(
+	    "benchmark",
+	    {cli::Argument("--limit", limits),
+	     cli::Argument("--mode", mode),
+	     cli::StoreTrue("--verbose", verbose),
+	     cli::Argument("files", files)});
+	commandLine.Run("benchmark", args.size(), args.data());
+	bench::DoNotOptimize(files);
+}
+
+void RunMemoryResource()
+{
+	std::array<std::byte, 4096> buffer;
+	std::pmr::monotonic_buffer_resource resource(
+	    buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+	std::pmr::vector<std::pmr::string> files(&resource);
+	std::pmr::map<std::pmr::string, int> limits(&resource);
+	std::pmr::string mode(&resource);
+	bool verbose = false;
+	cli::CommandLine commandLine(
+	    "benchmark",
+	    {cli::Argument("--limit", limits),
+	     cli::Argument("--mode", mode),
+	     cli::StoreTrue("--verbose", verbose),
+	     cli::Argument("files", files)},
+	    cli::memoryResource = &resource);
+	commandLine.Run("benchmark", args.size(), args.data());
+	bench::DoNotOptimize(files);
+}
+
+} // namespace
+
+
+int main()
+{
+	Measure("std containers, per run:", RunDefault);
+	Measure("cli::memoryResource, per run:", RunMemoryResource);
+	return 0;
+}
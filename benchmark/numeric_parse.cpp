@@ -0,0 +1,95 @@
+/// @file
+/// @brief Measures parsing one million values into a std::vector<int> and a
+/// std::vector<double> with cli::Parse() against the std::istringstream
+/// extraction it used before numbers had a dedicated parser.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+constexpr std::size_t valueCount = 1000000;
+
+template <typename T>
+bool StreamParse(std::vector<T> &vector, const char *input)
+{
+	std::istringstream iss(input);
+	T value;
+	iss >> value;
+	if(iss.fail())
+	{
+		return false;
+	}
+	vector.push_back(value);
+	return true;
+}
+
+template <typename T>
+void Measure(const char *name, const std::vector<std::string> &inputs)
+{
+	std::vector<T> values;
+	values.reserve(inputs.size());
+	const double parseNanoseconds = bench::NanosecondsOnce([&]() {
+		for(const std::string &input : inputs)
+		{
+			cli::Parse(values, input.c_str());
+		}
+	});
+	bench::DoNotOptimize(values);
+
+	std::vector<T> streamValues;
+	streamValues.reserve(inputs.size());
+	const double streamNanoseconds = bench::NanosecondsOnce([&]() {
+		for(const std::string &input : inputs)
+		{
+			StreamParse(streamValues, input.c_str());
+		}
+	});
+	bench::DoNotOptimize(streamValues);
+
+	if(values != streamValues)
+	{
+		std::printf("%s: cli::Parse() and stream extraction disagree\n", name);
+	}
+	const double count = static_cast<double>(inputs.size());
+	std::printf("%s\n", name);
+	bench::Report(
+	    "  cli::Parse, per value:", inputs.size(), parseNanoseconds / count);
+	bench::Report(
+	    "  std::istringstream, per value:",
+	    inputs.size(),
+	    streamNanoseconds / count);
+}
+
+} // namespace
+
+
+int main()
+{
+	std::vector<std::string> integers;
+	std::vector<std::string> reals;
+	integers.reserve(valueCount);
+	reals.reserve(valueCount);
+	char buffer[64];
+	for(std::size_t i = 0; i < valueCount; ++i)
+	{
+		const long long integer =
+		    static_cast<long long>(i * 2654435761ULL % 2000000000ULL)
+		    - 1000000000LL;
+		integers.push_back(std::to_string(integer));
+		std::snprintf(buffer, sizeof(buffer), "%.6g", integer / 4096.0);
+		reals.push_back(buffer);
+	}
+
+	Measure<int>("std::vector<int>", integers);
+	Measure<double>("std::vector<double>", reals);
+	return 0;
+}
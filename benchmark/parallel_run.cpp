@@ -0,0 +1,80 @@
+/// @file
+/// @brief Measures running a command line over fifty million numeric
+/// positional values stored into a single std::vector, converted on thread
+/// pools of increasing size.
+/// @details The number of values can be given as the first argument.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+void Measure(std::size_t threads, const std::vector<const char *> &argv)
+{
+	std::vector<double> values;
+	cli::CommandLine commandLine(
+	    "benchmark", {cli::Argument("values", values)});
+	cli::ParseContext context = commandLine.MakeContext();
+	cli::ThreadPool pool(threads);
+	context.SetThreadPool(&pool);
+	const double nanoseconds = bench::NanosecondsOnce([&]() {
+		commandLine.Run(
+		    context, "benchmark", static_cast<int>(argv.size()), argv.data());
+	});
+	bench::DoNotOptimize(values);
+	if(values.size() != argv.size())
+	{
+		std::printf("%zu threads: wrong number of values\n", threads);
+	}
+	std::printf(
+	    "%2zu threads, total: %10.1f ms, per value: %6.2f ns\n",
+	    threads,
+	    nanoseconds / 1e6,
+	    nanoseconds / static_cast<double>(argv.size()));
+}
+
+} // namespace
+
+
+int main(int argc, char **argv)
+{
+	const std::size_t valueCount =
+	    argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+
+	// all values live in one buffer so building the arguments stays cheap
+	std::string buffer;
+	std::vector<std::size_t> offsets;
+	offsets.reserve(valueCount);
+	for(std::size_t i = 0; i < valueCount; ++i)
+	{
+		offsets.push_back(buffer.size());
+		buffer += std::to_string(i * 7919 % 1000000000);
+		buffer += ".25";
+		buffer += '\0';
+	}
+	std::vector<const char *> values;
+	values.reserve(valueCount);
+	for(const std::size_t offset : offsets)
+	{
+		values.push_back(buffer.data() + offset);
+	}
+
+	std::printf(
+	    "%zu values, %u hardware threads\n",
+	    valueCount,
+	    std::thread::hardware_concurrency());
+	for(const std::size_t threads : {1, 2, 4, 8, 16})
+	{
+		Measure(threads, values);
+	}
+	return 0;
+}
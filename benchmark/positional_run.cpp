@@ -0,0 +1,66 @@
+/// @file
+/// @brief Measures running a command line over ten million numeric
+/// positional values stored into a single std::vector.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+constexpr std::size_t valueCount = 10000000;
+
+template <typename T>
+void Measure(const char *name, const std::vector<const char *> &argv)
+{
+	std::vector<T> values;
+	cli::CommandLine commandLine(
+	    "benchmark",
+	    {cli::Argument(
+	        "values", values, cli::arity = cli::Arity::Unbounded())});
+	const double nanoseconds = bench::NanosecondsOnce([&]() {
+		commandLine.Run(
+		    "benchmark", static_cast<int>(argv.size()), argv.data());
+	});
+	bench::DoNotOptimize(values);
+	if(values.size() != argv.size())
+	{
+		std::printf("%s: wrong number of values\n", name);
+	}
+	bench::Report(
+	    name, argv.size(), nanoseconds / static_cast<double>(argv.size()));
+}
+
+} // namespace
+
+
+int main()
+{
+	// all values live in one buffer so building argv stays cheap
+	std::string buffer;
+	std::vector<std::size_t> offsets;
+	offsets.reserve(valueCount);
+	for(std::size_t i = 0; i < valueCount; ++i)
+	{
+		offsets.push_back(buffer.size());
+		buffer += std::to_string(i * 7919 % 1000000000);
+		buffer += '\0';
+	}
+	std::vector<const char *> argv;
+	argv.reserve(valueCount);
+	for(const std::size_t offset : offsets)
+	{
+		argv.push_back(buffer.data() + offset);
+	}
+
+	Measure<int>("std::vector<int>, per value:", argv);
+	Measure<double>("std::vector<double>, per value:", argv);
+	Measure<std::string>("std::vector<std::string>, per value:", argv);
+	return 0;
+}
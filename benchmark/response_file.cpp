@@ -0,0 +1,84 @@
+/// @file
+/// @brief Measures expanding a response file with one million arguments, in
+/// both the newline and null delimited formats.  Arguments are counted by a
+/// destination that does not allocate so the cost of mapping and tokenizing
+/// the file dominates.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <cstdio>
+#include <string>
+
+
+namespace
+{
+
+constexpr std::size_t entries = 1000000;
+
+struct Counter
+{
+	std::size_t count = 0;
+};
+
+bool CLIParse(Counter &counter, const char *input)
+{
+	counter.count += input[0] != '\0';
+	return true;
+}
+
+void Write(const char *path, char delimiter)
+{
+	std::FILE *file = std::fopen(path, "wb");
+	char line[64];
+	for(std::size_t i = 0; i < entries; ++i)
+	{
+		const int length = std::snprintf(
+		    line, sizeof(line), "src/module%zu/file%zu.cpp", i % 100, i);
+		std::fwrite(line, 1, length, file);
+		std::fputc(delimiter, file);
+	}
+	std::fclose(file);
+}
+
+} // namespace
+
+
+int main()
+{
+	const std::array<std::pair<const char *, char>, 2> formats{
+	    {{"response_file_newline.rsp", '\n'},
+	     {"response_file_null.rsp", '\0'}}};
+
+	for(const auto &[path, delimiter] : formats)
+	{
+		Write(path, delimiter);
+		Counter counter;
+		cli::CommandLine commandLine(
+		    "benchmark",
+		    {cli::Argument(
+		        "files", counter, cli::arity = cli::Arity::Unbounded())},
+		    cli::responseFiles = true);
+		cli::ParseContext context = commandLine.MakeContext();
+
+		const std::string argument = std::string("@") + path;
+		const std::array<const char *, 1> argv{argument.c_str()};
+		// the first run faults the file into the page cache
+		commandLine.TryRun(context, "benchmark", 1, argv.data());
+		counter.count = 0;
+		const double nanoseconds = bench::NanosecondsOnce([&]() {
+			commandLine.TryRun(context, "benchmark", 1, argv.data());
+		});
+		bench::Report(
+		    delimiter == '\n' ? "newline delimited, whole run"
+		                      : "null delimited, whole run",
+		    counter.count,
+		    nanoseconds);
+		bench::Report(
+		    "  per argument", counter.count, nanoseconds / counter.count);
+		std::remove(path);
+	}
+	return 0;
+}
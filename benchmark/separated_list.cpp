@@ -0,0 +1,86 @@
+/// @file
+/// @brief Measures running a command line over a single "--values" list of
+/// one million comma separated elements, against splitting the list into
+/// std::string elements and parsing each of them.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+constexpr std::size_t elementCount = 1000000;
+
+template <typename T> void Measure(const char *name, const std::string &list)
+{
+	std::vector<T> values;
+	values.reserve(elementCount);
+	cli::CommandLine commandLine(
+	    "benchmark",
+	    {cli::Argument("--values", values, cli::separator = ',')});
+	const char *const argv[] = {"--values", list.c_str()};
+	const double nanoseconds = bench::NanosecondsOnce(
+	    [&]() { commandLine.Run("benchmark", 2, argv); });
+	bench::DoNotOptimize(values);
+	if(values.size() != elementCount)
+	{
+		std::printf("%s: wrong number of elements\n", name);
+	}
+	bench::Report(
+	    name, elementCount, nanoseconds / static_cast<double>(elementCount));
+}
+
+template <typename T>
+void MeasureSplitStrings(const char *name, const std::string &list)
+{
+	std::vector<T> values;
+	values.reserve(elementCount);
+	const double nanoseconds = bench::NanosecondsOnce([&]() {
+		std::size_t begin = 0;
+		for(;;)
+		{
+			const std::size_t end = list.find(',', begin);
+			const std::string element = list.substr(begin, end - begin);
+			cli::Parse(values, element.c_str());
+			if(end == std::string::npos)
+			{
+				break;
+			}
+			begin = end + 1;
+		}
+	});
+	bench::DoNotOptimize(values);
+	bench::Report(
+	    name, elementCount, nanoseconds / static_cast<double>(elementCount));
+}
+
+} // namespace
+
+
+int main()
+{
+	std::string list;
+	for(std::size_t i = 0; i < elementCount; ++i)
+	{
+		if(i != 0)
+		{
+			list += ',';
+		}
+		list += std::to_string(i * 7919 % 1000000000);
+	}
+
+	Measure<int>("separator, int, per element:", list);
+	MeasureSplitStrings<int>("split strings, int, per element:", list);
+	Measure<double>("separator, double, per element:", list);
+	MeasureSplitStrings<double>("split strings, double, per element:", list);
+	Measure<std::string>("separator, std::string, per element:", list);
+	MeasureSplitStrings<std::string>(
+	    "split strings, std::string, per element:", list);
+	return 0;
+}
@@ -0,0 +1,62 @@
+/// @file
+/// @brief Measures runs of a command line with boolean flags given by their
+/// long names, by their short names one per argument, and as a single
+/// cluster of short names.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+
+
+int main()
+{
+	std::array<bool, 6> flags{};
+	int level = 0;
+	cli::CommandLine test(
+	    "benchmark",
+	    {cli::StoreTrue("--extract", flags[0], cli::shortName = 'x'),
+	     cli::StoreTrue("--verbose", flags[1], cli::shortName = 'v'),
+	     cli::StoreTrue("--force", flags[2], cli::shortName = 'f'),
+	     cli::StoreTrue("--quiet", flags[3], cli::shortName = 'q'),
+	     cli::StoreTrue("--recursive", flags[4], cli::shortName = 'r'),
+	     cli::StoreTrue("--all", flags[5], cli::shortName = 'a'),
+	     cli::Argument("--level", level, cli::shortName = 'n')});
+
+	const std::array<const char *, 8> longArgs{
+	    "--extract",
+	    "--verbose",
+	    "--force",
+	    "--quiet",
+	    "--recursive",
+	    "--all",
+	    "--level",
+	    "3"};
+	const std::array<const char *, 8> shortArgs{
+	    "-x", "-v", "-f", "-q", "-r", "-a", "-n", "3"};
+	const std::array<const char *, 1> clusterArgs{"-xvfqran3"};
+
+	bench::Report(
+	    "long flags:",
+	    longArgs.size(),
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(
+		        test.TryRun("benchmark", longArgs.size(), longArgs.data()));
+	    }));
+	bench::Report(
+	    "short flags:",
+	    shortArgs.size(),
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(
+		        test.TryRun("benchmark", shortArgs.size(), shortArgs.data()));
+	    }));
+	bench::Report(
+	    "one cluster:",
+	    clusterArgs.size(),
+	    bench::NanosecondsPerCall([&]() {
+		    bench::DoNotOptimize(test.TryRun(
+		        "benchmark", clusterArgs.size(), clusterArgs.data()));
+	    }));
+	return 0;
+}
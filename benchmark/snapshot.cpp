@@ -0,0 +1,84 @@
+/// @file
+/// @brief Measures starting up from a response file of a thousand options
+/// and a hundred thousand positional values, parsing it cold against loading
+/// the snapshot of an earlier run.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+constexpr std::size_t optionCount = 1000;
+constexpr std::size_t valueCount = 100000;
+
+} // namespace
+
+
+int main()
+{
+	std::string contents;
+	std::vector<std::string> flags;
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		flags.push_back("--option" + std::to_string(i));
+		contents += flags.back() + "\nvalue" + std::to_string(i) + '\n';
+	}
+	for(std::size_t i = 0; i < valueCount; ++i)
+	{
+		contents += std::to_string(i * 7919) + '\n';
+	}
+	const char *const responsePath = "snapshot_startup.rsp";
+	std::FILE *file = std::fopen(responsePath, "wb");
+	std::fwrite(contents.data(), 1, contents.size(), file);
+	std::fclose(file);
+
+	std::vector<std::string> options(optionCount);
+	std::vector<long> values;
+	std::vector<cli::GenericArgument> arguments;
+	arguments.push_back(cli::Argument("values", values));
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		arguments.push_back(cli::Argument(flags[i].c_str(), options[i]));
+	}
+	cli::CommandLine test(
+	    "benchmark",
+	    arguments.begin(),
+	    arguments.end(),
+	    cli::responseFiles = true);
+	const std::string response = std::string("@") + responsePath;
+	const char *const args[] = {response.c_str()};
+
+	cli::ParseContext cold = test.MakeContext();
+	bench::Report(
+	    "cold parse:",
+	    valueCount,
+	    bench::NanosecondsPerCall([&]() {
+		    values.clear();
+		    bench::DoNotOptimize(test.TryRun(cold, "benchmark", 1, args));
+	    }));
+
+	const char *const snapshotPath = "snapshot_startup.snapshot";
+	cli::ParseContext cached = test.MakeContext();
+	cached.SetSnapshotFile(snapshotPath);
+	// the first run writes the snapshot
+	values.clear();
+	test.TryRun(cached, "benchmark", 1, args);
+	bench::Report(
+	    "snapshot load:",
+	    valueCount,
+	    bench::NanosecondsPerCall([&]() {
+		    values.clear();
+		    bench::DoNotOptimize(test.TryRun(cached, "benchmark", 1, args));
+	    }));
+
+	std::remove(responsePath);
+	std::remove(snapshotPath);
+	return 0;
+}
@@ -0,0 +1,42 @@
+/// @file
+/// @brief Measures the startup cost of a program using cli: constructing a
+/// cli::CommandLine and running it once.  Build once with and once without
+/// CLI_NO_EXCEPTIONS to compare the configurations, binary size is compared by
+/// the size of this executable.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+int main()
+{
+	const std::array<const char *, 8> argv{
+	    "startup", "--verbose", "--user", "admin", "--jobs", "4", "a", "b"};
+
+	bench::Report(
+	    "construct and run once",
+	    0,
+	    bench::NanosecondsPerCall([&]() {
+		    bool verbose;
+		    std::optional<std::string> user;
+		    int jobs = 1;
+		    std::vector<std::string> paths;
+		    cli::CommandLine commandLine(
+		        "benchmark",
+		        {cli::Help("--help"),
+		         cli::StoreTrue("--verbose", verbose),
+		         cli::Argument("--user", user),
+		         cli::Argument(
+		             "--jobs", jobs, cli::arity = cli::Arity::Optional()),
+		         cli::Argument("paths", paths)});
+		    bench::DoNotOptimize(commandLine.TryRun(argv.size(), argv.data()));
+		    bench::DoNotOptimize(paths);
+	    }));
+	return 0;
+}
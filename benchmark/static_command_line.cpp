@@ -0,0 +1,103 @@
+/// @file
+/// @brief Compares cli::StaticCommandLine with the dynamic cli::CommandLine on
+/// the same arguments.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <optional>
+#include <string>
+
+
+namespace
+{
+
+constexpr char verboseName[] = "--verbose";
+constexpr char quietName[] = "--quiet";
+constexpr char dryRunName[] = "--dry-run";
+constexpr char forceName[] = "--force";
+constexpr char inputName[] = "--input";
+constexpr char outputName[] = "--output";
+constexpr char modeName[] = "--mode";
+constexpr char userName[] = "--user";
+constexpr char fileName[] = "file";
+
+struct Options
+{
+	bool verbose;
+	bool quiet;
+	bool dryRun;
+	bool force;
+	char input[64];
+	char output[64];
+	std::optional<std::string> mode;
+	std::optional<std::string> user;
+	char file[64];
+};
+
+constexpr std::array<const char *, 13> argv{
+    "--verbose",
+    "--input",
+    "in.txt",
+    "--output",
+    "out.txt",
+    "--force",
+    "--mode",
+    "fast",
+    "--dry-run",
+    "--user",
+    "root",
+    "file.txt",
+    "--quiet"};
+
+} // namespace
+
+
+int main()
+{
+	Options options;
+
+	cli::CommandLine dynamic(
+	    "benchmark",
+	    {cli::StoreTrue(verboseName, options.verbose),
+	     cli::StoreTrue(quietName, options.quiet),
+	     cli::StoreTrue(dryRunName, options.dryRun),
+	     cli::StoreTrue(forceName, options.force),
+	     cli::Argument(inputName, options.input),
+	     cli::Argument(outputName, options.output),
+	     cli::Argument(modeName, options.mode),
+	     cli::Argument(userName, options.user),
+	     cli::Argument(fileName, options.file)});
+
+	const cli::StaticCommandLine static_(
+	    "benchmark",
+	    cli::StaticStoreTrue<verboseName>(options.verbose),
+	    cli::StaticStoreTrue<quietName>(options.quiet),
+	    cli::StaticStoreTrue<dryRunName>(options.dryRun),
+	    cli::StaticStoreTrue<forceName>(options.force),
+	    cli::StaticArgument<inputName>(options.input),
+	    cli::StaticArgument<outputName>(options.output),
+	    cli::StaticArgument<modeName>(options.mode),
+	    cli::StaticArgument<userName>(options.user),
+	    cli::StaticArgument<fileName>(options.file));
+
+	bench::Report(
+	    "dynamic CommandLine::Run",
+	    argv.size(),
+	    bench::NanosecondsPerCall([&]() {
+		    dynamic.Run("benchmark", argv.size(), argv.data());
+		    bench::DoNotOptimize(options);
+	    }));
+
+	bench::Report(
+	    "StaticCommandLine::Run",
+	    argv.size(),
+	    bench::NanosecondsPerCall([&]() {
+		    static_.Run("benchmark", argv.size(), argv.data());
+		    bench::DoNotOptimize(options);
+	    }));
+
+	return 0;
+}
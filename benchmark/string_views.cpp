@@ -0,0 +1,102 @@
+/// @file
+/// @brief Measures running a command line over one million path arguments
+/// stored into std::vector<std::string_view> and std::vector<std::string>,
+/// and counts the allocations of each run.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace
+{
+
+std::size_t allocationCount = 0;
+
+} // namespace
+
+
+void *operator new(std::size_t size)
+{
+	allocationCount++;
+	if(void *pointer = std::malloc(size == 0 ? 1 : size))
+	{
+		return pointer;
+	}
+#ifdef CLI_NO_EXCEPTIONS
+	std::abort();
+#else
+	throw std::bad_alloc();
+#endif
+}
+
+void operator delete(void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+
+namespace
+{
+
+constexpr std::size_t pathCount = 1000000;
+
+template <typename T>
+void Measure(const char *name, const std::vector<const char *> &argv)
+{
+	std::vector<T> paths;
+	cli::CommandLine commandLine(
+	    "benchmark",
+	    {cli::Argument("paths", paths, cli::arity = cli::Arity::Unbounded())});
+	allocationCount = 0;
+	const double nanoseconds = bench::NanosecondsOnce([&]() {
+		commandLine.Run(
+		    "benchmark", static_cast<int>(argv.size()), argv.data());
+	});
+	const std::size_t allocations = allocationCount;
+	bench::DoNotOptimize(paths);
+	bench::Report(
+	    name, argv.size(), nanoseconds / static_cast<double>(argv.size()));
+	std::printf("  allocations: %zu\n", allocations);
+}
+
+} // namespace
+
+
+int main()
+{
+	// all paths live in one buffer, like argv
+	std::string buffer;
+	std::vector<std::size_t> offsets;
+	offsets.reserve(pathCount);
+	for(std::size_t i = 0; i < pathCount; ++i)
+	{
+		offsets.push_back(buffer.size());
+		buffer += "/srv/data/archive/";
+		buffer += std::to_string(i);
+		buffer += "/input.bin";
+		buffer += '\0';
+	}
+	std::vector<const char *> argv;
+	argv.reserve(pathCount);
+	for(const std::size_t offset : offsets)
+	{
+		argv.push_back(buffer.data() + offset);
+	}
+
+	Measure<std::string_view>("std::string_view, per path:", argv);
+	Measure<std::string>("std::string, per path:", argv);
+	return 0;
+}
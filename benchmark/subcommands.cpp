@@ -0,0 +1,92 @@
+/// @file
+/// @brief Measures the startup cost of a program with one hundred
+/// subcommands of thirty options each: building every command line up front
+/// and picking one by name, against a cli::Subcommands that only builds the
+/// chosen one.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <array>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+constexpr std::size_t commandCount = 100;
+constexpr std::size_t optionCount = 30;
+
+std::vector<std::string> commandNames;
+std::vector<std::string> optionNames;
+std::array<std::optional<int>, optionCount> values;
+
+cli::CommandLine MakeCommandLine()
+{
+	std::vector<cli::GenericArgument> arguments;
+	arguments.reserve(optionCount);
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		arguments.push_back(cli::Argument(optionNames[i].c_str(), values[i]));
+	}
+	return cli::CommandLine("command", arguments.begin(), arguments.end());
+}
+
+} // namespace
+
+
+int main()
+{
+	for(std::size_t i = 0; i < commandCount; ++i)
+	{
+		commandNames.push_back("command-" + std::to_string(i));
+	}
+	for(std::size_t i = 0; i < optionCount; ++i)
+	{
+		optionNames.push_back("--option-" + std::to_string(i));
+	}
+	const std::array<const char *, 3> argv{
+	    "command-57", "--option-12", "7"};
+
+	bench::Report(
+	    "eager, construct and run once:",
+	    commandCount,
+	    bench::NanosecondsPerCall([&]() {
+		    std::vector<cli::CommandLine> commandLines;
+		    commandLines.reserve(commandCount);
+		    for(std::size_t i = 0; i < commandCount; ++i)
+		    {
+			    commandLines.push_back(MakeCommandLine());
+		    }
+		    for(std::size_t i = 0; i < commandCount; ++i)
+		    {
+			    if(commandNames[i] == argv[0])
+			    {
+				    bench::DoNotOptimize(commandLines[i].TryRun(
+				        "benchmark", argv.size() - 1, argv.data() + 1));
+			    }
+		    }
+	    }));
+
+	bench::Report(
+	    "cli::Subcommands, construct and run once:",
+	    commandCount,
+	    bench::NanosecondsPerCall([&]() {
+		    std::vector<cli::Subcommand> commands;
+		    commands.reserve(commandCount);
+		    for(std::size_t i = 0; i < commandCount; ++i)
+		    {
+			    commands.emplace_back(
+			        commandNames[i].c_str(), MakeCommandLine);
+		    }
+		    cli::Subcommands subcommands(
+		        "benchmark", commands.begin(), commands.end());
+		    bench::DoNotOptimize(
+		        subcommands.TryRun("benchmark", argv.size(), argv.data()));
+	    }));
+	return 0;
+}
@@ -0,0 +1,201 @@
+/// @file
+/// @brief Measures splitting a long command string into arguments with
+/// details::Tokenizer against a byte at a time baseline that applies the same
+/// quoting rules and allocates a string per argument.
+
+#include "Benchmark.hpp"
+
+#include "cli.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+// a command string of about size bytes with mostly long unquoted paths
+std::string MakeCommandString(std::size_t size)
+{
+	std::string command;
+	for(std::size_t i = 0; command.size() < size; ++i)
+	{
+		switch(i % 8)
+		{
+			case 0:
+				command += "--output ";
+				break;
+			case 3:
+				command += "'build/output directory/file" + std::to_string(i)
+				    + ".o' ";
+				break;
+			case 5:
+				command += "\"src/with \\\"quotes\\\"/file.cpp\" ";
+				break;
+			default:
+				command += "src/modules/module" + std::to_string(i % 100)
+				    + "/implementation/file" + std::to_string(i) + ".cpp ";
+				break;
+		}
+	}
+	return command;
+}
+
+// the quoting rules of details::Tokenizer, a byte at a time
+std::vector<std::string> Baseline(const std::string &command)
+{
+	std::vector<std::string> arguments;
+	std::string argument;
+	bool isArgument = false;
+	char quote = '\0';
+	for(std::size_t i = 0; i < command.size(); ++i)
+	{
+		const char c = command[i];
+		if(quote == '\'')
+		{
+			if(c == '\'')
+			{
+				quote = '\0';
+			}
+			else
+			{
+				argument += c;
+			}
+		}
+		else if(quote == '"')
+		{
+			if(c == '"')
+			{
+				quote = '\0';
+			}
+			else if(c == '\\' && i + 1 < command.size())
+			{
+				const char next = command[++i];
+				if(next != '$' && next != '`' && next != '"' && next != '\\'
+				   && next != '\n')
+				{
+					argument += '\\';
+				}
+				if(next != '\n')
+				{
+					argument += next;
+				}
+			}
+			else
+			{
+				argument += c;
+			}
+		}
+		else if(c == ' ' || (c >= '\t' && c <= '\r'))
+		{
+			if(isArgument)
+			{
+				arguments.push_back(std::move(argument));
+				argument.clear();
+				isArgument = false;
+			}
+		}
+		else
+		{
+			isArgument = true;
+			if(c == '\'' || c == '"')
+			{
+				quote = c;
+			}
+			else if(c == '\\' && i + 1 < command.size())
+			{
+				if(command[++i] != '\n')
+				{
+					argument += command[i];
+				}
+			}
+			else
+			{
+				argument += c;
+			}
+		}
+	}
+	if(isArgument)
+	{
+		arguments.push_back(std::move(argument));
+	}
+	return arguments;
+}
+
+} // namespace
+
+
+int main()
+{
+	for(const std::size_t size : {1024, 64 * 1024, 1024 * 1024})
+	{
+		const std::string command = MakeCommandString(size);
+
+		cli::details::Tokenizer tokenizer;
+		const double tokenizerNanoseconds = bench::NanosecondsPerCall([&]() {
+			tokenizer.Tokenize(command.data(), command.size());
+			bench::DoNotOptimize(tokenizer);
+		});
+		if(Baseline(command)
+		   != std::vector<std::string>(
+		       tokenizer.GetArguments(),
+		       tokenizer.GetArguments() + tokenizer.GetCount()))
+		{
+			std::printf("tokenizer and baseline disagree\n");
+			return 1;
+		}
+		const double baselineNanoseconds = bench::NanosecondsPerCall([&]() {
+			std::vector<std::string> arguments = Baseline(command);
+			bench::DoNotOptimize(arguments);
+		});
+
+		const double bytes = static_cast<double>(command.size());
+		bench::Report(
+		    "tokenizer, per KiB, bytes:",
+		    command.size(),
+		    tokenizerNanoseconds * 1024 / bytes);
+		bench::Report(
+		    "scalar baseline, per KiB, bytes:",
+		    command.size(),
+		    baselineNanoseconds * 1024 / bytes);
+
+		const char *const begin = command.data();
+		const char *const end = begin + command.size();
+		const double vectorNanoseconds = bench::NanosecondsPerCall([&]() {
+			std::size_t count = 0;
+			for(const char *c = begin; c != end; ++c)
+			{
+				c = cli::details::Tokenizer::FindSpecial(c, end);
+				if(c == end)
+				{
+					break;
+				}
+				++count;
+			}
+			bench::DoNotOptimize(count);
+		});
+		const double scalarNanoseconds = bench::NanosecondsPerCall([&]() {
+			std::size_t count = 0;
+			for(const char *c = begin; c != end; ++c)
+			{
+				c = cli::details::Tokenizer::FindSpecialScalar(c, end);
+				if(c == end)
+				{
+					break;
+				}
+				++count;
+			}
+			bench::DoNotOptimize(count);
+		});
+		bench::Report(
+		    "vector scan, per KiB, bytes:",
+		    command.size(),
+		    vectorNanoseconds * 1024 / bytes);
+		bench::Report(
+		    "scalar scan, per KiB, bytes:",
+		    command.size(),
+		    scalarNanoseconds * 1024 / bytes);
+	}
+	return 0;
+}
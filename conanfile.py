@@ -9,8 +9,8 @@ class CLIConanFile(ConanFile):
     url = "https://github.com/alexFickle/cli"
     settings = "os", "arch", "compiler", "build_type"
     generators = "cmake"
-    exports_sources = ("examples/*", "include/*", "test/*", "CMakeLists.txt",
-                       "LICENSE")
+    exports_sources = ("benchmark/*", "examples/*", "include/*", "test/*",
+                       "CMakeLists.txt", "LICENSE")
     # https://github.com/alexFickle/keyword
     requires = "keyword/0.0.0@fickle/testing"
     build_requires = "gtest/1.8.1@bincrafters/stable"
@@ -1,6 +1,5 @@
 #include "cli.hpp"
 
-#include <exception>
 #include <iostream>
 #include <optional>
 #include <string>
@@ -25,18 +24,16 @@ int main(int argc, const char *const *argv)
 	     cli::StoreTrue(
 	         "--bool", isBoolFlagGiven, help = "argumentless flag")});
 
-	try
+	const cli::ParseResult result = commandLine.TryRun(argc, argv);
+	if(!result)
 	{
-		if(commandLine.Run(argc, argv))
-		{
-			// informational flag was given
-			return 0;
-		}
+		std::cerr << result.GetMessage();
+		return 1;
 	}
-	catch(const std::exception &e)
+	if(result.IsExit())
 	{
-		std::cerr << e.what();
-		return 1;
+		// informational flag was given
+		return 0;
 	}
 
 	// use command line arguments
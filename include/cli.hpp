@@ -1,10 +1,22 @@
 #pragma once
 
 #include "cli/Argument.hpp"
+#include "cli/ArgumentStream.hpp"
 #include "cli/Arity.hpp"
+#include "cli/Batch.hpp"
 #include "cli/BooleanFlags.hpp"
 #include "cli/CommandLine.hpp"
+#include "cli/Config.hpp"
+#include "cli/ErrorHandler.hpp"
 #include "cli/GenericArgument.hpp"
 #include "cli/InfoFlags.hpp"
 #include "cli/Keywords.hpp"
+#include "cli/Lazy.hpp"
 #include "cli/Parse.hpp"
+#include "cli/ParseContext.hpp"
+#include "cli/ParseResult.hpp"
+#include "cli/Serialize.hpp"
+#include "cli/StaticArgument.hpp"
+#include "cli/StaticCommandLine.hpp"
+#include "cli/Subcommands.hpp"
+#include "cli/ThreadPool.hpp"
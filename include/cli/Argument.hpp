@@ -20,18 +20,56 @@ namespace cli
 /// argument then there must be no leading dashes.  If this argument is a option
 /// there must be two leading dashes.
 /// @param destination The destination of this argument.
-/// @param keywords Keyword arguments.  Suports cli::help and cli::arity.
+/// @param keywords Keyword arguments.  Suports cli::help, cli::arity,
+/// cli::separator, cli::shortName and cli::environment.
 /// @returns The created argument.
 template <typename T, typename... Keywords>
 GenericArgument Argument(const char *name, T &destination, Keywords... keywords)
 {
-	keyword::Arguments kwargs{keyword::Names{help, arity}, keywords...};
+	keyword::Arguments kwargs{
+	    keyword::Names{help, arity, separator, shortName, environment},
+	    keywords...};
 	return GenericArgument(
 	    GenericArgument::Kind::NORMAL,
 	    name,
 	    details::Destination(destination),
 	    kwargs.GetOrDefault(arity, details::GetDefaultArity(destination)),
-	    kwargs.GetOrDefault(help, ""));
+	    kwargs.GetOrDefault(help, ""),
+	    kwargs.GetOrDefault(separator, '\0'),
+	    kwargs.GetOrDefault(shortName, '\0'),
+	    kwargs.GetOrDefault(environment, nullptr));
+}
+
+
+/// @brief Creates a command line argument that stores to a data member of the
+/// object bound to a cli::ParseContext.
+/// @details Allows a single command line to be run by multiple threads at
+/// once, each parsing into its own object.
+/// @tparam Member Pointer to the data member that is the destination of this
+/// argument, for example &Options::count.
+/// @tparam Keywords Keyword argument types.
+/// @param name The name of this argument.  Follows the same rules as the
+/// overload taking a destination.
+/// @param keywords Keyword arguments.  Suports cli::help, cli::arity,
+/// cli::separator, cli::shortName and cli::environment.
+/// @returns The created argument.
+template <auto Member, typename... Keywords>
+GenericArgument Argument(const char *name, Keywords... keywords)
+{
+	using T = typename details::MemberTraits<Member>::value_type;
+	const T defaultValue{};
+	keyword::Arguments kwargs{
+	    keyword::Names{help, arity, separator, shortName, environment},
+	    keywords...};
+	return GenericArgument(
+	    GenericArgument::Kind::NORMAL,
+	    name,
+	    details::Destination::ForMember<Member>(),
+	    kwargs.GetOrDefault(arity, details::GetDefaultArity(defaultValue)),
+	    kwargs.GetOrDefault(help, ""),
+	    kwargs.GetOrDefault(separator, '\0'),
+	    kwargs.GetOrDefault(shortName, '\0'),
+	    kwargs.GetOrDefault(environment, nullptr));
 }
 
 
@@ -0,0 +1,178 @@
+/// @file
+/// @brief Contains cli::ArgumentStream.
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+
+namespace cli
+{
+
+
+/// @brief Reads delimited arguments from a file descriptor, as produced by
+/// "find -print0" or "ls", through a fixed size buffer.
+/// @details Memory use does not depend on the number of arguments, so a
+/// cli::CommandLine can be run over an unbounded stream, for example from
+/// stdin.  The buffer is allocated once when the stream is constructed and
+/// reading arguments does not allocate.  Null delimited streams yield every
+/// argument, newline delimited streams ignore a carriage return before a
+/// newline and skip empty lines.
+///
+/// An argument yielded by the stream is only valid until the next argument is
+/// read, destinations must copy any value they keep.
+class ArgumentStream
+{
+public:
+	/// @brief The character that ends each argument.
+	enum class Delimiter : char
+	{
+		NUL = '\0',
+		NEWLINE = '\n'
+	};
+
+	/// @brief Default size of the buffer.
+	static constexpr std::size_t defaultBufferSize = 64 * 1024;
+
+	/// @brief Constructor.
+	/// @param fd The file descriptor to read from.  Not closed by the stream.
+	/// @param delimiter The character that ends each argument.
+	/// @param bufferSize The size of the buffer, the longest argument that can
+	/// be read is one less.
+	explicit ArgumentStream(
+	    int fd,
+	    Delimiter delimiter = Delimiter::NUL,
+	    std::size_t bufferSize = defaultBufferSize)
+	    : _fd(fd)
+	    , _delimiter(static_cast<char>(delimiter))
+	    , _buffer(new char[bufferSize + 1])
+	    , _capacity(bufferSize)
+	{}
+
+	/// @brief Gets the next argument without consuming it.
+	/// @returns The argument or nullptr if the stream ended or failed.
+	const char *Peek()
+	{
+		while(_next == nullptr && _error == nullptr)
+		{
+			char *const begin = _buffer.get() + _begin;
+			char *const end = _buffer.get() + _end;
+			char *delimiter = static_cast<char *>(
+			    std::memchr(begin, _delimiter, end - begin));
+			if(delimiter == nullptr && _isEnd)
+			{
+				if(begin == end)
+				{
+					return nullptr;
+				}
+				// the final argument is not delimited, there is always room
+				// after the data for a terminator
+				delimiter = end;
+			}
+			if(delimiter == nullptr)
+			{
+				Fill();
+				continue;
+			}
+			*delimiter = '\0';
+			_begin = delimiter == end
+			    ? _end
+			    : static_cast<std::size_t>(delimiter - _buffer.get()) + 1;
+			if(_delimiter == '\n')
+			{
+				if(delimiter != begin && delimiter[-1] == '\r')
+				{
+					delimiter[-1] = '\0';
+					--delimiter;
+				}
+				if(delimiter == begin)
+				{
+					// skip empty lines
+					continue;
+				}
+			}
+			_next = begin;
+		}
+		return _next;
+	}
+
+	/// @brief Consumes the argument returned by Peek().
+	/// @pre Peek() returned an argument.
+	void Pop() noexcept
+	{
+		_next = nullptr;
+	}
+
+	/// @brief Gets a description of why the stream failed.
+	/// @returns The description or nullptr if the stream has not failed.
+	const char *GetError() const noexcept
+	{
+		return _error;
+	}
+
+private:
+	// moves any partial argument to the front of the buffer and reads more
+	void Fill()
+	{
+		const std::size_t partial = _end - _begin;
+		if(partial == _capacity)
+		{
+			_error = "Argument longer than the argument stream buffer.";
+			return;
+		}
+		std::memmove(_buffer.get(), _buffer.get() + _begin, partial);
+		_begin = 0;
+		_end = partial;
+
+		for(;;)
+		{
+#ifdef _WIN32
+			const int count = ::_read(
+			    _fd,
+			    _buffer.get() + _end,
+			    static_cast<unsigned>(_capacity - _end));
+#else
+			const ::ssize_t count =
+			    ::read(_fd, _buffer.get() + _end, _capacity - _end);
+#endif
+			if(count > 0)
+			{
+				_end += static_cast<std::size_t>(count);
+				return;
+			}
+			if(count == 0)
+			{
+				_isEnd = true;
+				return;
+			}
+			if(errno != EINTR)
+			{
+				_error = "Could not read from the argument stream.";
+				return;
+			}
+		}
+	}
+
+	int _fd;
+	char _delimiter;
+	std::unique_ptr<char[]> _buffer;
+	std::size_t _capacity;
+	// unconsumed data is in [_begin, _end)
+	std::size_t _begin = 0;
+	std::size_t _end = 0;
+	bool _isEnd = false;
+	// argument returned by Peek() that has not been popped
+	const char *_next = nullptr;
+	const char *_error = nullptr;
+};
+
+
+} // namespace cli
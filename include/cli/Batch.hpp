@@ -0,0 +1,225 @@
+/// @file
+/// @brief Contains cli::RunBatch() and cli::ParseBatch().
+#pragma once
+
+#include "cli/CommandLine.hpp"
+#include "cli/ErrorHandler.hpp"
+#include "cli/ParseContext.hpp"
+#include "cli/ParseResult.hpp"
+#include "cli/ThreadPool.hpp"
+#include "cli/details/Lines.hpp"
+#include "cli/details/MappedFile.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace cli
+{
+
+
+/// @brief Many command lines, one per line, to be run by cli::RunBatch() or
+/// cli::ParseBatch().
+/// @details Each line is split into arguments with POSIX shell quoting rules,
+/// see cli::CommandLine::TryRunInPlace().  Lines are tokenized in place,
+/// values parsed from them point into the input, which must outlive them.
+/// Every line is run, including empty ones, except that a final newline does
+/// not start another line.
+class BatchInput
+{
+public:
+	BatchInput() = default;
+
+	/// @brief Constructor from a buffer owned by the caller.
+	/// @param data The buffer.  Must hold size + 1 writable characters, the
+	/// last is set to a null character.
+	/// @param size The size of the lines in the buffer.
+	BatchInput(char *data, std::size_t size) noexcept
+	    : _data(data)
+	    , _size(size)
+	{
+		_data[_size] = '\0';
+	}
+
+	/// @brief Reads the lines of a file.
+	/// @details The file is mapped into memory where possible, changes to the
+	/// mapping are private to this input.
+	/// @param path The path of the file.
+	/// @returns False if the file could not be read.
+	bool Open(const char *path)
+	{
+		if(!_file.Open(path))
+		{
+			return false;
+		}
+		_data = _file.GetData();
+		_size = _file.GetSize();
+		return true;
+	}
+
+	/// @brief Gets the lines.
+	char *GetData() const noexcept
+	{
+		return _data;
+	}
+
+	/// @brief Gets the size of the lines.
+	std::size_t GetSize() const noexcept
+	{
+		return _size;
+	}
+
+private:
+	details::MappedFile _file;
+	char *_data = nullptr;
+	std::size_t _size = 0;
+};
+
+
+/// @brief The result of running a single line of a cli::BatchInput.
+template <typename Object> struct LineResult
+{
+	/// @brief The one based number of the line.
+	std::size_t line = 0;
+
+	/// @brief The object the line was parsed into.
+	Object object;
+
+	/// @brief The result of the run, indices in it are indices of the
+	/// arguments of the line.
+	ParseResult result;
+};
+
+
+namespace details
+{
+
+
+// runs every line of an input, binding each to the object returned by
+// getObject(line, worker) then calling onResult(line, object, result)
+template <typename Object, typename GetObject, typename OnResult>
+void RunLines(
+    const CommandLine &commandLine,
+    const char *name,
+    const Lines &lines,
+    ThreadPool &pool,
+    GetObject &&getObject,
+    OnResult &&onResult)
+{
+	std::vector<ParseContext> contexts;
+	contexts.reserve(pool.GetSize());
+	for(std::size_t i = 0; i < pool.GetSize(); ++i)
+	{
+		contexts.push_back(commandLine.MakeContext());
+		// threads must not interleave messages, and input must not print
+		contexts.back().SetPrintsMessages(false);
+	}
+
+	pool.ForEach(
+	    lines.GetChunkCount(), [&](std::size_t chunk, std::size_t worker) {
+		    ParseContext &context = contexts[worker];
+		    lines.ForEachLine(
+		        chunk, [&](std::size_t line, char *begin, char *end) {
+			        Object &object = getObject(line, worker);
+			        context.Bind(object);
+			        const ParseResult result =
+			            commandLine.TryRunInPlace(context, name, begin, end);
+			        onResult(line, object, result);
+		        });
+	    });
+}
+
+
+// fails unless runs of commandLine into different objects are independent
+template <typename Object>
+void CheckMemberwise(const CommandLine &commandLine, const char *function)
+{
+	if(!commandLine.IsMemberwise<Object>())
+	{
+		Throw<std::invalid_argument>(
+		    std::string("Invalid argument to cli::") + function
+		    + "().  Every argument must be created from a data member of "
+		      "the object type.");
+	}
+}
+
+
+} // namespace details
+
+
+/// @brief Runs a command line over every line of an input in parallel,
+/// calling a function with the result of each line.
+/// @details Lines are split into chunks that the threads of the pool process
+/// with work stealing.  Each thread parses into its own default constructed
+/// object, which is reset before each line.  Never throws on a failed line,
+/// failures are passed to the callback.  Help, usage and version flags print
+/// nothing, the result of their line is only marked with
+/// ParseResult::IsExit().
+/// @tparam Object The type of the object to parse each line into.
+/// @param commandLine The command line.  Every argument must be created from
+/// a data member of Object, otherwise std::invalid_argument is thrown.
+/// @param name The name of the program, used in help and usage messages.
+/// @param input The lines, which are tokenized in place.
+/// @param pool The threads to run on.
+/// @param callback Called as callback(line, object, result) for every line,
+/// where line is the one based line number, object is an Object& and result
+/// is a const cli::ParseResult&.  Called concurrently from the threads of the
+/// pool in no particular order, and must not throw.
+template <typename Object, typename Callback>
+void RunBatch(
+    const CommandLine &commandLine,
+    const char *name,
+    BatchInput &input,
+    ThreadPool &pool,
+    Callback &&callback)
+{
+	details::CheckMemberwise<Object>(commandLine, "RunBatch");
+	const details::Lines lines(input.GetData(), input.GetSize(), pool);
+	std::vector<Object> objects(pool.GetSize());
+	details::RunLines<Object>(
+	    commandLine,
+	    name,
+	    lines,
+	    pool,
+	    [&](std::size_t, std::size_t worker) -> Object & {
+		    objects[worker] = Object();
+		    return objects[worker];
+	    },
+	    callback);
+}
+
+
+/// @brief Runs a command line over every line of an input in parallel,
+/// returning the result of each line.
+/// @details See cli::RunBatch(), help, usage and version flags print
+/// nothing here either.  Each line is parsed directly into its result.
+/// @returns The results, where result i is of line i + 1.
+template <typename Object>
+std::vector<LineResult<Object>> ParseBatch(
+    const CommandLine &commandLine,
+    const char *name,
+    BatchInput &input,
+    ThreadPool &pool)
+{
+	details::CheckMemberwise<Object>(commandLine, "ParseBatch");
+	const details::Lines lines(input.GetData(), input.GetSize(), pool);
+	std::vector<LineResult<Object>> results(lines.GetLineCount());
+	details::RunLines<Object>(
+	    commandLine,
+	    name,
+	    lines,
+	    pool,
+	    [&](std::size_t line, std::size_t) -> Object & {
+		    return results[line - 1].object;
+	    },
+	    [&](std::size_t line, Object &, const ParseResult &result) {
+		    results[line - 1].line = line;
+		    results[line - 1].result = result;
+	    });
+	return results;
+}
+
+
+} // namespace cli
@@ -2,9 +2,12 @@
 
 #include "cli/GenericArgument.hpp"
 #include "cli/Keywords.hpp"
+#include "cli/details/Destination.hpp"
 
 #include "keyword.hpp"
 
+#include <type_traits>
+
 
 namespace cli
 {
@@ -15,19 +18,24 @@ namespace cli
 /// @tparam Keywords Keyword argument types.
 /// @param name The name of this argument.  Must have at least one leading dash.
 /// @param destination The boolean destination of this flag.
-/// @param keywords Keyword arguments.  Supports cli::help.
+/// @param keywords Keyword arguments.  Supports cli::help, cli::shortName
+/// and cli::environment.
 /// @returns The created argument.
 template <typename... Keywords>
 GenericArgument
 StoreTrue(const char *name, bool &destination, Keywords... keywords)
 {
 	destination = false;
-	keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+	keyword::Arguments kwargs{
+	    keyword::Names{help, shortName, environment}, keywords...};
 	return GenericArgument(
 	    GenericArgument::Kind::BOOL,
 	    name,
-	    destination,
-	    kwargs.GetOrDefault(help, ""));
+	    details::Destination(destination),
+	    true,
+	    kwargs.GetOrDefault(help, ""),
+	    kwargs.GetOrDefault(shortName, '\0'),
+	    kwargs.GetOrDefault(environment, nullptr));
 }
 
 
@@ -36,19 +44,82 @@ StoreTrue(const char *name, bool &destination, Keywords... keywords)
 /// @tparam Keywords Keyword argument types.
 /// @param name The name of this argument.  Must have at least one leading dash.
 /// @param destination The boolean destination of this flag.
-/// @param keywords Keyword arguments.  Supports cli::help.
+/// @param keywords Keyword arguments.  Supports cli::help, cli::shortName
+/// and cli::environment.
 /// @returns The created argument.
 template <typename... Keywords>
 GenericArgument
 StoreFalse(const char *name, bool &destination, Keywords... keywords)
 {
 	destination = true;
-	keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+	keyword::Arguments kwargs{
+	    keyword::Names{help, shortName, environment}, keywords...};
+	return GenericArgument(
+	    GenericArgument::Kind::BOOL,
+	    name,
+	    details::Destination(destination),
+	    false,
+	    kwargs.GetOrDefault(help, ""),
+	    kwargs.GetOrDefault(shortName, '\0'),
+	    kwargs.GetOrDefault(environment, nullptr));
+}
+
+
+/// @brief Creates a boolean flag with an inactive value of false and an active
+/// value of true that stores to a data member of the object bound to a
+/// cli::ParseContext.
+/// @details The member is set to false at the start of every run.
+/// @tparam Member Pointer to the boolean data member.
+/// @tparam Keywords Keyword argument types.
+/// @param name The name of this argument.  Must have at least one leading dash.
+/// @param keywords Keyword arguments.  Supports cli::help, cli::shortName
+/// and cli::environment.
+/// @returns The created argument.
+template <auto Member, typename... Keywords>
+GenericArgument StoreTrue(const char *name, Keywords... keywords)
+{
+	static_assert(std::is_same_v<
+	              typename details::MemberTraits<Member>::value_type,
+	              bool>);
+	keyword::Arguments kwargs{
+	    keyword::Names{help, shortName, environment}, keywords...};
+	return GenericArgument(
+	    GenericArgument::Kind::BOOL,
+	    name,
+	    details::Destination::ForMember<Member>(),
+	    true,
+	    kwargs.GetOrDefault(help, ""),
+	    kwargs.GetOrDefault(shortName, '\0'),
+	    kwargs.GetOrDefault(environment, nullptr));
+}
+
+
+/// @brief Creates a boolean flag with an inactive value of true and an active
+/// value of false that stores to a data member of the object bound to a
+/// cli::ParseContext.
+/// @details The member is set to true at the start of every run.
+/// @tparam Member Pointer to the boolean data member.
+/// @tparam Keywords Keyword argument types.
+/// @param name The name of this argument.  Must have at least one leading dash.
+/// @param keywords Keyword arguments.  Supports cli::help, cli::shortName
+/// and cli::environment.
+/// @returns The created argument.
+template <auto Member, typename... Keywords>
+GenericArgument StoreFalse(const char *name, Keywords... keywords)
+{
+	static_assert(std::is_same_v<
+	              typename details::MemberTraits<Member>::value_type,
+	              bool>);
+	keyword::Arguments kwargs{
+	    keyword::Names{help, shortName, environment}, keywords...};
 	return GenericArgument(
 	    GenericArgument::Kind::BOOL,
 	    name,
-	    destination,
-	    kwargs.GetOrDefault(help, ""));
+	    details::Destination::ForMember<Member>(),
+	    false,
+	    kwargs.GetOrDefault(help, ""),
+	    kwargs.GetOrDefault(shortName, '\0'),
+	    kwargs.GetOrDefault(environment, nullptr));
 }
 
 
@@ -1,62 +1,356 @@
 #pragma once
 
+#include "cli/ArgumentStream.hpp"
+#include "cli/Config.hpp"
+#include "cli/ErrorHandler.hpp"
 #include "cli/GenericArgument.hpp"
+#include "cli/Keywords.hpp"
+#include "cli/ParseContext.hpp"
+#include "cli/ParseResult.hpp"
+#include "cli/details/EditDistance.hpp"
+#include "cli/details/Environment.hpp"
+#include "cli/details/FlagTable.hpp"
 #include "cli/details/Generator.hpp"
+#include "cli/details/PrefixTable.hpp"
+#include "cli/details/ResponseFiles.hpp"
+#include "cli/details/ShortFlagTable.hpp"
+#include "cli/details/SnapshotFile.hpp"
+#include "cli/details/Split.hpp"
+#include "cli/details/Tokenizer.hpp"
+
+#include "keyword.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
+#include <exception>
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 
 namespace cli
 {
 
 
+/// @brief Parses command line arguments into destinations.
+/// @details Once constructed a command line does not allocate while
+/// successfully parsing, provided that:
+///   - the cli::ParseContext was created by MakeContext() or was already used
+///     to run this command line (the overloads without a context use one that
+///     is created with the command line), and
+///   - storing to each destination does not allocate.  Boolean flags,
+///     character arrays, arrays and std::optionals of such destinations,
+///     std::string and std::vector destinations with enough reserved capacity,
+///     std::string_view and const char * destinations, cli::Lazy
+///     destinations given a single value, and user types whose CLIParse()
+///     does not allocate all qualify.
+///
+/// A flag's value can be given in the same argument as "--name=value", which
+/// counts toward the flag's arity exactly like "--name value".  The name is
+/// looked up without copying it and the value is the rest of the argument.
+///
+/// Arguments bound to environment variables with cli::environment that are
+/// not given on the command line are filled from the environment after the
+/// command line is parsed.  The environment is scanned once per run and each
+/// variable is looked up in a table of the bound names built with the
+/// command line, runs of a command line with no bound arguments do not read
+/// it.  A value from the environment that fails to parse is reported with an
+/// index of ParseResult::npos.
+///
+/// A config file set with ParseContext::SetConfigFile() is read after the
+/// environment and fills the flags that are still not given.  Failures in it
+/// are reported with its path, line and column.
+///
+/// Runs of argv with a context given ParseContext::SetSnapshotFile() check
+/// for a snapshot of an earlier run with the same inputs before parsing.  On
+/// a match every argument is set from the snapshot and nothing is tokenized
+/// or converted, otherwise the run is parsed and its values replace the
+/// snapshot.  Runs of a command string, TryRunInPlace() and cli::RunBatch()
+/// never use a snapshot.
+///
+/// Failed runs and runs that stop at a help, usage, or version flag may
+/// allocate to build their messages.  Runs that expand response files
+/// allocate the list of expanded arguments.  Runs of a command string
+/// allocate when it is longer than any string run before with the context.
+///
+/// std::string_view, const char * and cli::Lazy destinations, and containers
+/// of them, refer to the strings they were parsed from instead of copying
+/// them.  How long those strings live depends on where the run read them
+/// from:
+///   - argv passed to Run() or TryRun(): as long as argv.
+///   - a response file, a config file, a command string or a snapshot:
+///     storage in the context, valid until the context is run again or
+///     destroyed.  The overloads without a context use one owned by the
+///     command line.
+///   - an environment variable: the array given to
+///     ParseContext::SetEnvironment(), or the environment of the process,
+///     valid until the variable is changed.
+///   - TryRunInPlace() and cli::RunBatch(): the caller's buffer.
+///   - a cli::ArgumentStream: strings only live until the next one is read,
+///     so such runs fail with ErrorCode::INVALID_CALL.
+/// const char * destinations only accept whole arguments, elements of a list
+/// value are not null terminated.  User defined parsers must not keep the
+/// string they are given.
 class CommandLine
 {
-private:
-	// contains all of the information needed about an argument during command
-	// line argument parsing.
-	struct ArgumentData : GenericArgument
+public:
+	/// @brief Constructor.
+	/// @tparam Keywords Keyword argument types.
+	/// @param description Description of the program used in help messages.
+	/// @param arguments The arguments of the command line.
+	/// @param keywords Keyword arguments.  Supports cli::responseFiles,
+	/// cli::memoryResource and cli::abbreviations.
+	template <typename... Keywords>
+	CommandLine(
+	    const char *description,
+	    std::initializer_list<GenericArgument> arguments,
+	    Keywords... keywords)
+	    : CommandLine(
+	        description, arguments.begin(), arguments.end(), keywords...)
+	{}
+
+	/// @brief Constructor from a range of arguments.
+	/// @details Useful when the arguments are only known at runtime.
+	/// @param keywords Keyword arguments.  Supports cli::responseFiles,
+	/// cli::memoryResource and cli::abbreviations.
+	template <typename Iterator, typename... Keywords>
+	CommandLine(
+	    const char *description,
+	    Iterator begin,
+	    Iterator end,
+	    Keywords... keywords)
+	    : _args(FindMemoryResource(keywords...))
+	    , _description(description)
+	    , _flags(0, FindMemoryResource(keywords...))
+	    , _prefixes(FindMemoryResource(keywords...))
+	    , _environment(0, FindMemoryResource(keywords...))
+	    , _required(FindMemoryResource(keywords...))
+	    , _objectType(nullptr)
+	    , _refersToInput(false)
+	    , _isSerializable(true)
+	    , _layoutHash(0)
+	    , _context(FindMemoryResource(keywords...))
 	{
-		ArgumentData(const GenericArgument &arg)
-		    : GenericArgument(arg)
-		{}
+		keyword::Arguments kwargs{
+		    keyword::Names{responseFiles, memoryResource, abbreviations},
+		    keywords...};
+		_responseFiles = kwargs.GetOrDefault(responseFiles, false);
+		_abbreviations = kwargs.GetOrDefault(abbreviations, false);
 
-		std::size_t count = 0;
-	};
+		// positional arguments come first, in the order they were given
+		_args.assign(begin, end);
+		std::pmr::vector<GenericArgument> flags(GetMemoryResource());
+		std::pmr::vector<GenericArgument>::iterator positionalsEnd =
+		    _args.begin();
+		for(const GenericArgument &arg : _args)
+		{
+			if(arg.GetName() != nullptr
+			   && std::strncmp("--", arg.GetName(), 2) == 0)
+			{
+				flags.push_back(arg);
+			}
+			else
+			{
+				*positionalsEnd++ = arg;
+			}
+		}
+		std::copy(flags.begin(), flags.end(), positionalsEnd);
+		_numPositionals = positionalsEnd - _args.begin();
 
+		// the flag lookup table is immutable once built, all runs share it
+		_flags = details::FlagTable(
+		    _args.size() - _numPositionals, GetMemoryResource());
+		for(std::size_t i = _numPositionals; i < _args.size(); ++i)
+		{
+			_flags.Insert(_args[i].GetName(), i);
+		}
+		for(std::size_t i = 0; i < _args.size(); ++i)
+		{
+			const char shortName = _args[i].GetShortName();
+			if(shortName == '\0')
+			{
+				continue;
+			}
+			if(i < _numPositionals || shortName == '-'
+			   || !details::ShortFlagTable::IsValid(shortName))
+			{
+				details::Throw<std::invalid_argument>(
+				    "Invalid argument to cli::CommandLine::CommandLine().  "
+				    "Short names must be ASCII characters other than '-' "
+				    "and can only be given to flags.");
+			}
+			_shortFlags.Insert(shortName, i);
+		}
 
-public:
-	CommandLine(
-	    const char *description,
-	    std::initializer_list<GenericArgument> arguments)
-	    : _description(description)
+		// the table of environment variable names is empty unless some
+		// argument is bound to one
+		const std::size_t environmentCount = static_cast<std::size_t>(
+		    std::count_if(
+		        _args.begin(), _args.end(), [](const GenericArgument &arg) {
+			        return arg.GetEnvironment() != nullptr;
+		        }));
+		if(environmentCount != 0)
+		{
+			_environment =
+			    details::FlagTable(environmentCount, GetMemoryResource());
+			for(std::size_t i = 0; i < _args.size(); ++i)
+			{
+				if(_args[i].GetEnvironment() != nullptr)
+				{
+					_environment.Insert(_args[i].GetEnvironment(), i);
+				}
+			}
+		}
+		_usesEnvironment = environmentCount != 0;
+		if(_abbreviations)
+		{
+			_prefixes.Reserve(_args.size() - _numPositionals);
+			for(std::size_t i = _numPositionals; i < _args.size(); ++i)
+			{
+				_prefixes.Insert(_args[i].GetName(), i);
+			}
+			_prefixes.Sort();
+		}
+
+		for(std::size_t i = 0; i < _args.size(); ++i)
+		{
+			if(_args[i].GetArity().inclusiveMin != 0)
+			{
+				_required.push_back(i);
+			}
+			_refersToInput = _refersToInput || _args[i].RefersToInput();
+			_isSerializable = _isSerializable && _args[i].CanSerialize();
+
+			// snapshots are only read by command lines whose arguments have
+			// the same names, kinds, arities and value types
+			const Arity arity = _args[i].GetArity();
+			const std::uint64_t layout[] = {
+			    static_cast<std::uint64_t>(_args[i].GetKind()),
+			    arity.inclusiveMin,
+			    arity.inclusiveMax,
+			    static_cast<unsigned char>(_args[i].GetSeparator()),
+			    _isSerializable ? _args[i].GetFingerprint() : 0};
+			_layoutHash = details::HashString(
+			    _args[i].GetName() != nullptr ? _args[i].GetName() : "",
+			    details::HashBytes(layout, sizeof(layout), _layoutHash));
+
+			const void *objectType = _args[i].GetObjectType();
+			if(objectType != nullptr)
+			{
+				if(_objectType != nullptr && _objectType != objectType)
+				{
+					details::Throw<std::invalid_argument>(
+					    "Invalid argument to cli::CommandLine::CommandLine().  "
+					    "All arguments created from data members must be "
+					    "members of the same type.");
+				}
+				_objectType = objectType;
+			}
+		}
+
+		_context._counts.reserve(_args.size());
+		_context._isFromEnvironment.reserve(_args.size());
+	}
+
+	/// @brief Copy constructor.
+	/// @details The copy gets its own context for runs that are not given
+	/// one, nothing mapped or read by runs of other is shared.
+	CommandLine(const CommandLine &other)
+	    : _args(other._args)
+	    , _description(other._description)
+	    , _numPositionals(other._numPositionals)
+	    , _flags(other._flags)
+	    , _prefixes(other._prefixes)
+	    , _shortFlags(other._shortFlags)
+	    , _environment(other._environment)
+	    , _usesEnvironment(other._usesEnvironment)
+	    , _abbreviations(other._abbreviations)
+	    , _required(other._required)
+	    , _objectType(other._objectType)
+	    , _responseFiles(other._responseFiles)
+	    , _refersToInput(other._refersToInput)
+	    , _isSerializable(other._isSerializable)
+	    , _layoutHash(other._layoutHash)
+	    , _context(GetMemoryResource())
+	{
+		_context._counts.reserve(_args.size());
+		_context._isFromEnvironment.reserve(_args.size());
+	}
+
+	CommandLine(CommandLine &&) = default;
+
+	/// @brief Copy assignment.
+	/// @details Keeps this command line's own context, see the copy
+	/// constructor.
+	CommandLine &operator=(const CommandLine &other)
+	{
+		_args = other._args;
+		_description = other._description;
+		_numPositionals = other._numPositionals;
+		_flags = other._flags;
+		_prefixes = other._prefixes;
+		_shortFlags = other._shortFlags;
+		_environment = other._environment;
+		_usesEnvironment = other._usesEnvironment;
+		_abbreviations = other._abbreviations;
+		_required = other._required;
+		_objectType = other._objectType;
+		_responseFiles = other._responseFiles;
+		_refersToInput = other._refersToInput;
+		_isSerializable = other._isSerializable;
+		_layoutHash = other._layoutHash;
+		_context._counts.reserve(_args.size());
+		_context._isFromEnvironment.reserve(_args.size());
+		return *this;
+	}
+
+	CommandLine &operator=(CommandLine &&) = default;
+
+	/// @brief Gets the memory resource this command line allocates from.
+	/// @details Copies of a command line allocate from the default resource,
+	/// like copies of std::pmr containers.
+	std::pmr::memory_resource *GetMemoryResource() const noexcept
+	{
+		return _args.get_allocator().resource();
+	}
+
+	/// @brief Gets if every argument that stores a value stores it into a
+	/// data member of Object.
+	/// @details Runs of such a command line into different objects share no
+	/// state, so they can run concurrently.
+	template <typename Object> bool IsMemberwise() const noexcept
 	{
-		std::copy(
-		    arguments.begin(), arguments.end(), std::back_inserter(_args));
+		return std::all_of(
+		    _args.begin(), _args.end(), [](const GenericArgument &arg) {
+			    const GenericArgument::Kind kind = arg.GetKind();
+			    return (kind != GenericArgument::Kind::NORMAL
+			            && kind != GenericArgument::Kind::BOOL)
+			        || arg.GetObjectType() == details::TypeTag<Object>();
+		    });
+	}
 
-		std::vector<ArgumentData>::const_iterator startFlagsIt =
-		    std::stable_partition(
-		        _args.begin(), _args.end(), [](const ArgumentData &argData) {
-			        if(argData.GetName() == nullptr)
-			        {
-				        return true;
-			        }
-			        return std::strncmp("--", argData.GetName(), 2) != 0;
-		        });
-		_numPositionals = startFlagsIt - _args.begin();
+	/// @brief Creates a context with storage for running this command line.
+	/// @details Running with a context created by this function does not
+	/// allocate, see the class documentation.
+	ParseContext MakeContext() const
+	{
+		ParseContext context(GetMemoryResource());
+		context._counts.reserve(_args.size());
+		context._isFromEnvironment.reserve(_args.size());
+		return context;
 	}
 
 	std::string GetUsage(const char *name) const
 	{
 		std::string usage = name;
-		for(const ArgumentData &arg : _args)
+		for(const GenericArgument &arg : _args)
 		{
 			usage += ' ';
 			usage += arg.GetUsage();
@@ -74,7 +368,7 @@ public:
 		help += "\n\n";
 
 		help += "Arguments: \n";
-		for(const ArgumentData &arg : _args)
+		for(const GenericArgument &arg : _args)
 		{
 			help += "  ";
 			help += arg.GetHelp();
@@ -83,152 +377,1278 @@ public:
 		return help;
 	}
 
-	bool Run(const char *name, int argc, const char *const *argv)
+	/// @brief Parses command line arguments without throwing on failure.
+	/// @details Does not modify this command line, multiple threads may run
+	/// it at once as long as each uses its own context and the arguments
+	/// store to different objects.  Exceptions thrown while parsing a value
+	/// are caught and reported as ErrorCode::INVALID_VALUE.
+	///
+	/// If the command line was created with cli::responseFiles enabled then
+	/// each "@path" argument is replaced by the arguments listed in the file
+	/// at path, see details::ResponseFiles.  Values parsed from a response
+	/// file point into its mapping which lives in the context.
+	/// @param context The state of this run.  Any object bound to it is
+	/// parsed into.
+	/// @param name The name of the program, used in help and usage messages.
+	/// @param argc The number of arguments in argv.
+	/// @param argv The arguments, not including the program name.
+	/// @returns The result of the run.  Indices in it are indices into argv.
+	ParseResult TryRun(
+	    ParseContext &context,
+	    const char *name,
+	    int argc,
+	    const char *const *argv) const
 	{
-		if(argc < 0)
+		return RunArguments(context, name, argc, argv, true);
+	}
+
+	/// @brief Parses command line arguments using the program name in argv
+	/// without throwing on failure.
+	/// @returns The result of the run.  Indices in it are indices into argv,
+	/// where the program name is index zero.
+	ParseResult
+	TryRun(ParseContext &context, int argc, const char *const *argv) const
+	{
+		if(argc < 1)
 		{
-			throw std::invalid_argument(
-			    "Invalid argument to cli::CommandLine::Run(name, argc, argv).  "
-			    "argc must be non-negative");
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::CommandLine::Run(argc, argv).  argc "
+			    "must be at least one.");
 		}
 		if(argv == nullptr)
 		{
-			throw std::invalid_argument(
-			    "Invalid argument to cli::CommandLine::Run(name, argc, argv).  "
-			    "argv must not be null.");
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::CommandLine::Run(argc, argv).  argv "
+			    "can not be NULL.");
 		}
+		ParseResult result = TryRun(context, *argv, argc - 1, argv + 1);
+		if(result._index != ParseResult::npos)
+		{
+			result._index++;
+		}
+		return result;
+	}
 
-		for(ArgumentData &argData : _args)
+	/// @brief Parses arguments read from a stream without throwing on failure.
+	/// @details Memory use does not grow with the number of arguments.  Flags
+	/// and values are read from the stream exactly like argv, response files
+	/// are not expanded.  Strings in a failed result point into the stream's
+	/// buffer and are only valid until the stream is read again.  Fails with
+	/// ErrorCode::INVALID_CALL if a destination would refer to those strings,
+	/// see the class documentation.
+	/// @param context The state of this run.
+	/// @param name The name of the program, used in help and usage messages.
+	/// @param stream The stream to read arguments from.
+	/// @returns The result of the run.  Indices in it are the number of
+	/// arguments read from the stream before the failing argument.
+	ParseResult TryRun(
+	    ParseContext &context,
+	    const char *name,
+	    ArgumentStream &stream) const
+	{
+		if(_objectType != nullptr && context._objectType != _objectType)
+		{
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::CommandLine::Run().  The context "
+			    "must be bound to an object of the type that arguments were "
+			    "created from the data members of.");
+		}
+		if(_refersToInput)
 		{
-			argData.count = 0;
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::CommandLine::Run(stream).  Strings "
+			    "read from a stream do not outlive the run, so arguments "
+			    "with std::string_view, const char * or cli::Lazy "
+			    "destinations can not be run from one.");
 		}
+		details::Generator generator(stream);
+		return Parse(context, name, generator);
+	}
+
+	/// @brief Parses a command string, such as a line read from a socket,
+	/// without throwing on failure.
+	/// @details The string is split into arguments with POSIX shell quoting
+	/// rules, see details::Tokenizer, which are then run like argv.  The
+	/// arguments are copied into storage in the context that later runs
+	/// reuse.
+	/// @param context The state of this run.
+	/// @param name The name of the program, used in help and usage messages.
+	/// @param commandString The string, not including the program name.
+	/// @returns The result of the run.  Indices in it are indices of the
+	/// arguments split from the string.
+	ParseResult TryRun(
+	    ParseContext &context,
+	    const char *name,
+	    std::string_view commandString) const
+	{
+		const details::Tokenizer::Status status = context._tokenizer.Tokenize(
+		    commandString.data(), commandString.size());
+		return RunTokenized(context, name, status);
+	}
+
+	/// @brief Parses a command string in place without throwing on failure.
+	/// @details Like TryRun(context, name, commandString) but the arguments
+	/// are written over the string instead of being copied, values parsed
+	/// from them point into it.
+	/// @param context The state of this run.
+	/// @param name The name of the program, used in help and usage messages.
+	/// @param begin The start of the string.
+	/// @param end The end of the string.  Must be readable and is overwritten
+	/// with a null character unless it already is one.
+	ParseResult TryRunInPlace(
+	    ParseContext &context,
+	    const char *name,
+	    char *begin,
+	    char *end) const
+	{
+		const details::Tokenizer::Status status =
+		    context._tokenizer.TokenizeInPlace(begin, end);
+		return RunTokenized(context, name, status);
+	}
+
+	/// @brief Parses command line arguments without throwing on failure with
+	/// a context owned by this command line.
+	/// @details Not safe to call from multiple threads at once.
+	ParseResult TryRun(const char *name, int argc, const char *const *argv)
+	{
+		return TryRun(_context, name, argc, argv);
+	}
+
+	/// @brief Parses command line arguments using the program name in argv
+	/// without throwing on failure with a context owned by this command line.
+	/// @details Not safe to call from multiple threads at once.
+	ParseResult TryRun(int argc, const char *const *argv)
+	{
+		return TryRun(_context, argc, argv);
+	}
+
+	/// @brief Parses arguments read from a stream without throwing on failure
+	/// with a context owned by this command line.
+	/// @details Not safe to call from multiple threads at once.
+	ParseResult TryRun(const char *name, ArgumentStream &stream)
+	{
+		return TryRun(_context, name, stream);
+	}
+
+	/// @brief Parses a command string without throwing on failure with a
+	/// context owned by this command line.
+	/// @details Not safe to call from multiple threads at once.
+	ParseResult TryRun(const char *name, std::string_view commandString)
+	{
+		return TryRun(_context, name, commandString);
+	}
+
+	/// @brief Parses command line arguments.
+	/// @details Equivalent to TryRun() but failures are thrown.  Exceptions
+	/// thrown while parsing a value are rethrown, all other failures throw
+	/// std::invalid_argument.  When exceptions are disabled failures are
+	/// passed to the handler installed by cli::SetErrorHandler().
+	/// @returns True if an informational flag such as help was given and the
+	/// program should exit.
+	bool Run(
+	    ParseContext &context,
+	    const char *name,
+	    int argc,
+	    const char *const *argv) const
+	{
+		return ThrowOnFailure(TryRun(context, name, argc, argv));
+	}
+
+	/// @brief Parses command line arguments using the program name in argv.
+	bool Run(ParseContext &context, int argc, const char *const *argv) const
+	{
+		return ThrowOnFailure(TryRun(context, argc, argv));
+	}
+
+	/// @brief Parses arguments read from a stream.
+	bool Run(
+	    ParseContext &context,
+	    const char *name,
+	    ArgumentStream &stream) const
+	{
+		return ThrowOnFailure(TryRun(context, name, stream));
+	}
+
+	/// @brief Parses a command string.
+	bool Run(
+	    ParseContext &context,
+	    const char *name,
+	    std::string_view commandString) const
+	{
+		return ThrowOnFailure(TryRun(context, name, commandString));
+	}
 
-		const auto flagLookup = [&]() {
-			std::unordered_map<
-			    std::string_view,
-			    std::vector<ArgumentData>::iterator>
-			    lookup;
-			for(std::vector<ArgumentData>::iterator it =
-			        _args.begin() + _numPositionals;
-			    it != _args.end();
-			    ++it)
+	/// @brief Parses command line arguments with a context owned by this
+	/// command line.
+	/// @details Not safe to call from multiple threads at once.
+	bool Run(const char *name, int argc, const char *const *argv)
+	{
+		return Run(_context, name, argc, argv);
+	}
+
+	/// @brief Parses command line arguments using the program name in argv
+	/// with a context owned by this command line.
+	/// @details Not safe to call from multiple threads at once.
+	bool Run(int argc, const char *const *argv)
+	{
+		return Run(_context, argc, argv);
+	}
+
+	/// @brief Parses arguments read from a stream with a context owned by this
+	/// command line.
+	/// @details Not safe to call from multiple threads at once.
+	bool Run(const char *name, ArgumentStream &stream)
+	{
+		return Run(_context, name, stream);
+	}
+
+	/// @brief Parses a command string with a context owned by this command
+	/// line.
+	/// @details Not safe to call from multiple threads at once.
+	bool Run(const char *name, std::string_view commandString)
+	{
+		return Run(_context, name, commandString);
+	}
+
+private:
+	friend class Subcommands;
+
+	// the largest edit distance of a suggested flag from an unknown one
+	static constexpr std::size_t maxSuggestionDistance = 2;
+
+	// the longest flag name, including its dashes, a config file can give
+	static constexpr std::size_t maxConfigKeyLength = 256;
+
+	template <typename... Keywords>
+	static std::pmr::memory_resource *FindMemoryResource(Keywords... keywords)
+	{
+		keyword::Arguments kwargs{
+		    keyword::Names{responseFiles, memoryResource, abbreviations},
+		    keywords...};
+		return kwargs.GetOrDefault(
+		    memoryResource, std::pmr::get_default_resource());
+	}
+
+	// parses the arguments of a generator, after any response files were
+	// expanded
+	ParseResult Parse(
+	    ParseContext &context,
+	    const char *name,
+	    details::Generator &generator) const
+	{
+		void *const object = context._object;
+		std::pmr::vector<std::size_t> &counts = context._counts;
+		counts.assign(_args.size(), 0);
+		if(_objectType != nullptr)
+		{
+			for(const GenericArgument &arg : _args)
 			{
-				lookup.emplace(it->GetName(), it);
+				arg.Initialize(object);
 			}
-			return lookup;
-		}();
-		auto positionalIt = _args.begin();
-		const auto positionalEnd = _args.begin() + _numPositionals;
+		}
 
-		details::Generator generator(argv, argv + argc);
+		std::size_t positional = 0;
 
-		while(generator.Remaining() != 0)
+		while(!generator.IsEmpty())
 		{
+			const std::size_t argIndex = generator.GetIndex();
 			const char *const arg = generator.Peek();
 			if(arg == nullptr)
 			{
-				throw std::invalid_argument(
+				return ParseResult::InvalidCall(
 				    "Invalid argument to cli::CommandLine::Run(name, argc, "
 				    "argv).  Null pointer as string in argv.");
 			}
 
-			if(arg[0] == '-')
+			std::size_t argumentIndex;
+			// a value given in the same argument as its flag, such as the
+			// "10" of "-n10"
+			const char *attached = nullptr;
+			const bool isPositional = arg[0] != '-';
+			if(!isPositional)
 			{
 				// this argument is a flag
-				auto flagEntry = flagLookup.find(arg);
-				if(flagEntry == flagLookup.end())
-				{
-					throw std::invalid_argument(
-					    "Invalid command line arguments.  Unknown flag: "
-					    + std::string(arg));
-				}
-				if(flagEntry->second->count
-				   == flagEntry->second->GetArity().inclusiveMax)
-				{
-					throw std::invalid_argument(
-					    "Invalid command line arguments.  " + std::string(arg)
-					    + " given more than the maximum of "
-					    + std::to_string(
-					          flagEntry->second->GetArity().inclusiveMax)
-					    + " time(s).");
-				}
-				// handle special flags that trigger parser exit
-				switch(flagEntry->second->GetKind())
-				{
-					case GenericArgument::Kind::HELP:
-						std::cout << GetHelp(name);
-						return true;
-					case GenericArgument::Kind::USAGE:
-						std::cout << GetUsage(name);
-						return true;
-					case GenericArgument::Kind::VERSION:
-						std::cout << flagEntry->second->GetVersion() << '\n';
-						return true;
-					default:
-						break;
+				if(arg[1] != '-' && arg[1] != '\0')
+				{
+					ParseResult result = ParseCluster(
+					    context, name, arg, argIndex, argumentIndex, attached);
+					if(!result || result.IsExit())
+					{
+						return result;
+					}
+				}
+				else
+				{
+					// "--name=value" is looked up by the name before the '='
+					const std::string_view flag(arg, std::strcspn(arg, "="));
+					argumentIndex = _flags.Find(flag);
+					if(argumentIndex == details::FlagTable::npos)
+					{
+						ParseResult result =
+						    FindAbbreviated(flag, arg, argumentIndex);
+						if(!result)
+						{
+							result._index = argIndex;
+							return result;
+						}
+					}
+					if(arg[flag.size()] == '=')
+					{
+						attached = arg + flag.size() + 1;
+						const GenericArgument &named = _args[argumentIndex];
+						if(named.GetKind() != GenericArgument::Kind::NORMAL)
+						{
+							return ParseResult::Failure(
+							    ErrorCode::UNEXPECTED_VALUE,
+							    argIndex,
+							    named.GetName(),
+							    arg);
+						}
+					}
+				}
+				ParseResult result =
+				    StartFlag(context, name, arg, argIndex, argumentIndex);
+				if(!result || result.IsExit())
+				{
+					return result;
 				}
 				// progress passed the flag
 				generator.Next();
-				// and handle any value
-				flagEntry->second->Handle(generator);
-				flagEntry->second->count++;
 			}
 			else
 			{
 				// this argument is a positional
-				if(positionalIt == positionalEnd)
+				if(positional == _numPositionals)
+				{
+					return ParseResult::Failure(
+					    ErrorCode::UNHANDLED_ARGUMENT, argIndex, arg, arg);
+				}
+				argumentIndex = positional;
+			}
+
+			// handle any value
+			const GenericArgument &argument = _args[argumentIndex];
+			const bool takesValue =
+			    argument.GetKind() == GenericArgument::Kind::NORMAL;
+			if(takesValue && attached == nullptr && generator.IsEmpty())
+			{
+				if(generator.GetError() != nullptr)
+				{
+					return StreamFailure(generator);
+				}
+				// a streamed flag is no longer valid, do not refer to it
+				return ParseResult::Failure(
+				    ErrorCode::MISSING_VALUE,
+				    argIndex,
+				    argument.GetName(),
+				    nullptr);
+			}
+			const std::size_t valueIndex =
+			    attached != nullptr ? argIndex : generator.GetIndex();
+			if(argument.GetSeparator() != '\0')
+			{
+				// each element of a list counts toward the arity, check them
+				// all before any are stored
+				const char *const value =
+				    attached != nullptr ? attached : generator.Peek();
+				const char *const end = value + std::strlen(value);
+				const std::size_t elements = details::CountElements(
+				    value, end, argument.GetSeparator());
+				const std::size_t limit = argument.GetArity().inclusiveMax;
+				if(elements > limit - counts[argumentIndex])
+				{
+					ParseResult result = ParseResult::Failure(
+					    ErrorCode::TOO_MANY_VALUES,
+					    valueIndex,
+					    argument.GetName(),
+					    argument.GetName());
+					result._limit = limit;
+					return result;
+				}
+#ifdef CLI_NO_EXCEPTIONS
+				if(!argument.HandleList(
+				       value, end, counts[argumentIndex], object))
+				{
+					return InvalidValue(valueIndex, argument, value);
+				}
+#else
+				try
+				{
+					argument.HandleList(
+					    value, end, counts[argumentIndex], object);
+				}
+				catch(...)
+				{
+					return InvalidValue(valueIndex, argument, value);
+				}
+#endif
+				if(attached == nullptr)
+				{
+					generator.Next();
+				}
+				counts[argumentIndex] += elements;
+				if(isPositional && counts[positional] == limit)
+				{
+					++positional;
+				}
+				continue;
+			}
+			std::size_t runLength = 0;
+			const char *const *run = nullptr;
+			if(isPositional && argument.CanHandleRuns())
+			{
+				run = generator.PeekRun(
+				    argument.GetArity().inclusiveMax - counts[argumentIndex],
+				    runLength);
+			}
+			if(runLength > 1)
+			{
+				// parse consecutive values of a vector with one typed call
+				std::size_t handled = 0;
+#ifdef CLI_NO_EXCEPTIONS
+				if(!argument.HandleRun(
+				       run, runLength, object, handled, context._pool))
+				{
+					return InvalidValue(
+					    valueIndex + handled, argument, run[handled]);
+				}
+#else
+				try
 				{
-					throw std::invalid_argument(
-					    "Invalid command line arguments.  Unhandled "
-					    "argument: "
-					    + std::string(arg));
+					argument.HandleRun(
+					    run, runLength, object, handled, context._pool);
 				}
-				positionalIt->Handle(generator);
-				positionalIt->count++;
-				if(positionalIt->count == positionalIt->GetArity().inclusiveMax)
+				catch(...)
 				{
-					++positionalIt;
+					return InvalidValue(
+					    valueIndex + handled, argument, run[handled]);
 				}
+#endif
+				generator.Skip(runLength);
+				counts[argumentIndex] += runLength;
+			}
+			else if(attached != nullptr)
+			{
+#ifdef CLI_NO_EXCEPTIONS
+				if(!argument.Handle(attached, counts[argumentIndex], object))
+				{
+					return InvalidValue(valueIndex, argument, attached);
+				}
+#else
+				try
+				{
+					argument.Handle(attached, counts[argumentIndex], object);
+				}
+				catch(...)
+				{
+					return InvalidValue(valueIndex, argument, attached);
+				}
+#endif
+				counts[argumentIndex]++;
+			}
+			else
+			{
+				const char *const value = takesValue ? generator.Peek() : arg;
+#ifdef CLI_NO_EXCEPTIONS
+				if(!argument.Handle(generator, counts[argumentIndex], object))
+				{
+					return InvalidValue(valueIndex, argument, value);
+				}
+#else
+				try
+				{
+					argument.Handle(generator, counts[argumentIndex], object);
+				}
+				catch(...)
+				{
+					return InvalidValue(valueIndex, argument, value);
+				}
+#endif
+				counts[argumentIndex]++;
+			}
+
+			if(isPositional
+			   && counts[positional] == argument.GetArity().inclusiveMax)
+			{
+				++positional;
+			}
+		}
+
+		if(generator.GetError() != nullptr)
+		{
+			return StreamFailure(generator);
+		}
+
+		if(_usesEnvironment)
+		{
+			ParseResult result = ParseEnvironment(context);
+			if(!result)
+			{
+				return result;
+			}
+		}
+
+		if(context._configPath != nullptr)
+		{
+			ParseResult result = ParseConfigFile(context);
+			if(!result)
+			{
+				return result;
 			}
 		}
 
-		for(const ArgumentData &arg : _args)
+		for(const std::size_t index : _required)
 		{
-			if(arg.count < arg.GetArity().inclusiveMin)
+			const GenericArgument &arg = _args[index];
+			if(counts[index] < arg.GetArity().inclusiveMin)
 			{
-				throw std::invalid_argument(
-				    "Invalid command line arguments.  "
-				    + std::string(arg.GetName()) + " given "
-				    + std::to_string(arg.count)
-				    + " value(s), less than the minimum of "
-				    + std::to_string(arg.GetArity().inclusiveMin)
-				    + " value(s).");
+				ParseResult result = ParseResult::Failure(
+				    ErrorCode::TOO_FEW_VALUES,
+				    ParseResult::npos,
+				    arg.GetName(),
+				    nullptr);
+				result._count = counts[index];
+				result._limit = arg.GetArity().inclusiveMin;
+				return result;
 			}
 		}
-		return false;
+		return ParseResult::Success(false);
 	}
 
-	bool Run(int argc, const char *const *argv)
+	// fills the arguments that were not given from the environment variables
+	// bound to them, reading each variable of the environment once
+	ParseResult ParseEnvironment(ParseContext &context) const
 	{
-		if(argc < 1)
+		std::pmr::vector<std::size_t> &counts = context._counts;
+		std::pmr::vector<bool> &isFromEnvironment = context._isFromEnvironment;
+		isFromEnvironment.assign(_args.size(), false);
+		const char *const *variable = GetEnvironment(context);
+		for(; *variable != nullptr; ++variable)
 		{
-			throw std::invalid_argument(
-			    "Invalid argument to cli::CommandLine::Run(argc, argv).  argc "
-			    "must be at least one.");
+			const char *const entry = *variable;
+			const std::size_t length = std::strcspn(entry, "=");
+			const std::size_t index =
+			    _environment.Find(std::string_view(entry, length));
+			if(index == details::FlagTable::npos || counts[index] != 0
+			   || isFromEnvironment[index] || entry[length] != '=')
+			{
+				continue;
+			}
+			const GenericArgument &argument = _args[index];
+			const char *const value = entry + length + 1;
+			const char *const end = value + std::strlen(value);
+			const char separator = argument.GetSeparator();
+			const std::size_t count = separator == '\0'
+			    ? 1
+			    : details::CountElements(value, end, separator);
+			if(count > argument.GetArity().inclusiveMax)
+			{
+				ParseResult result = ParseResult::Failure(
+				    ErrorCode::TOO_MANY_VALUES,
+				    ParseResult::npos,
+				    argument.GetName(),
+				    argument.GetEnvironment());
+				result._limit = argument.GetArity().inclusiveMax;
+				return result;
+			}
+#ifdef CLI_NO_EXCEPTIONS
+			if(!StoreEnvironment(
+			       argument, value, end, counts[index], context._object))
+			{
+				return InvalidValue(ParseResult::npos, argument, value);
+			}
+#else
+			try
+			{
+				StoreEnvironment(
+				    argument, value, end, counts[index], context._object);
+			}
+			catch(...)
+			{
+				return InvalidValue(ParseResult::npos, argument, value);
+			}
+#endif
+			// false switches and empty lists give no values, but still
+			// keep the config file from giving the argument
+			isFromEnvironment[index] = true;
+		}
+		return ParseResult::Success(false);
+	}
+
+	// gets the environment that a run with a context reads
+	static const char *const *GetEnvironment(const ParseContext &context)
+	{
+		return context._environment != nullptr ? context._environment
+		                                       : details::GetEnvironment();
+	}
+
+	// hashes the inputs of a run besides files, its arguments, the values of
+	// the bound environment variables, and the path of its config file
+	std::uint64_t HashInput(
+	    const ParseContext &context,
+	    const char *const *argv,
+	    std::size_t argc) const
+	{
+		std::uint64_t hash = details::HashBytes(&argc, sizeof(argc), 0);
+		for(std::size_t i = 0; i < argc; ++i)
+		{
+			// a null argument fails the run, so no snapshot is written
+			hash = details::HashString(argv[i] != nullptr ? argv[i] : "", hash);
+		}
+		if(context._configPath != nullptr)
+		{
+			hash = details::HashString(context._configPath, hash + 1);
+		}
+		if(_usesEnvironment)
+		{
+			// summed so the order of the variables does not matter
+			std::uint64_t environment = 0;
+			for(const char *const *variable = GetEnvironment(context);
+			    *variable != nullptr;
+			    ++variable)
+			{
+				const char *const entry = *variable;
+				const std::size_t length = std::strcspn(entry, "=");
+				const std::size_t index =
+				    _environment.Find(std::string_view(entry, length));
+				if(index != details::FlagTable::npos && entry[length] == '=')
+				{
+					environment +=
+					    details::HashString(entry + length + 1, index + 1);
+				}
+			}
+			hash = details::HashBytes(&environment, sizeof(environment), hash);
+		}
+		return hash;
+	}
+
+	// sets every argument to its value in the snapshot of a context if the
+	// snapshot matches the run, returning false if the run must be parsed
+	bool LoadSnapshot(ParseContext &context, std::uint64_t input) const
+	{
+		details::SnapshotFile &snapshot = context._snapshot;
+		if(!snapshot.Open(context._snapshotPath, _layoutHash, input))
+		{
+			return false;
+		}
+		// every value is checked before any is stored, so a snapshot that
+		// fails partway leaves the destinations untouched
+		SnapshotReader &reader = snapshot.GetReader();
+		SnapshotReader check = reader;
+		for(const GenericArgument &arg : _args)
+		{
+			if(!arg.CheckValue(check))
+			{
+				return false;
+			}
+		}
+		if(check.GetRemaining() != 0)
+		{
+			return false;
+		}
+		// reading values that were already checked can not fail
+		for(const GenericArgument &arg : _args)
+		{
+			arg.LoadValue(reader, context._object);
+		}
+		return true;
+	}
+
+	// replaces the snapshot of a context with the values of a successful run
+	void SaveSnapshot(
+	    ParseContext &context,
+	    std::uint64_t input,
+	    bool isExpanding) const
+	{
+		const details::ResponseFiles &responseFiles = context._responseFiles;
+		const std::size_t responseFileCount =
+		    isExpanding ? responseFiles.GetFileCount() : 0;
+		const bool hasConfigFile = context._configPath != nullptr;
+		details::SnapshotFile &snapshot = context._snapshot;
+		snapshot.Start(
+		    _layoutHash, input, responseFileCount + (hasConfigFile ? 1 : 0));
+
+		// runs whose files can not be stamped are not cached
+		details::FileStamp stamp;
+		for(std::size_t i = 0; i < responseFileCount; ++i)
+		{
+			if(!responseFiles.GetFile(i).GetStamp(stamp))
+			{
+				return;
+			}
+			snapshot.AddFile(responseFiles.GetPath(i), stamp);
+		}
+		if(hasConfigFile)
+		{
+			if(!context._configFile.GetStamp(stamp))
+			{
+				return;
+			}
+			snapshot.AddFile(context._configPath, stamp);
+		}
+
+		for(const GenericArgument &arg : _args)
+		{
+			arg.SaveValue(snapshot.GetWriter(), context._object);
+		}
+		snapshot.Save(context._snapshotPath);
+	}
+
+	// fills the flags that were not given on the command line or by the
+	// environment from the config file of a context
+	ParseResult ParseConfigFile(ParseContext &context) const
+	{
+		details::ConfigFile &file = context._configFile;
+		const char *const path = context._configPath;
+		if(!file.Open(path))
+		{
+			ParseResult result = ParseResult::Failure(
+			    ErrorCode::INVALID_CONFIG_FILE, ParseResult::npos, path, path);
+			result._detail = "Could not read: ";
+			return result;
+		}
+		context._isSet.assign(
+		    context._counts.begin(), context._counts.end());
+
+		ParseResult result = ParseResult::Success(false);
+		const bool isRead =
+		    file.Read([&](const details::ConfigFile::Entry &entry) {
+			    ParseResult entryResult = StoreConfigEntry(context, entry);
+			    if(entryResult.IsSuccess())
+			    {
+				    return true;
+			    }
+			    result = std::move(entryResult);
+			    result._line = entry.line;
+			    result._column = entry.column;
+			    return false;
+		    });
+		if(isRead)
+		{
+			return ParseResult::Success(false);
+		}
+		if(result.IsSuccess())
+		{
+			const details::ConfigFile::Error &error = file.GetError();
+			result = ParseResult::Failure(
+			    ErrorCode::INVALID_CONFIG_FILE,
+			    ParseResult::npos,
+			    nullptr,
+			    nullptr);
+			result._detail = error.detail;
+			result._line = error.line;
+			result._column = error.column;
+		}
+		result._file = path;
+		return result;
+	}
+
+	// stores an entry of a config file into the flag named by its key
+	ParseResult StoreConfigEntry(
+	    ParseContext &context,
+	    const details::ConfigFile::Entry &entry) const
+	{
+		// the flag name is built on the stack, "--section.key"
+		char name[maxConfigKeyLength];
+		const std::size_t keyLength = std::strlen(entry.key);
+		const std::size_t sectionLength =
+		    entry.section.empty() ? 0 : entry.section.size() + 1;
+		std::size_t index = details::FlagTable::npos;
+		if(2 + sectionLength + keyLength <= maxConfigKeyLength)
+		{
+			name[0] = '-';
+			name[1] = '-';
+			if(sectionLength != 0)
+			{
+				std::memcpy(name + 2, entry.section.data(), sectionLength - 1);
+				name[sectionLength + 1] = '.';
+			}
+			std::memcpy(name + 2 + sectionLength, entry.key, keyLength);
+			index = _flags.Find(
+			    std::string_view(name, 2 + sectionLength + keyLength));
+		}
+		const GenericArgument::Kind kind = index != details::FlagTable::npos
+		    ? _args[index].GetKind()
+		    : GenericArgument::Kind::HELP;
+		if(kind != GenericArgument::Kind::NORMAL
+		   && kind != GenericArgument::Kind::BOOL)
+		{
+			ParseResult result = ParseResult::Failure(
+			    ErrorCode::INVALID_CONFIG_FILE,
+			    ParseResult::npos,
+			    entry.key,
+			    entry.key);
+			result._detail = "Unknown key: ";
+			return result;
+		}
+		if(context._isSet[index]
+		   || (_usesEnvironment && context._isFromEnvironment[index]))
+		{
+			return ParseResult::Success(false);
+		}
+
+		const GenericArgument &argument = _args[index];
+		std::size_t &count = context._counts[index];
+		const char *const begin = entry.value.data();
+		const char *const end = begin + entry.value.size();
+		const char separator = argument.GetSeparator();
+		const std::size_t values = separator == '\0'
+		    ? 1
+		    : details::CountElements(begin, end, separator);
+		const std::size_t limit = argument.GetArity().inclusiveMax;
+		if(values > limit - count)
+		{
+			ParseResult result = ParseResult::Failure(
+			    ErrorCode::TOO_MANY_VALUES,
+			    ParseResult::npos,
+			    argument.GetName(),
+			    argument.GetName());
+			result._limit = limit;
+			return result;
+		}
+		// array elements are not null terminated, report the key instead
+		const char *const token = entry.isTerminated ? begin : entry.key;
+#ifdef CLI_NO_EXCEPTIONS
+		if(!StoreConfigValue(argument, entry, count, context._object))
+		{
+			return InvalidValue(ParseResult::npos, argument, token);
+		}
+#else
+		try
+		{
+			StoreConfigValue(argument, entry, count, context._object);
+		}
+		catch(...)
+		{
+			return InvalidValue(ParseResult::npos, argument, token);
+		}
+#endif
+		return ParseResult::Success(false);
+	}
+
+	// stores a value of a config file into a flag, adding the number of
+	// values it gave to count
+	static bool StoreConfigValue(
+	    const GenericArgument &argument,
+	    const details::ConfigFile::Entry &entry,
+	    std::size_t &count,
+	    void *object)
+	{
+		const char *const begin = entry.value.data();
+		const char *const end = begin + entry.value.size();
+		if(argument.GetKind() == GenericArgument::Kind::BOOL)
+		{
+			bool isGiven = false;
+			if(!ParseSwitch(isGiven, entry.value))
+			{
+				return false;
+			}
+			if(!isGiven)
+			{
+				return true;
+			}
+			return argument.Handle(nullptr, count++, object);
+		}
+		if(argument.GetSeparator() != '\0')
+		{
+			const std::size_t first = count;
+			count +=
+			    details::CountElements(begin, end, argument.GetSeparator());
+			return argument.HandleList(begin, end, first, object);
+		}
+		if(entry.isTerminated)
+		{
+			return argument.Handle(begin, count++, object);
+		}
+		return argument.HandleElement(entry.value, count++, object);
+	}
+
+	// stores the value of an environment variable into the argument bound to
+	// it, setting count to the number of values given
+	static bool StoreEnvironment(
+	    const GenericArgument &argument,
+	    const char *value,
+	    const char *end,
+	    std::size_t &count,
+	    void *object)
+	{
+		if(argument.GetKind() == GenericArgument::Kind::BOOL)
+		{
+			bool isGiven = false;
+			if(!ParseSwitch(isGiven, std::string_view(value, end - value)))
+			{
+				return false;
+			}
+			count = isGiven ? 1 : 0;
+			return !isGiven || argument.Handle(nullptr, 0, object);
+		}
+		if(argument.GetSeparator() != '\0')
+		{
+			count = details::CountElements(value, end, argument.GetSeparator());
+			return argument.HandleList(value, end, 0, object);
+		}
+		count = 1;
+		return argument.Handle(value, 0, object);
+	}
+
+	// reads whether an environment variable gives a boolean flag
+	static bool ParseSwitch(bool &isGiven, std::string_view value)
+	{
+		for(const char *on : {"1", "true", "yes", "on"})
+		{
+			if(value == on)
+			{
+				isGiven = true;
+				return true;
+			}
+		}
+		for(const char *off : {"", "0", "false", "no", "off"})
+		{
+			if(value == off)
+			{
+				isGiven = false;
+				return true;
+			}
+		}
+		return details::ParseFailure(
+		    "Invalid value for a boolean flag, expected one of 1, true, yes, "
+		    "on, 0, false, no, off or nothing.");
+	}
+
+	// checks that a flag can be given again and handles the flags that stop
+	// the run
+	ParseResult StartFlag(
+	    ParseContext &context,
+	    const char *name,
+	    const char *arg,
+	    std::size_t argIndex,
+	    std::size_t index) const
+	{
+		const GenericArgument &flag = _args[index];
+		if(context._counts[index] == flag.GetArity().inclusiveMax)
+		{
+			ParseResult result = ParseResult::Failure(
+			    ErrorCode::TOO_MANY_VALUES, argIndex, flag.GetName(), arg);
+			result._limit = flag.GetArity().inclusiveMax;
+			return result;
+		}
+		// handle special flags that trigger parser exit
+		switch(flag.GetKind())
+		{
+			case GenericArgument::Kind::HELP:
+				if(context._printsMessages)
+				{
+					std::cout << GetHelp(name);
+				}
+				return ParseResult::Success(true);
+			case GenericArgument::Kind::USAGE:
+				if(context._printsMessages)
+				{
+					std::cout << GetUsage(name);
+				}
+				return ParseResult::Success(true);
+			case GenericArgument::Kind::VERSION:
+				if(context._printsMessages)
+				{
+					std::cout << flag.GetVersion() << '\n';
+				}
+				return ParseResult::Success(true);
+			default:
+				return ParseResult::Success(false);
+		}
+	}
+
+	// handles each flag of a cluster of short flags, such as "-xvf", except
+	// the last which is left to the caller along with any value attached to
+	// it, such as the "10" of "-vn10"
+	ParseResult ParseCluster(
+	    ParseContext &context,
+	    const char *name,
+	    const char *arg,
+	    std::size_t argIndex,
+	    std::size_t &index,
+	    const char *&attached) const
+	{
+		for(const char *c = arg + 1;; ++c)
+		{
+			index = _shortFlags.Find(*c);
+			if(index == details::ShortFlagTable::npos)
+			{
+				return ParseResult::Failure(
+				    ErrorCode::UNKNOWN_FLAG, argIndex, arg, arg);
+			}
+			const GenericArgument &flag = _args[index];
+			if(flag.GetKind() == GenericArgument::Kind::NORMAL)
+			{
+				// the rest of the argument is the value
+				attached = c[1] != '\0' ? c + 1 : nullptr;
+				return ParseResult::Success(false);
+			}
+			if(c[1] == '\0')
+			{
+				return ParseResult::Success(false);
+			}
+			ParseResult result = StartFlag(context, name, arg, argIndex, index);
+			if(!result || result.IsExit())
+			{
+				return result;
+			}
+			// only boolean flags are left, storing them can not fail
+			flag.Handle(nullptr, context._counts[index]++, context._object);
+		}
+	}
+
+	// finds the flag an unknown flag abbreviates, or fails with a suggestion
+	// of the closest flag.  The flag is the name part of the argument arg.
+	ParseResult FindAbbreviated(
+	    std::string_view flag,
+	    const char *arg,
+	    std::size_t &index) const
+	{
+		// "--" alone is not an abbreviation
+		if(_abbreviations && flag.size() > 2 && flag[1] == '-')
+		{
+			const details::PrefixTable::Match match = _prefixes.Find(flag);
+			if(match.first != nullptr)
+			{
+				ParseResult result = ParseResult::Failure(
+				    ErrorCode::AMBIGUOUS_FLAG, ParseResult::npos, arg, arg);
+				result._suggestion = match.first;
+				result._alternative = match.second;
+				return result;
+			}
+			if(match.index != details::PrefixTable::npos)
+			{
+				index = match.index;
+				return ParseResult::Success(false);
+			}
+		}
+		ParseResult result = ParseResult::Failure(
+		    ErrorCode::UNKNOWN_FLAG, ParseResult::npos, arg, arg);
+		result._suggestion = FindClosestFlag(flag);
+		return result;
+	}
+
+	// finds the flag with the smallest edit distance to a string, if any is
+	// close enough to be a typo of it
+	const char *FindClosestFlag(std::string_view arg) const
+	{
+		const char *closest = nullptr;
+		std::size_t bound = maxSuggestionDistance;
+		for(std::size_t i = _numPositionals; i < _args.size() && bound != 0;
+		    ++i)
+		{
+			const char *const name = _args[i].GetName();
+			const std::size_t distance =
+			    details::EditDistance(arg, name, bound);
+			if(distance <= bound)
+			{
+				closest = name;
+				// only a strictly closer flag replaces this one
+				bound = distance - 1;
+			}
+		}
+		return closest;
+	}
+
+	// runs arguments, with a snapshot if usesSnapshot and the context has
+	// one, see TryRun()
+	ParseResult RunArguments(
+	    ParseContext &context,
+	    const char *name,
+	    int argc,
+	    const char *const *argv,
+	    bool usesSnapshot) const
+	{
+		if(argc < 0)
+		{
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::CommandLine::Run(name, argc, argv).  "
+			    "argc must be non-negative");
 		}
 		if(argv == nullptr)
 		{
-			throw std::invalid_argument(
-			    "Invalid argument to cli::CommandLine::Run(argc, argv).  argv "
-			    "can not be NULL.");
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::CommandLine::Run(name, argc, argv).  "
+			    "argv must not be null.");
 		}
-		return Run(*argv, argc - 1, argv + 1);
+		if(_objectType != nullptr && context._objectType != _objectType)
+		{
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::CommandLine::Run().  The context "
+			    "must be bound to an object of the type that arguments were "
+			    "created from the data members of.");
+		}
+
+		const char *const *arguments = argv;
+		std::size_t count = static_cast<std::size_t>(argc);
+		// a snapshot of an earlier run with the same inputs replaces parsing
+		const bool isCached = usesSnapshot && context._snapshotPath != nullptr;
+		std::uint64_t input = 0;
+		if(isCached)
+		{
+			if(!_isSerializable)
+			{
+				return ParseResult::InvalidCall(
+				    "Invalid argument to cli::CommandLine::Run().  Snapshots "
+				    "can only be used when the value of every argument is "
+				    "serializable, see cli::Serialize().");
+			}
+			input = HashInput(context, argv, count);
+			if(LoadSnapshot(context, input))
+			{
+				return ParseResult::Success(false);
+			}
+		}
+
+		const bool isExpanding = _responseFiles
+		    && details::ResponseFiles::IsNeeded(argv, count);
+		if(isExpanding)
+		{
+			details::ResponseFiles &files = context._responseFiles;
+			const details::ResponseFiles::Status status =
+			    files.Expand(argv, count);
+			if(status != details::ResponseFiles::Status::OK)
+			{
+				ParseResult result = ParseResult::Failure(
+				    ErrorCode::INVALID_RESPONSE_FILE,
+				    files.GetOrigin(files.GetCount()),
+				    files.GetFailedArgument(),
+				    files.GetFailedArgument());
+				result._detail = GetResponseFileError(status);
+				return result;
+			}
+			arguments = files.GetArguments();
+			count = files.GetCount();
+		}
+
+		details::Generator generator(arguments, arguments + count);
+		ParseResult result = Parse(context, name, generator);
+		if(isExpanding && result._index != ParseResult::npos)
+		{
+			result._index = context._responseFiles.GetOrigin(result._index);
+		}
+		if(isCached && result && !result.IsExit())
+		{
+			SaveSnapshot(context, input, isExpanding);
+		}
+		return result;
 	}
 
-private:
-	std::vector<ArgumentData> _args;
+	// runs the arguments split from a command string
+	ParseResult RunTokenized(
+	    ParseContext &context,
+	    const char *name,
+	    details::Tokenizer::Status status) const
+	{
+		const details::Tokenizer &tokenizer = context._tokenizer;
+		if(status != details::Tokenizer::Status::OK)
+		{
+			ParseResult result = ParseResult::Failure(
+			    ErrorCode::INVALID_COMMAND_STRING,
+			    tokenizer.GetCount(),
+			    nullptr,
+			    nullptr);
+			result._detail =
+			    status == details::Tokenizer::Status::UNTERMINATED_QUOTE
+			    ? "Unterminated quote in command string."
+			    : "Command string ends with an escape character.";
+			return result;
+		}
+		// snapshots only cache runs of argv, views parsed from a command
+		// string must point into the string
+		return RunArguments(
+		    context,
+		    name,
+		    static_cast<int>(tokenizer.GetCount()),
+		    tokenizer.GetArguments(),
+		    false);
+	}
+
+	// the result of a value that failed to parse, with exceptions this must
+	// be called by the handler that caught the exception of the parser
+	static ParseResult InvalidValue(
+	    std::size_t index,
+	    const GenericArgument &argument,
+	    const char *value)
+	{
+		ParseResult result = ParseResult::Failure(
+		    ErrorCode::INVALID_VALUE, index, argument.GetName(), value);
+#ifdef CLI_NO_EXCEPTIONS
+		result._detail = details::GetParseError();
+#else
+		result._cause = std::current_exception();
+#endif
+		return result;
+	}
+
+	// the detail of a failed expansion, followed by the failed argument
+	static const char *
+	GetResponseFileError(details::ResponseFiles::Status status) noexcept
+	{
+		switch(status)
+		{
+			case details::ResponseFiles::Status::UNREADABLE:
+				return "Could not read response file: ";
+
+			case details::ResponseFiles::Status::TOO_DEEP:
+				return "Response files nested too deeply: ";
+
+			case details::ResponseFiles::Status::RECURSIVE:
+				return "Response file includes itself: ";
+
+			default:
+				return "Too many response files: ";
+		}
+	}
+
+	static ParseResult StreamFailure(const details::Generator &generator)
+	{
+		ParseResult result = ParseResult::Failure(
+		    ErrorCode::INVALID_STREAM, generator.GetIndex(), nullptr, nullptr);
+		result._detail = generator.GetError();
+		return result;
+	}
+
+	static bool ThrowOnFailure(const ParseResult &result)
+	{
+#ifndef CLI_NO_EXCEPTIONS
+		if(result.GetCause())
+		{
+			std::rethrow_exception(result.GetCause());
+		}
+#endif
+		if(!result)
+		{
+			details::Throw<std::invalid_argument>(result.GetMessage());
+		}
+		return result.IsExit();
+	}
+
+	std::pmr::vector<GenericArgument> _args;
 	const char *_description;
 	std::size_t _numPositionals;
+	details::FlagTable _flags;
+	// sorted flag names, only filled when abbreviations are enabled
+	details::PrefixTable _prefixes;
+	// flags by their single character alias
+	details::ShortFlagTable _shortFlags;
+	// arguments by the name of the environment variable bound to them
+	details::FlagTable _environment;
+	bool _usesEnvironment;
+	bool _abbreviations;
+	// indices of arguments with a non-zero minimum arity
+	std::pmr::vector<std::size_t> _required;
+	// TypeTag() of the object arguments are members of, if any
+	const void *_objectType;
+	bool _responseFiles;
+	// an argument's destination refers to the strings it was parsed from
+	bool _refersToInput;
+	// every argument's value can be written to a snapshot
+	bool _isSerializable;
+	// identifies the arguments in snapshots, see SetSnapshotFile()
+	std::uint64_t _layoutHash;
+	ParseContext _context;
 };
 
 
@@ -0,0 +1,14 @@
+/// @file
+/// @brief Contains the configuration macros of cli.
+/// @details CLI_NO_EXCEPTIONS selects the configuration for code built without
+/// exceptions.  It is defined automatically when the compiler has exceptions
+/// disabled and may also be defined by users, for example by the CMake option
+/// of the same name.  In this configuration failures are reported through
+/// return values such as cli::ParseResult or passed to the handler installed
+/// by cli::SetErrorHandler().  cli never uses RTTI.
+#pragma once
+
+
+#if !defined(CLI_NO_EXCEPTIONS) && !defined(__cpp_exceptions)
+#define CLI_NO_EXCEPTIONS
+#endif
@@ -0,0 +1,110 @@
+/// @file
+/// @brief Contains cli::SetErrorHandler() and how cli reports errors.
+#pragma once
+
+#include "cli/Config.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+
+namespace cli
+{
+
+
+/// @brief Function called with a description of an error that can not be
+/// reported by a return value when exceptions are disabled.
+using ErrorHandler = void (*)(const char *message);
+
+
+namespace details
+{
+
+
+inline std::atomic<ErrorHandler> &GetErrorHandlerSlot() noexcept
+{
+	static std::atomic<ErrorHandler> handler{nullptr};
+	return handler;
+}
+
+
+} // namespace details
+
+
+/// @brief Installs the function called on errors when CLI_NO_EXCEPTIONS is
+/// defined.
+/// @details These errors are the ones thrown when exceptions are enabled,
+/// for example an invalid command line passed to cli::CommandLine::Run().
+/// cli::CommandLine::TryRun() reports failures in its result and does not call
+/// the handler.  After the handler returns the program is aborted.  Without a
+/// handler the message is written to stderr before aborting.
+/// @param handler The new handler or nullptr to restore the default.
+/// @returns The previously installed handler.
+inline ErrorHandler SetErrorHandler(ErrorHandler handler) noexcept
+{
+	return details::GetErrorHandlerSlot().exchange(handler);
+}
+
+
+namespace details
+{
+
+
+/// @brief Throws an exception or, when exceptions are disabled, calls the
+/// installed error handler and aborts.
+template <typename Exception> [[noreturn]] void Throw(const char *message)
+{
+#ifdef CLI_NO_EXCEPTIONS
+	const ErrorHandler handler = GetErrorHandlerSlot().load();
+	if(handler != nullptr)
+	{
+		handler(message);
+	}
+	else
+	{
+		std::fprintf(stderr, "%s\n", message);
+	}
+	std::abort();
+#else
+	throw Exception(message);
+#endif
+}
+
+template <typename Exception>
+[[noreturn]] void Throw(const std::string &message)
+{
+	Throw<Exception>(message.c_str());
+}
+
+
+/// @brief Gets the message of the last failed parse on this thread when
+/// exceptions are disabled.
+inline const char *&GetParseError() noexcept
+{
+	thread_local const char *message = "";
+	return message;
+}
+
+
+/// @brief Reports a value that could not be parsed.
+/// @details Parsers return the result of this function when they fail.
+/// @returns False if exceptions are disabled, otherwise throws
+/// std::invalid_argument.
+inline bool ParseFailure(const char *message)
+{
+#ifdef CLI_NO_EXCEPTIONS
+	GetParseError() = message;
+	return false;
+#else
+	throw std::invalid_argument(message);
+#endif
+}
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -1,12 +1,17 @@
 #pragma once
 
 #include "cli/Arity.hpp"
+#include "cli/ErrorHandler.hpp"
 #include "cli/details/Destination.hpp"
 #include "cli/details/Generator.hpp"
+#include "cli/details/Split.hpp"
 #include "cli/details/Usage.hpp"
 
 #include <cassert>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
 
@@ -32,10 +37,16 @@ private:
 	{
 		details::Destination destination;
 		Arity arity;
+		// '\0' unless each value is a list of elements
+		char separator;
 
-		NormalState(details::Destination destination_, Arity arity_)
+		NormalState(
+		    details::Destination destination_,
+		    Arity arity_,
+		    char separator_)
 		    : destination(destination_)
 		    , arity(arity_)
+		    , separator(separator_)
 		{}
 	};
 
@@ -56,34 +67,52 @@ private:
 
 	struct BoolState
 	{
-		bool *destination;
+		details::Destination destination;
+		bool active;
 
-		BoolState(bool &destination_)
-		    : destination(&destination_)
+		BoolState(details::Destination destination_, bool active_)
+		    : destination(destination_)
+		    , active(active_)
 		{}
 	};
 
 public:
 	/// @brief Constructor for a normal argument.
 	/// @details Do not call directly, use cli::Argument().
+	/// @param separator The character that splits each value into a list of
+	/// elements, or '\0' if values are not lists.
+	/// @param shortName The single character alias of this flag, or '\0'.
+	/// @param environment The name of the environment variable that gives
+	/// this argument's value when it is not on the command line, or null.
 	GenericArgument(
 	    Kind kind,
 	    const char *name,
 	    details::Destination destination,
 	    Arity arity,
-	    const char *help)
+	    const char *help,
+	    char separator = '\0',
+	    char shortName = '\0',
+	    const char *environment = nullptr)
 	    : _name(name)
-	    , _state(std::in_place_type<NormalState>, destination, arity)
+	    , _state(
+	          std::in_place_type<NormalState>, destination, arity, separator)
 	    , _help(help)
+	    , _shortName(shortName)
+	    , _environment(environment)
 	{
 		assert(kind == Kind::NORMAL);
 	}
 
 	/// @brief Constructor for help and usage.
-	GenericArgument(Kind kind, const char *name, const char *help)
+	GenericArgument(
+	    Kind kind,
+	    const char *name,
+	    const char *help,
+	    char shortName = '\0')
 	    : _name(name)
 	    , _state(std::in_place_type<HelpState>)
 	    , _help(help)
+	    , _shortName(shortName)
 	{
 		switch(kind)
 		{
@@ -104,23 +133,32 @@ public:
 	    Kind kind,
 	    const char *name,
 	    const char *version,
-	    const char *help)
+	    const char *help,
+	    char shortName = '\0')
 	    : _name(name)
 	    , _state(std::in_place_type<VersionState>, version)
 	    , _help(help)
+	    , _shortName(shortName)
 	{
 		assert(kind == Kind::VERSION);
 	}
 
 	/// @brief Constructor for StoreTrue and StoreFalse
+	/// @param destination The boolean destination of this flag.
+	/// @param active The value stored when this flag is given.
 	GenericArgument(
 	    Kind kind,
 	    const char *name,
-	    bool &destination,
-	    const char *help)
+	    details::Destination destination,
+	    bool active,
+	    const char *help,
+	    char shortName = '\0',
+	    const char *environment = nullptr)
 	    : _name(name)
-	    , _state(std::in_place_type<BoolState>, destination)
+	    , _state(std::in_place_type<BoolState>, destination, active)
 	    , _help(help)
+	    , _shortName(shortName)
+	    , _environment(environment)
 	{
 		assert(kind == Kind::BOOL);
 	}
@@ -131,6 +169,20 @@ public:
 		return _name;
 	}
 
+	/// @brief Gets the single character alias of this flag, such as 'v' for
+	/// "-v", or '\0' if it has none.
+	char GetShortName() const noexcept
+	{
+		return _shortName;
+	}
+
+	/// @brief Gets the name of the environment variable bound to this
+	/// argument, or null if it has none.
+	const char *GetEnvironment() const noexcept
+	{
+		return _environment;
+	}
+
 	/// @brief Gets the kind of this argument.
 	Kind GetKind() const noexcept
 	{
@@ -154,42 +206,321 @@ public:
 		}
 	}
 
+	/// @brief Gets the character that splits each value of this argument into
+	/// a list of elements, or '\0' if its values are not lists.
+	char GetSeparator() const noexcept
+	{
+		if(GetKind() == Kind::NORMAL)
+		{
+			return std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+			    .separator;
+		}
+		return '\0';
+	}
+
+	/// @brief Gets the TypeTag() of the object this argument's destination is
+	/// a member of, or nullptr if it has no such destination.
+	const void *GetObjectType() const noexcept
+	{
+		switch(GetKind())
+		{
+			case Kind::NORMAL:
+				return std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+				    .destination.GetObjectType();
+
+			case Kind::BOOL:
+				return std::get<static_cast<std::size_t>(Kind::BOOL)>(_state)
+				    .destination.GetObjectType();
+
+			default:
+				return nullptr;
+		}
+	}
+
+	/// @brief Gets if the values of this argument refer to the strings they
+	/// were parsed from instead of copying them.
+	bool RefersToInput() const noexcept
+	{
+		return GetKind() == Kind::NORMAL
+		    && std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+		           .destination.RefersToInput();
+	}
+
+	/// @brief Prepares an object that is about to be parsed into.
+	/// @details Boolean flags that are members of the object are set to their
+	/// inactive value.  Flags bound to a single object were already set when
+	/// they were created.
+	/// @param object The object being parsed into, may be null.
+	void Initialize(void *object) const
+	{
+		if(GetKind() == Kind::BOOL)
+		{
+			const BoolState &state =
+			    std::get<static_cast<std::size_t>(Kind::BOOL)>(_state);
+			if(state.destination.GetObjectType() != nullptr)
+			{
+				*static_cast<bool *>(state.destination.Locate(object)) =
+				    !state.active;
+			}
+		}
+	}
+
 	/// @brief Handles the occurrence of a command line argument.
 	/// @param[in, out] generator Command line argument generator that contained
 	/// this argument.  Should be at the value (if any) that this argument will
 	/// be consuming.
-	void Handle(details::Generator &generator)
+	/// @param count The number of times this argument was previously handled
+	/// during the current parse.
+	/// @param object The object being parsed into, may be null if no
+	/// destination is a member of an object.
+	/// @returns True on success.  On failure the exception thrown by the
+	/// parser propagates, or when exceptions are disabled false is returned.
+	bool Handle(
+	    details::Generator &generator,
+	    std::size_t count,
+	    void *object) const
+	{
+		if(GetKind() != Kind::NORMAL)
+		{
+			return Handle(nullptr, count, object);
+		}
+		if(generator.IsEmpty())
+		{
+			details::Throw<std::invalid_argument>(
+			    "Invalid command line arguments: Excepted value after "
+			    + std::string(GetName()));
+		}
+		return Handle(generator.Next(), count, object);
+	}
+
+	/// @brief Handles the occurrence of a command line argument whose value,
+	/// if it takes one, was part of the same argument, such as "-n10".
+	/// @param value The value.  Ignored by arguments that take no value.
+	/// @param count The number of times this argument was previously handled
+	/// during the current parse.
+	/// @param object The object being parsed into, may be null if no
+	/// destination is a member of an object.
+	/// @returns True on success.  On failure the exception thrown by the
+	/// parser propagates, or when exceptions are disabled false is returned.
+	bool Handle(const char *value, std::size_t count, void *object) const
 	{
 		switch(GetKind())
 		{
 			case Kind::NORMAL:
 			{
-				if(generator.Remaining() == 0)
-				{
-					throw std::invalid_argument(
-					    "Invalid command line arguments: Excepted value after "
-					    + std::string(GetName()));
-				}
-				NormalState &state =
+				const NormalState &state =
 				    std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state);
-				state.destination.Store(generator.Next());
-				break;
+				return state.destination.Store(value, count, object);
 			}
 
 			case Kind::BOOL:
 			{
-				BoolState &state =
+				const BoolState &state =
 				    std::get<static_cast<std::size_t>(Kind::BOOL)>(_state);
-				// boolean flags are initialized in their inactive state, just
-				// need to flip it
-				*state.destination = !*state.destination;
+				*static_cast<bool *>(state.destination.Locate(object)) =
+				    state.active;
+				return true;
 			}
 
+			default:
+				return true;
+		}
+	}
+
+	/// @brief Handles a value of this argument that is a list, storing each
+	/// of its elements.
+	/// @details An empty list has no elements.
+	/// @pre GetSeparator() != '\0'.
+	/// @param begin The start of the list.
+	/// @param end The end of the list.
+	/// @param count The number of elements previously handled during the
+	/// current parse.
+	/// @param object The object being parsed into, may be null if no
+	/// destination is a member of an object.
+	/// @returns True on success.  On failure the exception thrown by the
+	/// parser propagates, or when exceptions are disabled false is returned.
+	bool HandleList(
+	    const char *begin,
+	    const char *end,
+	    std::size_t count,
+	    void *object) const
+	{
+		if(begin == end)
+		{
+			return true;
+		}
+		const NormalState &state =
+		    std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state);
+		const char *element = begin;
+		bool isValid = true;
+		details::ForEachSeparator(
+		    begin, end, state.separator, [&](const char *separator) {
+			    // with exceptions disabled stop storing after a failure
+			    isValid = isValid
+			        && state.destination.StoreElement(
+			            MakeView(element, separator), count++, object);
+			    element = separator + 1;
+		    });
+		return isValid
+		    && state.destination.StoreElement(
+		        MakeView(element, end), count, object);
+	}
+
+	/// @brief Handles a value of this argument that is not null terminated.
+	/// @pre GetKind() == Kind::NORMAL.
+	/// @param value The value.
+	/// @param count The number of times this argument was previously handled
+	/// during the current parse.
+	/// @param object The object being parsed into, may be null if no
+	/// destination is a member of an object.
+	/// @returns True on success.  On failure the exception thrown by the
+	/// parser propagates, or when exceptions are disabled false is returned.
+	bool HandleElement(
+	    std::string_view value,
+	    std::size_t count,
+	    void *object) const
+	{
+		return std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+		    .destination.StoreElement(value, count, object);
+	}
+
+	/// @brief Gets if HandleRun() is supported.
+	bool CanHandleRuns() const noexcept
+	{
+		return GetKind() == Kind::NORMAL
+		    && std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+		           .destination.CanStoreRuns();
+	}
+
+	/// @brief Handles a run of values of this argument with one call.
+	/// @pre CanHandleRuns().
+	/// @param values The values.
+	/// @param count The number of values.
+	/// @param object The object being parsed into, may be null if no
+	/// destination is a member of an object.
+	/// @param[out] handled The number of values handled, the index of the
+	/// failing value on failure.
+	/// @param pool The pool to convert long runs on, may be null.
+	/// @returns True on success.  On failure the exception thrown by the
+	/// parser propagates, or when exceptions are disabled false is returned.
+	bool HandleRun(
+	    const char *const *values,
+	    std::size_t count,
+	    void *object,
+	    std::size_t &handled,
+	    ThreadPool *pool = nullptr) const
+	{
+		return std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+		    .destination.StoreRun(values, count, object, handled, pool);
+	}
+
+	/// @brief Gets if SaveValue(), CheckValue() and LoadValue() are supported,
+	/// which is the case when this argument stores no value or its value is
+	/// serializable.
+	bool CanSerialize() const noexcept
+	{
+		switch(GetKind())
+		{
+			case Kind::NORMAL:
+				return std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+				    .destination.CanSerialize();
+
+			case Kind::BOOL:
+				return std::get<static_cast<std::size_t>(Kind::BOOL)>(_state)
+				    .destination.CanSerialize();
+
+			default:
+				return true;
+		}
+	}
+
+	/// @brief Writes the value of this argument to a snapshot, if it stores
+	/// one.
+	/// @pre CanSerialize().
+	/// @param object The object being parsed into, may be null if no
+	/// destination is a member of an object.
+	void SaveValue(SnapshotWriter &writer, void *object) const
+	{
+		switch(GetKind())
+		{
+			case Kind::NORMAL:
+				std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+				    .destination.Save(writer, object);
+				break;
+
+			case Kind::BOOL:
+				std::get<static_cast<std::size_t>(Kind::BOOL)>(_state)
+				    .destination.Save(writer, object);
+				break;
+
 			default:
 				break;
 		}
 	}
 
+	/// @brief Replaces the value of this argument with one written by
+	/// SaveValue().
+	/// @pre CanSerialize().
+	/// @param object The object being parsed into, may be null if no
+	/// destination is a member of an object.
+	/// @returns False if the snapshot does not hold a valid value.
+	bool LoadValue(SnapshotReader &reader, void *object) const
+	{
+		switch(GetKind())
+		{
+			case Kind::NORMAL:
+				return std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+				    .destination.Load(reader, object);
+
+			case Kind::BOOL:
+				return std::get<static_cast<std::size_t>(Kind::BOOL)>(_state)
+				    .destination.Load(reader, object);
+
+			default:
+				return true;
+		}
+	}
+
+	/// @brief Reads a value written by SaveValue() without storing it.
+	/// @pre CanSerialize().
+	/// @returns False if the snapshot does not hold a valid value.
+	bool CheckValue(SnapshotReader &reader) const
+	{
+		switch(GetKind())
+		{
+			case Kind::NORMAL:
+				return std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+				    .destination.Check(reader);
+
+			case Kind::BOOL:
+				return std::get<static_cast<std::size_t>(Kind::BOOL)>(_state)
+				    .destination.Check(reader);
+
+			default:
+				return true;
+		}
+	}
+
+	/// @brief Gets the cli::GetSerializeFingerprint() of the value of this
+	/// argument, or zero if it stores no value.
+	/// @pre CanSerialize().
+	std::uint64_t GetFingerprint() const
+	{
+		switch(GetKind())
+		{
+			case Kind::NORMAL:
+				return std::get<static_cast<std::size_t>(Kind::NORMAL)>(_state)
+				    .destination.GetFingerprint();
+
+			case Kind::BOOL:
+				return std::get<static_cast<std::size_t>(Kind::BOOL)>(_state)
+				    .destination.GetFingerprint();
+
+			default:
+				return 0;
+		}
+	}
+
 	const char *GetVersion() const
 	{
 		if(GetKind() == Kind::VERSION)
@@ -215,19 +546,32 @@ public:
 	/// @brief Gets a string to use in the help message for this argument.
 	std::string GetHelp() const
 	{
+		std::string help;
+		if(_shortName != '\0')
+		{
+			help = {'-', _shortName, ',', ' '};
+		}
+		help += GetName();
 		if(GetKind() == Kind::NORMAL && GetName()[0] == '-')
 		{
-			return std::string(GetName()) + ' ' + (GetName() + 2) + ": "
-			    + _help;
+			help += ' ';
+			help += GetName() + 2;
 		}
-		return std::string(GetName()) + ": " + _help;
+		return help + ": " + _help;
 	}
 
 private:
+	static std::string_view MakeView(const char *begin, const char *end)
+	{
+		return std::string_view(begin, static_cast<std::size_t>(end - begin));
+	}
+
 	const char *_name;
 	std::variant<NormalState, HelpState, UsageState, VersionState, BoolState>
 	    _state;
 	const char *_help;
+	char _shortName;
+	const char *_environment = nullptr;
 };
 
 
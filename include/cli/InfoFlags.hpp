@@ -14,16 +14,17 @@ namespace cli
 /// @tparam Keywords Keyword argument types.
 /// @param flag The flag that will trigger the help message.  Must start with a
 /// dash.
-/// @param keywords Keyword arguments.  Supports cli::help.
+/// @param keywords Keyword arguments.  Supports cli::help and cli::shortName.
 /// @returns The created argument.
 template <typename... Keywords>
 GenericArgument Help(const char *flag, Keywords... keywords)
 {
-	keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+	keyword::Arguments kwargs{keyword::Names{help, shortName}, keywords...};
 	return GenericArgument(
 	    GenericArgument::Kind::HELP,
 	    flag,
-	    kwargs.GetOrDefault(help, "prints this help message and exits"));
+	    kwargs.GetOrDefault(help, "prints this help message and exits"),
+	    kwargs.GetOrDefault(shortName, '\0'));
 }
 
 
@@ -32,16 +33,17 @@ GenericArgument Help(const char *flag, Keywords... keywords)
 /// @tparam Keywords Keyword argument types.
 /// @param flag The flag that will trigger the usage message.  Must start with a
 /// dash.
-/// @param keywords Keyword arguments.  Supports cli::help.
+/// @param keywords Keyword arguments.  Supports cli::help and cli::shortName.
 /// @returns The created argument.
 template <typename... Keywords>
 GenericArgument Usage(const char *flag, Keywords... keywords)
 {
-	keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+	keyword::Arguments kwargs{keyword::Names{help, shortName}, keywords...};
 	return GenericArgument(
 	    GenericArgument::Kind::USAGE,
 	    flag,
-	    kwargs.GetOrDefault(help, "prints usage and exits"));
+	    kwargs.GetOrDefault(help, "prints usage and exits"),
+	    kwargs.GetOrDefault(shortName, '\0'));
 }
 
 
@@ -50,18 +52,19 @@ GenericArgument Usage(const char *flag, Keywords... keywords)
 /// @param flag The flag that will trigger the version message.  Must start with
 /// a dash.
 /// @param version The version string to print when requested.
-/// @param keywords Keyword arguments.  Supports cli::help.
+/// @param keywords Keyword arguments.  Supports cli::help and cli::shortName.
 /// @returns The created argument.
 template <typename... Keywords>
 GenericArgument
 Version(const char *flag, const char *version, Keywords... keywords)
 {
-	keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+	keyword::Arguments kwargs{keyword::Names{help, shortName}, keywords...};
 	return GenericArgument(
 	    GenericArgument::Kind::VERSION,
 	    flag,
 	    version,
-	    kwargs.GetOrDefault(help, "prints version and exits"));
+	    kwargs.GetOrDefault(help, "prints version and exits"),
+	    kwargs.GetOrDefault(shortName, '\0'));
 }
 
 
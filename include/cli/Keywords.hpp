@@ -4,6 +4,8 @@
 
 #include "keyword.hpp"
 
+#include <memory_resource>
+
 
 namespace cli
 {
@@ -19,6 +21,24 @@ struct HelpTag
 struct ArityTag
 {};
 
+struct SeparatorTag
+{};
+
+struct ShortNameTag
+{};
+
+struct EnvironmentTag
+{};
+
+struct ResponseFilesTag
+{};
+
+struct MemoryResourceTag
+{};
+
+struct AbbreviationsTag
+{};
+
 
 } // namespace details
 
@@ -27,5 +47,48 @@ inline keyword::Name<details::HelpTag, const char *> help;
 
 inline keyword::Name<details::ArityTag, Arity> arity;
 
+/// @brief Splits each value of an argument into a list of elements at a
+/// character, for example cli::separator = ',' accepts "--ids 1,2,3".
+/// @details Elements are stored as if each had been given separately and
+/// the arity of the argument limits the number of elements.  An empty value
+/// is an empty list.
+inline keyword::Name<details::SeparatorTag, char> separator;
+
+/// @brief Gives a flag a single character alias, for example
+/// cli::shortName = 'v' lets "--verbose" also be given as "-v".
+/// @details Short flags can be clustered, "-xvf" gives "-x", "-v" and "-f".
+/// A short flag that takes a value takes the rest of its argument, "-n10"
+/// or "-vn10", or the next argument when nothing follows it.  Must be an
+/// ASCII character other than '-'.
+inline keyword::Name<details::ShortNameTag, char> shortName;
+
+/// @brief Binds an argument to an environment variable that gives its value
+/// when the argument is not on the command line, for example
+/// cli::environment = "APP_THREADS".
+/// @details The variable's value is parsed like a value given on the command
+/// line and counts toward the arity of the argument, so it satisfies a
+/// required argument that takes one value.  Boolean flags are given when the
+/// variable is "1", "true", "yes" or "on" and not given when it is empty,
+/// "0", "false", "no" or "off".
+inline keyword::Name<details::EnvironmentTag, const char *> environment;
+
+/// @brief Enables expanding "@path" arguments of a cli::CommandLine into the
+/// arguments listed in the response file at path.
+inline keyword::Name<details::ResponseFilesTag, bool> responseFiles;
+
+/// @brief The memory resource that a cli::CommandLine allocates its arguments,
+/// flag lookup table and the per-argument storage of its contexts from.
+/// @details Must outlive the command line and the contexts it makes.
+/// Buffers for response files and command strings still use the heap.
+inline keyword::Name<details::MemoryResourceTag, std::pmr::memory_resource *>
+    memoryResource;
+
+/// @brief Enables giving a flag of a cli::CommandLine by any prefix that
+/// only it starts with, for example "--verb" for "--verbose".
+/// @details Exact names are always preferred, so a flag that is a prefix of
+/// another can still be given.  A prefix of more than one flag fails with
+/// ErrorCode::AMBIGUOUS_FLAG.
+inline keyword::Name<details::AbbreviationsTag, bool> abbreviations;
+
 
 } // namespace cli
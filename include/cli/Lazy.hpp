@@ -0,0 +1,185 @@
+/// @file
+/// @brief Contains cli::Lazy.
+#pragma once
+
+#include "cli/ErrorHandler.hpp"
+#include "cli/details/Destination.hpp"
+#include "cli/details/Lazy_fwd.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace cli
+{
+
+
+/// @brief A destination that keeps the strings given to it and only converts
+/// them to a T when the value is first read.
+/// @details Useful for options that are expensive to convert and that only
+/// some code paths read.  Storing a value during a run only records where
+/// its string is, cli::Parse() runs on first access and the result is
+/// cached.  The arity and conversion rules are the ones of a T destination.
+/// Strings stored by a run that were not converted before the next run
+/// stores to this value are dropped.
+///
+/// The recorded strings are referred to rather than copied, so a Lazy
+/// follows the lifetime rules of std::string_view destinations given in
+/// cli::CommandLine.  Converting is not thread safe, convert before
+/// sharing a Lazy between threads.
+/// @tparam T The type the strings are converted to.
+template <typename T> class Lazy
+{
+public:
+	/// @brief Constructs a lazy value that reads as a value initialized T
+	/// when nothing is stored to it.
+	Lazy() = default;
+
+	/// @brief Constructs a lazy value that reads as a default value when
+	/// nothing is stored to it.
+	/// @details Converted values are stored on top of the default like they
+	/// would be for a T destination, for example appended to a vector.
+	explicit Lazy(T defaultValue)
+	    : _value(std::move(defaultValue))
+	{}
+
+	/// @brief Gets if there are stored strings that have not been converted.
+	bool IsPending() const noexcept
+	{
+		return _count != 0;
+	}
+
+	/// @brief Converts any stored strings now.
+	/// @details Reports errors the same way cli::Parse() does.  After a
+	/// failure the value is unchanged and the strings are kept, so the next
+	/// access fails again.
+	/// @returns True on success.  On failure the exception thrown by the
+	/// parser propagates, or when exceptions are disabled false is returned.
+	bool Validate()
+	{
+		if(_count == 0)
+		{
+			return true;
+		}
+		// convert into a copy so a failure leaves the value unchanged
+		T value = _value;
+		const details::Destination destination(value);
+		for(std::size_t i = 0; i < _count; ++i)
+		{
+			const Token &token = i == 0 ? _first : _rest[i - 1];
+			if(!Store(destination, token))
+			{
+				return false;
+			}
+		}
+		_value = std::move(value);
+		_count = 0;
+		_rest.clear();
+		return true;
+	}
+
+	/// @brief Gets the value, converting any stored strings first.
+	/// @details Conversion errors propagate as the exception thrown by the
+	/// parser.  When exceptions are disabled the installed error handler is
+	/// called, see cli::SetErrorHandler().
+	T &Get()
+	{
+		if(!Validate())
+		{
+			details::Throw<std::invalid_argument>(details::GetParseError());
+		}
+		return _value;
+	}
+
+	/// @copydoc Get()
+	T &operator*()
+	{
+		return Get();
+	}
+
+	/// @copydoc Get()
+	T *operator->()
+	{
+		return &Get();
+	}
+
+	/// @brief Records a whole argument to convert later.
+	/// @details Called by cli::details::Destination in place of cli::Parse().
+	/// Only the pointer is kept, the length is not computed until the
+	/// argument is converted.
+	/// @param input The argument.
+	/// @param index The number of values previously stored during the
+	/// current parse.
+	/// @returns True.
+	bool Capture(const char *input, std::size_t index)
+	{
+		return Capture(Token{input, wholeArgument, index});
+	}
+
+	/// @brief Records an element of a list value to convert later.
+	/// @details Called by cli::details::Destination in place of cli::Parse().
+	/// @param input The element.
+	/// @param index The number of values previously stored during the
+	/// current parse.
+	/// @returns True.
+	bool Capture(std::string_view input, std::size_t index)
+	{
+		return Capture(Token{input.data(), input.size(), index});
+	}
+
+private:
+	// size of a token that is a whole null terminated argument
+	static constexpr std::size_t wholeArgument = static_cast<std::size_t>(-1);
+
+	struct Token
+	{
+		const char *data;
+		std::size_t size;
+		std::size_t index;
+	};
+
+	bool Capture(Token token)
+	{
+		if(token.index == 0)
+		{
+			// a new run, strings of an earlier one may no longer be valid
+			_count = 0;
+			_rest.clear();
+		}
+		if(_count == 0)
+		{
+			_first = token;
+		}
+		else
+		{
+			_rest.push_back(token);
+		}
+		++_count;
+		return true;
+	}
+
+	static bool Store(const details::Destination &destination, Token token)
+	{
+		if(token.size == wholeArgument)
+		{
+			// passed on as is so destinations that keep a const char * work
+			// as they would without a Lazy
+			return destination.Store(token.data, token.index);
+		}
+		return destination.StoreElement(
+		    std::string_view(token.data, token.size), token.index);
+	}
+
+	T _value{};
+	// the first string is kept inline so a single valued option costs no
+	// allocation
+	Token _first{};
+	std::vector<Token> _rest;
+	std::size_t _count = 0;
+};
+
+
+} // namespace cli
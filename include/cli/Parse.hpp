@@ -2,25 +2,61 @@
 /// @brief Contains cli::Parse()
 #pragma once
 
+#include "cli/ErrorHandler.hpp"
 #include "cli/details/ParseTraits.hpp"
 #include "cli/details/Parse_fwd.hpp"
+#include "cli/details/TerminatedCopy.hpp"
 
 #include <sstream>
+#include <string>
+#include <string_view>
 #include <type_traits>
 
 namespace cli
 {
 
 
-template <typename T> void Parse(T &value, const char *input)
+namespace details
 {
-	if constexpr(details::HasUserDefinedParse_v<T>)
+
+
+/// @brief Calls a user defined parse function.
+template <typename T, typename Input>
+bool CallUserDefinedParse(T &value, Input input)
+{
+	if constexpr(std::is_same_v<decltype(CLIParse(value, input)), bool>)
+	{
+		// user parsers that can not throw report failure by returning false
+		if(!CLIParse(value, input))
+		{
+			return ParseFailure("Invalid value.");
+		}
+	}
+	else
 	{
 		CLIParse(value, input);
 	}
+	return true;
+}
+
+
+} // namespace details
+
+
+/// @brief Parses a command line value.
+/// @param value The destination of the parsed value.
+/// @param input The string to parse.
+/// @returns True on success.  On failure std::invalid_argument is thrown, or
+/// when exceptions are disabled false is returned.
+template <typename T> bool Parse(T &value, const char *input)
+{
+	if constexpr(details::HasUserDefinedParse_v<T>)
+	{
+		return details::CallUserDefinedParse(value, input);
+	}
 	else if constexpr(details::HasInternalParse_v<T>)
 	{
-		cli::details::Parse(value, input);
+		return cli::details::Parse(value, input);
 	}
 	else if constexpr(details::HasStreamExtraction_v<T>)
 	{
@@ -28,8 +64,9 @@ template <typename T> void Parse(T &value, const char *input)
 		iss >> value;
 		if(iss.fail())
 		{
-			throw std::invalid_argument("Stream extraction failed.");
+			return details::ParseFailure("Stream extraction failed.");
 		}
+		return true;
 	}
 	else
 	{
@@ -37,9 +74,53 @@ template <typename T> void Parse(T &value, const char *input)
 		    !std::is_same<T, T>::value,
 		    "cli does not know how to parse this type.  Either implement a "
 		    "stream extraction operator or 'void CLIParse(T &value, "
-		    "const char *input)'.  CLIParse() is intended to be "
-		    "implemented by users externally of this library in the namespace "
-		    "of the type T that is being parsed.");
+		    "std::string_view input)', which may return bool instead and "
+		    "may take a 'const char *' instead.  CLIParse() is intended to "
+		    "be implemented by users externally of this library in the "
+		    "namespace of the type T that is being parsed.");
+	}
+}
+
+
+/// @brief Parses a command line value that is a string view, such as a
+/// sub-range of a longer string.
+/// @details Parsers for standard types and user defined parse functions
+/// taking a std::string_view convert the view directly.  User defined parse
+/// functions taking a const char * and stream extraction operators are
+/// given a null terminated copy.
+/// @param value The destination of the parsed value.
+/// @param input The string to parse, need not be null terminated.
+/// @returns True on success.  On failure std::invalid_argument is thrown, or
+/// when exceptions are disabled false is returned.
+template <typename T> bool Parse(T &value, std::string_view input)
+{
+	if constexpr(details::HasUserDefinedViewParse_v<T>)
+	{
+		return details::CallUserDefinedParse(value, input);
+	}
+	else if constexpr(details::HasUserDefinedParse_v<T>)
+	{
+		const details::TerminatedCopy copy(input);
+		return details::CallUserDefinedParse(value, copy.Get());
+	}
+	else if constexpr(details::HasInternalParse_v<T>)
+	{
+		return cli::details::Parse(value, input);
+	}
+	else if constexpr(details::HasStreamExtraction_v<T>)
+	{
+		std::istringstream iss{std::string(input)};
+		iss >> value;
+		if(iss.fail())
+		{
+			return details::ParseFailure("Stream extraction failed.");
+		}
+		return true;
+	}
+	else
+	{
+		// reports the same error as the overload taking a const char *
+		return cli::Parse(value, static_cast<const char *>(nullptr));
 	}
 }
 
@@ -0,0 +1,176 @@
+/// @file
+/// @brief Contains cli::ParseContext.
+#pragma once
+
+#include "cli/ThreadPool.hpp"
+#include "cli/details/ConfigFile.hpp"
+#include "cli/details/Destination.hpp"
+#include "cli/details/ResponseFiles.hpp"
+#include "cli/details/SnapshotFile.hpp"
+#include "cli/details/Tokenizer.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+
+namespace cli
+{
+
+
+class CommandLine;
+
+
+/// @brief Holds the state of a single cli::CommandLine::Run() call.
+/// @details A command line is immutable while running so it can be shared
+/// between threads, each thread running it with its own context.  Contexts
+/// are cheap to construct and can be reused for many runs, the storage they
+/// need is allocated the first time they are used or up front by
+/// cli::CommandLine::MakeContext().
+///
+/// Response files expanded by a run stay mapped, and arguments pointing into
+/// them stay valid, until the context is used for another run or destroyed.
+/// The same holds for arguments split from a command string and values read
+/// from a config file or a snapshot.
+class ParseContext
+{
+public:
+	ParseContext() = default;
+
+	/// @brief Constructs a context whose per-argument storage is allocated
+	/// from a memory resource, which must outlive it.
+	explicit ParseContext(std::pmr::memory_resource *resource)
+	    : _counts(resource)
+	    , _isFromEnvironment(resource)
+	    , _isSet(resource)
+	{}
+
+	/// @brief Binds the object that arguments created from data members, for
+	/// example by cli::Argument<&Object::member>(), are stored into.
+	/// @tparam Object The type of the object.  Must be the type that the
+	/// arguments are members of.
+	/// @param object The object.  Must outlive any run using this context.
+	template <typename Object> void Bind(Object &object) noexcept
+	{
+		static_assert(
+		    !std::is_const_v<Object>, "Can not parse into a const object.");
+		_object = &object;
+		_objectType = details::TypeTag<Object>();
+	}
+
+	/// @brief Removes any bound object.
+	void Unbind() noexcept
+	{
+		_object = nullptr;
+		_objectType = nullptr;
+	}
+
+	/// @brief Sets the pool that runs using this context convert long runs
+	/// of positional values on.
+	/// @details Values bound to a std::vector, set or map positional are
+	/// first collected and then converted in parallel, see
+	/// details::StoreRun().  Failures are reported at the same argument
+	/// index as without a pool.  The pool must outlive any run using this
+	/// context and must not run anything else during those runs.
+	/// @param pool The pool, or nullptr to convert on the running thread.
+	void SetThreadPool(ThreadPool *pool) noexcept
+	{
+		_pool = pool;
+	}
+
+	/// @brief Sets whether help, usage and version flags print their message
+	/// to std::cout in runs using this context.
+	/// @details Either way such a flag ends the run with a ParseResult whose
+	/// IsExit() is true.  Contexts print by default.
+	/// @param printsMessages False to end the run without printing.
+	void SetPrintsMessages(bool printsMessages) noexcept
+	{
+		_printsMessages = printsMessages;
+	}
+
+	/// @brief Sets the environment variables that arguments bound with
+	/// cli::environment read from in runs using this context.
+	/// @details By default the environment of the process is read, which is
+	/// not safe while another thread modifies it.
+	/// @param environment A null terminated array of "NAME=value" strings
+	/// that must outlive any run using this context, or nullptr for the
+	/// environment of the process.
+	void SetEnvironment(const char *const *environment) noexcept
+	{
+		_environment = environment;
+	}
+
+	/// @brief Sets a config file that runs using this context read flag
+	/// values from.
+	/// @details Each run maps the file and reads it in a single pass, see
+	/// details::ConfigFile for its syntax.  The key of an entry is the name
+	/// of a flag without its leading dashes, and keys in a "[section]" are
+	/// prefixed by "section.", so "port = 80" in "[server]" gives
+	/// "--server.port 80".  An array gives one value per element.  Boolean
+	/// flags accept the same values as from the environment, see
+	/// cli::environment.  Flags given on the command line or by the
+	/// environment ignore the file, otherwise its values count toward the
+	/// arity like values on the command line.
+	/// @param path The path of the file, which must outlive any run using
+	/// this context, or nullptr to not read a file.
+	void SetConfigFile(const char *path) noexcept
+	{
+		_configPath = path;
+	}
+
+	/// @brief Sets a snapshot file that caches the values of runs of argv
+	/// using this context.
+	/// @details A run first checks for a snapshot written by an earlier run
+	/// of the same command line with the same argv, the same values of the
+	/// environment variables bound with cli::environment, and the same
+	/// config file path.  Every response file and config file that run read
+	/// must also be unchanged, which is checked by their size and
+	/// modification time without reading them.  If all match, every argument
+	/// is set to its value from the snapshot and nothing is parsed.
+	/// Otherwise the run parses as usual and, on success, replaces the
+	/// snapshot.  A snapshot that can not be written is skipped.  Runs of a
+	/// command string, including in place and batch runs, and runs of a
+	/// stream ignore the snapshot.
+	///
+	/// Every value must be serializable, see cli::Serialize(), and default
+	/// constructible, or the run fails with ErrorCode::INVALID_CALL.  All
+	/// values of a snapshot are read into temporaries before any argument is
+	/// set, so a snapshot that can not be read leaves them unchanged.  Runs
+	/// that read files only write snapshots on POSIX systems.  Snapshots are
+	/// skipped when the names or value types of the arguments change, see
+	/// cli::GetSerializeFingerprint().  A type with a CLISerialize() is only
+	/// known by its size and version, so bump its CLISerializeVersion() when
+	/// its format changes.
+	/// @param path The path of the snapshot, which must outlive any run using
+	/// this context, or nullptr to not use one.
+	void SetSnapshotFile(const char *path) noexcept
+	{
+		_snapshotPath = path;
+	}
+
+private:
+	friend class CommandLine;
+
+	// number of values handled by each argument during the current run
+	std::pmr::vector<std::size_t> _counts;
+	void *_object = nullptr;
+	const void *_objectType = nullptr;
+	ThreadPool *_pool = nullptr;
+	bool _printsMessages = true;
+	const char *const *_environment = nullptr;
+	// arguments whose environment variable was set during the current run
+	std::pmr::vector<bool> _isFromEnvironment;
+	const char *_configPath = nullptr;
+	details::ConfigFile _configFile;
+	// arguments given before the config file was read
+	std::pmr::vector<bool> _isSet;
+	details::ResponseFiles _responseFiles;
+	const char *_snapshotPath = nullptr;
+	details::SnapshotFile _snapshot;
+	// arguments of a command string
+	details::Tokenizer _tokenizer;
+};
+
+
+} // namespace cli
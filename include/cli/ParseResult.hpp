@@ -0,0 +1,334 @@
+/// @file
+/// @brief Contains cli::ParseResult.
+#pragma once
+
+#include "cli/Config.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <string>
+
+
+namespace cli
+{
+
+
+class CommandLine;
+class Subcommands;
+
+
+/// @brief The reason a run of a command line failed.
+enum class ErrorCode
+{
+	/// @brief The run succeeded.
+	NONE,
+	/// @brief The arguments to the run itself were invalid, for example a
+	/// null argv.
+	INVALID_CALL,
+	/// @brief A flag that is not part of the command line was given.
+	UNKNOWN_FLAG,
+	/// @brief An argument was given more times than its arity allows.
+	TOO_MANY_VALUES,
+	/// @brief An argument that takes a value was the last argument.
+	MISSING_VALUE,
+	/// @brief A positional value was given after all positional arguments
+	/// were full.
+	UNHANDLED_ARGUMENT,
+	/// @brief An argument was given fewer times than its arity requires.
+	TOO_FEW_VALUES,
+	/// @brief A value could not be parsed into its destination.
+	INVALID_VALUE,
+	/// @brief A response file could not be read, included itself, or response
+	/// files were nested too deeply or too many were read.
+	INVALID_RESPONSE_FILE,
+	/// @brief An argument stream could not be read or contained an argument
+	/// longer than its buffer.
+	INVALID_STREAM,
+	/// @brief A command string had an unterminated quote or ended with a
+	/// backslash.
+	INVALID_COMMAND_STRING,
+	/// @brief The name given for a subcommand is not a subcommand of the
+	/// cli::Subcommands.
+	UNKNOWN_COMMAND,
+	/// @brief No subcommand was given to a cli::Subcommands.
+	MISSING_COMMAND,
+	/// @brief A flag abbreviated with cli::abbreviations is the start of more
+	/// than one flag.
+	AMBIGUOUS_FLAG,
+	/// @brief A value was given with "--name=value" to a flag that does not
+	/// take one.
+	UNEXPECTED_VALUE,
+	/// @brief A config file could not be read, has a syntax error, or has a
+	/// key that is not a flag of the command line.
+	INVALID_CONFIG_FILE
+};
+
+
+/// @brief The result of cli::CommandLine::TryRun() and
+/// cli::Subcommands::TryRun().
+/// @details Failures are described by an error code and the location of the
+/// failure.  The human readable message is only built when GetMessage() is
+/// called, so a failed run costs about as much as a successful one.  The
+/// message refers to the strings in argv, and for failures in a config file to
+/// its contents in the context, which must still be alive when it is built.
+class ParseResult
+{
+public:
+	/// @brief Index used when a failure is not tied to a single argument.
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	/// @brief Constructs the result of a successful run.
+	ParseResult() = default;
+
+	/// @brief Gets if the run succeeded.
+	bool IsSuccess() const noexcept
+	{
+		return _code == ErrorCode::NONE;
+	}
+
+	/// @brief Gets if the run succeeded.
+	explicit operator bool() const noexcept
+	{
+		return IsSuccess();
+	}
+
+	/// @brief Gets if the run stopped at an informational flag such as help
+	/// and the program should exit.
+	bool IsExit() const noexcept
+	{
+		return _isExit;
+	}
+
+	/// @brief Gets the reason the run failed.
+	ErrorCode GetErrorCode() const noexcept
+	{
+		return _code;
+	}
+
+	/// @brief Gets the index in argv of the argument that caused the failure.
+	/// @returns The index or npos if the failure is not tied to a single
+	/// argument, for example when a required argument was not given.
+	/// Arguments read from a response file have the index of the "@path"
+	/// argument that named the file.
+	std::size_t GetIndex() const noexcept
+	{
+		return _index;
+	}
+
+	/// @brief Gets the name of the argument that failed.
+	/// @returns The name of the command line's argument, or for unknown flags,
+	/// unhandled arguments, and invalid response files the string that was
+	/// given.  Null if the failure is not tied to an argument.
+	const char *GetArgumentName() const noexcept
+	{
+		return _argument;
+	}
+
+	/// @brief Gets the path of the config file the failure is in.
+	/// @returns The path, or null if the failure is not in a config file.
+	const char *GetFile() const noexcept
+	{
+		return _file;
+	}
+
+	/// @brief Gets the line of a config file the failure is on, starting at
+	/// one, or zero if it is not tied to a line.
+	std::size_t GetLine() const noexcept
+	{
+		return _line;
+	}
+
+	/// @brief Gets the column in bytes of a config file the failure is at,
+	/// starting at one, or zero if it is not tied to a line.
+	std::size_t GetColumn() const noexcept
+	{
+		return _column;
+	}
+
+	/// @brief Gets the name closest to an unknown flag or subcommand, or the
+	/// first flag an ambiguous flag matches.
+	/// @returns The name, or null if there is none.
+	const char *GetSuggestion() const noexcept
+	{
+		return _suggestion;
+	}
+
+#ifndef CLI_NO_EXCEPTIONS
+	/// @brief Gets the exception thrown while parsing a value, if any.
+	std::exception_ptr GetCause() const noexcept
+	{
+		return _cause;
+	}
+#endif
+
+	/// @brief Builds a human readable description of the failure.
+	/// @details Failures in a config file start with its path, line and
+	/// column, as in "app.ini:3:11: ".
+	/// @returns The message, empty if the run succeeded.
+	std::string GetMessage() const
+	{
+		if(_file != nullptr && _line != 0)
+		{
+			return std::string(_file) + ':' + std::to_string(_line) + ':'
+			    + std::to_string(_column) + ": " + GetDescription();
+		}
+		return GetDescription();
+	}
+
+private:
+	friend class CommandLine;
+	friend class Subcommands;
+
+	std::string GetDescription() const
+	{
+		switch(_code)
+		{
+			case ErrorCode::NONE:
+				return std::string();
+
+			case ErrorCode::INVALID_CALL:
+				return _detail;
+
+			case ErrorCode::UNKNOWN_FLAG:
+				return "Invalid command line arguments.  Unknown flag: "
+				    + std::string(_argument) + GetDidYouMean();
+
+			case ErrorCode::AMBIGUOUS_FLAG:
+				return "Invalid command line arguments.  Ambiguous flag: "
+				    + std::string(_argument)
+				    + " matches more than one flag, including "
+				    + std::string(_suggestion) + " and "
+				    + std::string(_alternative) + '.';
+
+			case ErrorCode::UNEXPECTED_VALUE:
+				return "Invalid command line arguments.  "
+				    + std::string(_argument)
+				    + " does not take a value: " + std::string(_token);
+
+			case ErrorCode::TOO_MANY_VALUES:
+				return "Invalid command line arguments.  " + std::string(_token)
+				    + " given more than the maximum of "
+				    + std::to_string(_limit) + " time(s).";
+
+			case ErrorCode::MISSING_VALUE:
+				return "Invalid command line arguments: Excepted value after "
+				    + std::string(_argument);
+
+			case ErrorCode::UNHANDLED_ARGUMENT:
+				return "Invalid command line arguments.  Unhandled argument: "
+				    + std::string(_argument);
+
+			case ErrorCode::TOO_FEW_VALUES:
+				return "Invalid command line arguments.  "
+				    + std::string(_argument) + " given "
+				    + std::to_string(_count)
+				    + " value(s), less than the minimum of "
+				    + std::to_string(_limit) + " value(s).";
+
+			case ErrorCode::INVALID_RESPONSE_FILE:
+				return "Invalid command line arguments.  "
+				    + std::string(_detail) + std::string(_argument);
+
+			case ErrorCode::INVALID_CONFIG_FILE:
+				return "Invalid config file.  " + std::string(_detail)
+				    + (_argument != nullptr ? _argument : "");
+
+			case ErrorCode::UNKNOWN_COMMAND:
+				return "Invalid command line arguments.  Unknown command: "
+				    + std::string(_argument) + GetDidYouMean();
+
+			case ErrorCode::MISSING_COMMAND:
+				return "Invalid command line arguments.  Expected a command.";
+
+			case ErrorCode::INVALID_STREAM:
+			case ErrorCode::INVALID_COMMAND_STRING:
+				return "Invalid command line arguments.  "
+				    + std::string(_detail);
+
+			case ErrorCode::INVALID_VALUE:
+#ifdef CLI_NO_EXCEPTIONS
+				return _detail;
+#else
+				try
+				{
+					std::rethrow_exception(_cause);
+				}
+				catch(const std::exception &e)
+				{
+					return e.what();
+				}
+				catch(...)
+				{
+					return "Invalid value for " + std::string(_argument) + ": "
+					    + std::string(_token);
+				}
+#endif
+		}
+		return std::string();
+	}
+
+	std::string GetDidYouMean() const
+	{
+		if(_suggestion == nullptr)
+		{
+			return std::string();
+		}
+		return ".  Did you mean " + std::string(_suggestion) + '?';
+	}
+
+	static ParseResult Success(bool isExit) noexcept
+	{
+		ParseResult result;
+		result._isExit = isExit;
+		return result;
+	}
+
+	static ParseResult InvalidCall(const char *detail) noexcept
+	{
+		ParseResult result;
+		result._code = ErrorCode::INVALID_CALL;
+		result._detail = detail;
+		return result;
+	}
+
+	static ParseResult Failure(
+	    ErrorCode code,
+	    std::size_t index,
+	    const char *argument,
+	    const char *token) noexcept
+	{
+		ParseResult result;
+		result._code = code;
+		result._index = index;
+		result._argument = argument;
+		result._token = token;
+		return result;
+	}
+
+	ErrorCode _code = ErrorCode::NONE;
+	bool _isExit = false;
+	std::size_t _index = npos;
+	const char *_argument = nullptr;
+	// the string in argv that caused the failure, if any
+	const char *_token = nullptr;
+	// for unknown names the closest known name, for ambiguous flags the first
+	// two flags that match
+	const char *_suggestion = nullptr;
+	const char *_alternative = nullptr;
+	// for arity failures the number of values given and the violated limit
+	std::size_t _count = 0;
+	std::size_t _limit = 0;
+	// the message of invalid calls, invalid response files, invalid streams
+	// and, without exceptions, invalid values
+	const char *_detail = "";
+	// for failures in a config file its path and the location in it
+	const char *_file = nullptr;
+	std::size_t _line = 0;
+	std::size_t _column = 0;
+#ifndef CLI_NO_EXCEPTIONS
+	std::exception_ptr _cause;
+#endif
+};
+
+
+} // namespace cli
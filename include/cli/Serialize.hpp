@@ -0,0 +1,739 @@
+/// @file
+/// @brief Contains cli::Serialize() and cli::Deserialize().
+#pragma once
+
+#include "cli/details/ArrayTraits.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+
+namespace cli
+{
+
+
+/// @brief Appends the binary form of values to a snapshot.
+/// @details Values are written in the native byte order with no padding, so
+/// a snapshot is only read back by the program that wrote it.
+class SnapshotWriter
+{
+public:
+	/// @brief Appends raw bytes.
+	void Write(const void *data, std::size_t size)
+	{
+		_data.append(static_cast<const char *>(data), size);
+	}
+
+	/// @brief Appends a size or count.
+	void WriteSize(std::size_t size)
+	{
+		const std::uint64_t value = size;
+		Write(&value, sizeof(value));
+	}
+
+	/// @brief Appends a string, which SnapshotReader::ReadString() gives back
+	/// null terminated.
+	void WriteString(std::string_view string)
+	{
+		WriteSize(string.size());
+		Write(string.data(), string.size());
+		_data.push_back('\0');
+	}
+
+	/// @brief Gets everything written.
+	const std::string &GetData() const noexcept
+	{
+		return _data;
+	}
+
+	/// @brief Removes everything written, keeping the storage.
+	void Clear() noexcept
+	{
+		_data.clear();
+	}
+
+private:
+	std::string _data;
+};
+
+
+/// @brief Reads values back from a snapshot written by SnapshotWriter.
+/// @details Every read checks that the snapshot holds enough bytes, a failed
+/// read returns false and leaves the reader at the end.
+class SnapshotReader
+{
+public:
+	SnapshotReader() = default;
+
+	/// @brief Constructs a reader of a range of bytes that must stay valid
+	/// while values read from it are used.
+	SnapshotReader(const char *begin, const char *end) noexcept
+	    : _next(begin)
+	    , _end(end)
+	{}
+
+	/// @brief Reads raw bytes.
+	bool Read(void *data, std::size_t size) noexcept
+	{
+		if(size > GetRemaining())
+		{
+			_next = _end;
+			return false;
+		}
+		std::memcpy(data, _next, size);
+		_next += size;
+		return true;
+	}
+
+	/// @brief Reads a size or count written by SnapshotWriter::WriteSize().
+	/// @details Fails on sizes larger than the rest of the snapshot, so
+	/// reserving storage for that many elements is safe.
+	bool ReadSize(std::size_t &size) noexcept
+	{
+		std::uint64_t value;
+		if(!Read(&value, sizeof(value)) || value > GetRemaining())
+		{
+			_next = _end;
+			return false;
+		}
+		size = static_cast<std::size_t>(value);
+		return true;
+	}
+
+	/// @brief Reads a string written by SnapshotWriter::WriteString().
+	/// @param[out] string Views the string in the snapshot, it is followed
+	/// by a null character.
+	bool ReadString(std::string_view &string) noexcept
+	{
+		std::size_t size;
+		if(!ReadSize(size) || size == GetRemaining() || _next[size] != '\0')
+		{
+			_next = _end;
+			return false;
+		}
+		string = std::string_view(_next, size);
+		_next += size + 1;
+		return true;
+	}
+
+	/// @brief Gets the number of bytes not yet read.
+	std::size_t GetRemaining() const noexcept
+	{
+		return static_cast<std::size_t>(_end - _next);
+	}
+
+private:
+	const char *_next = nullptr;
+	const char *_end = nullptr;
+};
+
+
+namespace details
+{
+
+
+/// @brief Detector for user defined serialization functions.
+/// @details User defined functions have the highest priority.  Both
+/// "void CLISerialize(const T &, cli::SnapshotWriter &)" and
+/// "bool CLIDeserialize(T &, cli::SnapshotReader &)" must be found, the
+/// latter returning false if the snapshot does not hold a valid value.
+template <typename T> struct HasUserDefinedSerialize
+{
+private:
+	template <typename U>
+	static constexpr decltype(
+	    CLISerialize(
+	        std::declval<const U &>(), std::declval<SnapshotWriter &>()),
+	    CLIDeserialize(std::declval<U &>(), std::declval<SnapshotReader &>()),
+	    bool())
+	Test(int)
+	{
+		return true;
+	}
+
+	template <typename U> static constexpr bool Test(...)
+	{
+		return false;
+	}
+
+public:
+	static constexpr bool value = Test<T>(int());
+};
+
+template <typename T>
+constexpr bool HasUserDefinedSerialize_v = HasUserDefinedSerialize<T>::value;
+
+
+/// @brief Detector for a user defined version of the format written by
+/// CLISerialize(), "unsigned CLISerializeVersion(const T *)".
+template <typename T> struct HasSerializeVersion
+{
+private:
+	template <typename U>
+	static constexpr decltype(
+	    CLISerializeVersion(std::declval<const U *>()), bool())
+	Test(int)
+	{
+		return true;
+	}
+
+	template <typename U> static constexpr bool Test(...)
+	{
+		return false;
+	}
+
+public:
+	static constexpr bool value = Test<T>(int());
+};
+
+
+/// @brief The kinds of values that fingerprints distinguish, see
+/// cli::GetSerializeFingerprint().
+enum class SerializedKind : std::uint64_t
+{
+	BOOL = 1,
+	SIGNED,
+	UNSIGNED,
+	FLOATING_POINT,
+	ENUM,
+	STRING,
+	C_STRING,
+	ARRAY,
+	OPTIONAL,
+	VECTOR,
+	SET,
+	PAIR,
+	USER_DEFINED
+};
+
+/// @brief Makes the fingerprint of a kind of value from its parts, such as
+/// its size or the fingerprints of its elements.
+inline std::uint64_t MakeFingerprint(
+    SerializedKind kind,
+    std::initializer_list<std::uint64_t> parts) noexcept
+{
+	constexpr std::uint64_t prime = 0x100000001b3;
+	std::uint64_t hash = static_cast<std::uint64_t>(kind) * prime;
+	for(const std::uint64_t part : parts)
+	{
+		hash = (hash ^ part) * prime;
+		hash ^= hash >> 32;
+	}
+	return hash;
+}
+
+
+/// @brief Serializes the types cli knows of.
+/// @details Specialized for numbers, enums, strings, and the containers that
+/// cli::Parse() supports, as long as their elements are serializable.
+/// cli::Lazy values are not serializable.
+template <typename T, typename = void> struct Serializer
+{
+	static constexpr bool isSerializable = false;
+};
+
+
+} // namespace details
+
+
+/// @brief Gets if values of a type can be written to a snapshot.
+template <typename T>
+constexpr bool IsSerializable_v = details::HasUserDefinedSerialize_v<T>
+    || details::Serializer<T>::isSerializable;
+
+
+/// @brief Appends a value to a snapshot.
+/// @details Uses CLISerialize() if it exists for T.
+template <typename T> void Serialize(const T &value, SnapshotWriter &writer)
+{
+	static_assert(
+	    IsSerializable_v<T>,
+	    "cli does not know how to serialize this type.  Implement both "
+	    "'void CLISerialize(const T &value, cli::SnapshotWriter &writer)' and "
+	    "'bool CLIDeserialize(T &value, cli::SnapshotReader &reader)' in the "
+	    "namespace of the type T.");
+	if constexpr(details::HasUserDefinedSerialize_v<T>)
+	{
+		CLISerialize(value, writer);
+	}
+	else
+	{
+		details::Serializer<T>::Serialize(value, writer);
+	}
+}
+
+
+/// @brief Gets a fingerprint of the format that cli::Serialize() writes
+/// values of a type in.
+/// @details Snapshots are only read by arguments of the same fingerprint.
+/// It is built from the kind and size of numbers and the structure of
+/// strings and containers.  A user defined type is known only by its size
+/// and a version, which is zero unless
+/// "unsigned CLISerializeVersion(const T *)" is found next to CLISerialize().
+/// Return a new version whenever the format CLISerialize() writes changes,
+/// the pointer it is given is always null.
+template <typename T> std::uint64_t GetSerializeFingerprint()
+{
+	static_assert(
+	    IsSerializable_v<T>, "cli does not know how to serialize this type.");
+	if constexpr(details::HasUserDefinedSerialize_v<T>)
+	{
+		std::uint64_t version = 0;
+		if constexpr(details::HasSerializeVersion<T>::value)
+		{
+			version = CLISerializeVersion(static_cast<const T *>(nullptr));
+		}
+		return details::MakeFingerprint(
+		    details::SerializedKind::USER_DEFINED, {sizeof(T), version});
+	}
+	else
+	{
+		return details::Serializer<T>::GetFingerprint();
+	}
+}
+
+
+/// @brief Reads a value written by cli::Serialize() back from a snapshot.
+/// @details Strings viewed by std::string_view and const char * values point
+/// into the snapshot.
+/// @returns False if the snapshot does not hold a valid value, the value may
+/// then be partially read.
+template <typename T> bool Deserialize(T &value, SnapshotReader &reader)
+{
+	static_assert(
+	    IsSerializable_v<T>, "cli does not know how to deserialize this type.");
+	if constexpr(details::HasUserDefinedSerialize_v<T>)
+	{
+		return CLIDeserialize(value, reader);
+	}
+	else
+	{
+		return details::Serializer<T>::Deserialize(value, reader);
+	}
+}
+
+
+namespace details
+{
+
+
+template <typename T>
+struct Serializer<
+    T,
+    std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>>
+{
+	static constexpr bool isSerializable = true;
+
+	static std::uint64_t GetFingerprint() noexcept
+	{
+		SerializedKind kind = SerializedKind::UNSIGNED;
+		if constexpr(std::is_same_v<T, bool>)
+		{
+			kind = SerializedKind::BOOL;
+		}
+		else if constexpr(std::is_enum_v<T>)
+		{
+			kind = SerializedKind::ENUM;
+		}
+		else if constexpr(std::is_floating_point_v<T>)
+		{
+			kind = SerializedKind::FLOATING_POINT;
+		}
+		else if constexpr(std::is_signed_v<T>)
+		{
+			kind = SerializedKind::SIGNED;
+		}
+		return MakeFingerprint(kind, {sizeof(T)});
+	}
+
+	static void Serialize(const T &value, SnapshotWriter &writer)
+	{
+		writer.Write(&value, sizeof(value));
+	}
+
+	static bool Deserialize(T &value, SnapshotReader &reader)
+	{
+		if constexpr(std::is_same_v<T, bool>)
+		{
+			// only zero and one are valid representations of a bool
+			unsigned char byte;
+			if(!reader.Read(&byte, 1) || byte > 1)
+			{
+				return false;
+			}
+			value = byte != 0;
+			return true;
+		}
+		else
+		{
+			return reader.Read(&value, sizeof(value));
+		}
+	}
+};
+
+template <typename Allocator>
+struct Serializer<std::basic_string<char, std::char_traits<char>, Allocator>>
+{
+	using String = std::basic_string<char, std::char_traits<char>, Allocator>;
+
+	static constexpr bool isSerializable = true;
+
+	static std::uint64_t GetFingerprint() noexcept
+	{
+		return MakeFingerprint(SerializedKind::STRING, {});
+	}
+
+	static void Serialize(const String &value, SnapshotWriter &writer)
+	{
+		writer.WriteString(value);
+	}
+
+	static bool Deserialize(String &value, SnapshotReader &reader)
+	{
+		std::string_view view;
+		if(!reader.ReadString(view))
+		{
+			return false;
+		}
+		value.assign(view.data(), view.size());
+		return true;
+	}
+};
+
+template <> struct Serializer<std::string_view>
+{
+	static constexpr bool isSerializable = true;
+
+	// strings and views are written the same way
+	static std::uint64_t GetFingerprint() noexcept
+	{
+		return MakeFingerprint(SerializedKind::STRING, {});
+	}
+
+	static void Serialize(std::string_view value, SnapshotWriter &writer)
+	{
+		writer.WriteString(value);
+	}
+
+	static bool Deserialize(std::string_view &value, SnapshotReader &reader)
+	{
+		return reader.ReadString(value);
+	}
+};
+
+template <> struct Serializer<const char *>
+{
+	static constexpr bool isSerializable = true;
+
+	static std::uint64_t GetFingerprint() noexcept
+	{
+		return MakeFingerprint(SerializedKind::C_STRING, {});
+	}
+
+	static void Serialize(const char *value, SnapshotWriter &writer)
+	{
+		const bool isNull = value == nullptr;
+		cli::Serialize(isNull, writer);
+		if(!isNull)
+		{
+			writer.WriteString(value);
+		}
+	}
+
+	static bool Deserialize(const char *&value, SnapshotReader &reader)
+	{
+		bool isNull;
+		if(!cli::Deserialize(isNull, reader))
+		{
+			return false;
+		}
+		std::string_view view;
+		if(isNull || !reader.ReadString(view))
+		{
+			value = nullptr;
+			return isNull;
+		}
+		value = view.data();
+		return true;
+	}
+};
+
+template <typename T> struct Serializer<T, std::enable_if_t<IsArray_v<T>>>
+{
+	static constexpr bool isSerializable = IsSerializable_v<ArrayValue_t<T>>;
+
+	static std::uint64_t GetFingerprint()
+	{
+		return MakeFingerprint(
+		    SerializedKind::ARRAY,
+		    {ArraySize_v<T>, GetSerializeFingerprint<ArrayValue_t<T>>()});
+	}
+
+	static void Serialize(const T &value, SnapshotWriter &writer)
+	{
+		for(const ArrayValue_t<T> &element : value)
+		{
+			cli::Serialize(element, writer);
+		}
+	}
+
+	static bool Deserialize(T &value, SnapshotReader &reader)
+	{
+		for(ArrayValue_t<T> &element : value)
+		{
+			if(!cli::Deserialize(element, reader))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+template <typename T> struct Serializer<std::optional<T>>
+{
+	static constexpr bool isSerializable = IsSerializable_v<T>;
+
+	static std::uint64_t GetFingerprint()
+	{
+		return MakeFingerprint(
+		    SerializedKind::OPTIONAL, {GetSerializeFingerprint<T>()});
+	}
+
+	static void Serialize(const std::optional<T> &value, SnapshotWriter &writer)
+	{
+		cli::Serialize(value.has_value(), writer);
+		if(value.has_value())
+		{
+			cli::Serialize(*value, writer);
+		}
+	}
+
+	static bool Deserialize(std::optional<T> &value, SnapshotReader &reader)
+	{
+		bool hasValue;
+		if(!cli::Deserialize(hasValue, reader))
+		{
+			return false;
+		}
+		if(!hasValue)
+		{
+			value.reset();
+			return true;
+		}
+		return cli::Deserialize(value.emplace(), reader);
+	}
+};
+
+template <typename T, typename Allocator>
+struct Serializer<std::vector<T, Allocator>>
+{
+	static constexpr bool isSerializable = IsSerializable_v<T>;
+
+	static std::uint64_t GetFingerprint()
+	{
+		return MakeFingerprint(
+		    SerializedKind::VECTOR, {GetSerializeFingerprint<T>()});
+	}
+
+	static void
+	Serialize(const std::vector<T, Allocator> &value, SnapshotWriter &writer)
+	{
+		writer.WriteSize(value.size());
+		if constexpr(isBulk)
+		{
+			writer.Write(value.data(), value.size() * sizeof(T));
+		}
+		else
+		{
+			for(const T &element : value)
+			{
+				cli::Serialize(element, writer);
+			}
+		}
+	}
+
+	static bool
+	Deserialize(std::vector<T, Allocator> &value, SnapshotReader &reader)
+	{
+		std::size_t size;
+		if(!reader.ReadSize(size))
+		{
+			return false;
+		}
+		value.clear();
+		if constexpr(isBulk)
+		{
+			value.resize(size);
+			return reader.Read(value.data(), size * sizeof(T));
+		}
+		else if constexpr(std::is_same_v<T, bool>)
+		{
+			// std::vector<bool> has no references to its elements
+			value.reserve(size);
+			for(std::size_t i = 0; i < size; ++i)
+			{
+				bool element;
+				if(!cli::Deserialize(element, reader))
+				{
+					return false;
+				}
+				value.push_back(element);
+			}
+			return true;
+		}
+		else
+		{
+			value.reserve(size);
+			for(std::size_t i = 0; i < size; ++i)
+			{
+				if(!cli::Deserialize(value.emplace_back(), reader))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+
+private:
+	// numbers are copied all at once
+	static constexpr bool isBulk =
+	    (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+	    && !std::is_same_v<T, bool> && !HasUserDefinedSerialize_v<T>;
+};
+
+// serializes sets and maps, whose elements are inserted after being read
+template <typename Container, typename Element> struct SerializeInserted
+{
+	static constexpr bool isSerializable = IsSerializable_v<Element>;
+
+	// maps are sets of pairs
+	static std::uint64_t GetFingerprint()
+	{
+		return MakeFingerprint(
+		    SerializedKind::SET, {GetSerializeFingerprint<Element>()});
+	}
+
+	static void Serialize(const Container &value, SnapshotWriter &writer)
+	{
+		writer.WriteSize(value.size());
+		for(const auto &element : value)
+		{
+			SerializeElement(element, writer);
+		}
+	}
+
+	static bool Deserialize(Container &value, SnapshotReader &reader)
+	{
+		std::size_t size;
+		if(!reader.ReadSize(size))
+		{
+			return false;
+		}
+		value.clear();
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			Element element{};
+			if(!cli::Deserialize(element, reader))
+			{
+				return false;
+			}
+			value.insert(std::move(element));
+		}
+		return true;
+	}
+
+private:
+	template <typename T>
+	static void SerializeElement(const T &element, SnapshotWriter &writer)
+	{
+		cli::Serialize(element, writer);
+	}
+
+	// the entries of maps have const keys
+	template <typename Key, typename T>
+	static void
+	SerializeElement(const std::pair<Key, T> &element, SnapshotWriter &writer)
+	{
+		cli::Serialize(element.first, writer);
+		cli::Serialize(element.second, writer);
+	}
+};
+
+template <typename First, typename Second>
+struct Serializer<std::pair<First, Second>>
+{
+	static constexpr bool isSerializable =
+	    IsSerializable_v<First> && IsSerializable_v<Second>;
+
+	static std::uint64_t GetFingerprint()
+	{
+		return MakeFingerprint(
+		    SerializedKind::PAIR,
+		    {GetSerializeFingerprint<First>(),
+		     GetSerializeFingerprint<Second>()});
+	}
+
+	static void
+	Serialize(const std::pair<First, Second> &value, SnapshotWriter &writer)
+	{
+		cli::Serialize(value.first, writer);
+		cli::Serialize(value.second, writer);
+	}
+
+	static bool
+	Deserialize(std::pair<First, Second> &value, SnapshotReader &reader)
+	{
+		return cli::Deserialize(value.first, reader)
+		    && cli::Deserialize(value.second, reader);
+	}
+};
+
+template <typename T, typename Compare, typename Allocator>
+struct Serializer<std::set<T, Compare, Allocator>>
+    : SerializeInserted<std::set<T, Compare, Allocator>, T>
+{};
+
+template <typename T, typename Hash, typename Equal, typename Allocator>
+struct Serializer<std::unordered_set<T, Hash, Equal, Allocator>>
+    : SerializeInserted<std::unordered_set<T, Hash, Equal, Allocator>, T>
+{};
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+struct Serializer<std::map<Key, T, Compare, Allocator>>
+    : SerializeInserted<
+          std::map<Key, T, Compare, Allocator>,
+          std::pair<Key, T>>
+{};
+
+template <
+    typename Key,
+    typename T,
+    typename Hash,
+    typename Equal,
+    typename Allocator>
+struct Serializer<std::unordered_map<Key, T, Hash, Equal, Allocator>>
+    : SerializeInserted<
+          std::unordered_map<Key, T, Hash, Equal, Allocator>,
+          std::pair<Key, T>>
+{};
+
+
+} // namespace details
+
+
+} // namespace cli
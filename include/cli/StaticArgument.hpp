@@ -0,0 +1,290 @@
+/// @file
+/// @brief Contains the arguments used by cli::StaticCommandLine.
+#pragma once
+
+#include "cli/Arity.hpp"
+#include "cli/ErrorHandler.hpp"
+#include "cli/GenericArgument.hpp"
+#include "cli/Keywords.hpp"
+#include "cli/Parse.hpp"
+#include "cli/details/ArrayTraits.hpp"
+#include "cli/details/Destination.hpp"
+#include "cli/details/GetDefaultArity.hpp"
+#include "cli/details/Lazy_fwd.hpp"
+
+#include "keyword.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief A normal argument whose name is known at compile time.
+/// @details Values are stored directly into the typed destination.
+template <const char *Name, typename T> class StaticNormalArgument
+{
+public:
+	static constexpr const char *name = Name;
+	static constexpr GenericArgument::Kind kind =
+	    GenericArgument::Kind::NORMAL;
+
+	StaticNormalArgument(T &destination, Arity arity, const char *help)
+	    : _destination(&destination)
+	    , _arity(arity)
+	    , _help(help)
+	{}
+
+	Arity GetArity() const noexcept
+	{
+		return _arity;
+	}
+
+	/// @brief Stores a value.
+	/// @param value The value to parse.
+	/// @param index The number of values previously stored.
+	/// @returns True on success, see cli::Parse().
+	bool Store(const char *value, std::size_t index) const
+	{
+		if constexpr(IsLazy_v<T>)
+		{
+			return _destination->Capture(value, index);
+		}
+		else if constexpr(IsArray_v<T>)
+		{
+			if constexpr(std::is_same_v<ArrayValue_t<T>, char>)
+			{
+				// arrays of char are treated like a bounded string
+				return cli::Parse(*_destination, value);
+			}
+			else
+			{
+				// arrays of non-chars are treated like a bounded vector
+				if(index >= ArraySize_v<T>)
+				{
+					// arity checks should have prevented this
+					Throw<std::runtime_error>(
+					    "Internal error: cli::details::StaticNormalArgument "
+					    "wrapping an array given too many arguments.");
+				}
+				return cli::Parse(
+				    ArrayGetData_v<T>(*_destination)[index], value);
+			}
+		}
+		else
+		{
+			return cli::Parse(*_destination, value);
+		}
+	}
+
+	/// @brief Gets an equivalent argument for generating help messages.
+	GenericArgument ToGeneric() const
+	{
+		return GenericArgument(
+		    kind, Name, Destination(*_destination), _arity, _help);
+	}
+
+private:
+	T *_destination;
+	Arity _arity;
+	const char *_help;
+};
+
+
+/// @brief A boolean flag whose name is known at compile time.
+template <const char *Name> class StaticBoolArgument
+{
+public:
+	static constexpr const char *name = Name;
+	static constexpr GenericArgument::Kind kind = GenericArgument::Kind::BOOL;
+
+	StaticBoolArgument(bool &destination, bool active, const char *help)
+	    : _destination(&destination)
+	    , _active(active)
+	    , _help(help)
+	{}
+
+	Arity GetArity() const noexcept
+	{
+		return Arity::Optional();
+	}
+
+	/// @brief Sets the flag to its active value.
+	void Activate() const noexcept
+	{
+		*_destination = _active;
+	}
+
+	/// @brief Gets an equivalent argument for generating help messages.
+	GenericArgument ToGeneric() const
+	{
+		return GenericArgument(
+		    kind, Name, Destination(*_destination), _active, _help);
+	}
+
+private:
+	bool *_destination;
+	bool _active;
+	const char *_help;
+};
+
+
+/// @brief A help, usage, or version flag whose name is known at compile time.
+template <const char *Name, GenericArgument::Kind Kind> class StaticInfoArgument
+{
+public:
+	static constexpr const char *name = Name;
+	static constexpr GenericArgument::Kind kind = Kind;
+
+	StaticInfoArgument(const char *version, const char *help)
+	    : _version(version)
+	    , _help(help)
+	{}
+
+	Arity GetArity() const noexcept
+	{
+		return Arity::Optional();
+	}
+
+	const char *GetVersion() const noexcept
+	{
+		return _version;
+	}
+
+	/// @brief Gets an equivalent argument for generating help messages.
+	GenericArgument ToGeneric() const
+	{
+		if constexpr(Kind == GenericArgument::Kind::VERSION)
+		{
+			return GenericArgument(Kind, Name, _version, _help);
+		}
+		else
+		{
+			return GenericArgument(Kind, Name, _help);
+		}
+	}
+
+private:
+	const char *_version;
+	const char *_help;
+};
+
+
+} // namespace details
+
+
+/// @brief Creates a command line argument for a cli::StaticCommandLine.
+/// @details The name must be a constant with static storage duration, for
+/// example "static constexpr char count[] = "--count";".
+/// @tparam Name The name of this argument.  Follows the same rules as
+/// cli::Argument().
+/// @tparam T The output type of this argument.
+/// @tparam Keywords Keyword argument types.
+/// @param destination The destination of this argument.
+/// @param keywords Keyword arguments.  Suports cli::help and cli::arity.
+/// @returns The created argument.
+template <const char *Name, typename T, typename... Keywords>
+details::StaticNormalArgument<Name, T>
+StaticArgument(T &destination, Keywords... keywords)
+{
+	keyword::Arguments kwargs{keyword::Names{help, arity}, keywords...};
+	return details::StaticNormalArgument<Name, T>(
+	    destination,
+	    kwargs.GetOrDefault(arity, details::GetDefaultArity(destination)),
+	    kwargs.GetOrDefault(help, ""));
+}
+
+
+/// @brief Creates a boolean flag for a cli::StaticCommandLine with an inactive
+/// value of false and an active value of true.
+/// @tparam Name The name of this argument.  Must have at least one leading
+/// dash.
+/// @tparam Keywords Keyword argument types.
+/// @param destination The boolean destination of this flag.
+/// @param keywords Keyword arguments.  Supports cli::help.
+/// @returns The created argument.
+template <const char *Name, typename... Keywords>
+details::StaticBoolArgument<Name>
+StaticStoreTrue(bool &destination, Keywords... keywords)
+{
+	destination = false;
+	keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+	return details::StaticBoolArgument<Name>(
+	    destination, true, kwargs.GetOrDefault(help, ""));
+}
+
+
+/// @brief Creates a boolean flag for a cli::StaticCommandLine with an inactive
+/// value of true and an active value of false.
+/// @tparam Name The name of this argument.  Must have at least one leading
+/// dash.
+/// @tparam Keywords Keyword argument types.
+/// @param destination The boolean destination of this flag.
+/// @param keywords Keyword arguments.  Supports cli::help.
+/// @returns The created argument.
+template <const char *Name, typename... Keywords>
+details::StaticBoolArgument<Name>
+StaticStoreFalse(bool &destination, Keywords... keywords)
+{
+	destination = true;
+	keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+	return details::StaticBoolArgument<Name>(
+	    destination, false, kwargs.GetOrDefault(help, ""));
+}
+
+
+/// @brief Creates a help flag for a cli::StaticCommandLine.
+/// @tparam Name The flag that will trigger the help message.  Must start with a
+/// dash.
+/// @tparam Keywords Keyword argument types.
+/// @param keywords Keyword arguments.  Supports cli::help.
+/// @returns The created argument.
+template <const char *Name, typename... Keywords>
+details::StaticInfoArgument<Name, GenericArgument::Kind::HELP>
+StaticHelp(Keywords... keywords)
+{
+	keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+	return {
+	    "", kwargs.GetOrDefault(help, "prints this help message and exits")};
+}
+
+
+/// @brief Creates a usage flag for a cli::StaticCommandLine.
+/// @tparam Name The flag that will trigger the usage message.  Must start with
+/// a dash.
+/// @tparam Keywords Keyword argument types.
+/// @param keywords Keyword arguments.  Supports cli::help.
+/// @returns The created argument.
+template <const char *Name, typename... Keywords>
+details::StaticInfoArgument<Name, GenericArgument::Kind::USAGE>
+StaticUsage(Keywords... keywords)
+{
+	keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+	return {"", kwargs.GetOrDefault(help, "prints usage and exits")};
+}
+
+
+/// @brief Creates a version flag for a cli::StaticCommandLine.
+/// @tparam Name The flag that will trigger the version message.  Must start
+/// with a dash.
+/// @tparam Keywords Keyword argument types.
+/// @param version The version string to print when requested.
+/// @param keywords Keyword arguments.  Supports cli::help.
+/// @returns The created argument.
+template <const char *Name, typename... Keywords>
+details::StaticInfoArgument<Name, GenericArgument::Kind::VERSION>
+StaticVersion(const char *version, Keywords... keywords)
+{
+	keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+	return {version, kwargs.GetOrDefault(help, "prints version and exits")};
+}
+
+
+} // namespace cli
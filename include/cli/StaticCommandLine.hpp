@@ -0,0 +1,357 @@
+/// @file
+/// @brief Contains cli::StaticCommandLine.
+#pragma once
+
+#include "cli/ErrorHandler.hpp"
+#include "cli/GenericArgument.hpp"
+#include "cli/StaticArgument.hpp"
+#include "cli/details/FlagTable.hpp"
+#include "cli/details/Generator.hpp"
+#include "cli/details/PerfectHash.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+
+namespace cli
+{
+
+
+/// @brief A command line whose argument names and types are known at compile
+/// time.
+/// @details Flags are matched with a perfect hash built at compile time and
+/// each value is parsed with a direct call into its typed destination.  A
+/// successful Run() does not allocate unless parsing a destination does.
+/// Behaves like cli::CommandLine otherwise.
+/// @tparam Arguments Argument types created by cli::StaticArgument(),
+/// cli::StaticStoreTrue() and similar functions.
+template <typename... Arguments> class StaticCommandLine
+{
+private:
+	static constexpr std::size_t count = sizeof...(Arguments);
+
+	static constexpr bool IsOption(const char *name) noexcept
+	{
+		return name[0] == '-';
+	}
+
+	// option names by argument index, positionals have an empty name
+	static constexpr std::array<std::string_view, count> GetOptionNames()
+	{
+		return {{IsOption(Arguments::name) ? std::string_view(Arguments::name)
+		                                   : std::string_view()...}};
+	}
+
+	static constexpr bool HasUniqueNames()
+	{
+		constexpr std::array<std::string_view, count> names{
+		    {std::string_view(Arguments::name)...}};
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			for(std::size_t j = i + 1; j < count; ++j)
+			{
+				if(names[i] == names[j])
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	static constexpr std::size_t numPositionals =
+	    (std::size_t(0) + ... + (IsOption(Arguments::name) ? 0 : 1));
+
+	// argument indices of the positionals in declaration order
+	static constexpr std::array<std::size_t, numPositionals> GetPositionals()
+	{
+		constexpr std::array<bool, count> isOption{
+		    {IsOption(Arguments::name)...}};
+		std::array<std::size_t, numPositionals> positionals{};
+		std::size_t next = 0;
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			if(!isOption[i])
+			{
+				positionals[next++] = i;
+			}
+		}
+		return positionals;
+	}
+
+	static_assert(
+	    HasUniqueNames(),
+	    "cli::StaticCommandLine argument names must be unique.");
+
+	static_assert(
+	    ((Arguments::kind == GenericArgument::Kind::NORMAL
+	      || IsOption(Arguments::name))
+	     && ...),
+	    "Only normal arguments can be positional arguments.");
+
+	static constexpr std::array<std::string_view, count> _names =
+	    GetOptionNames();
+	static constexpr details::PerfectHash<count> _lookup{_names};
+	static constexpr std::array<std::size_t, numPositionals> _positionals =
+	    GetPositionals();
+
+	static_assert(
+	    _lookup.IsValid(),
+	    "Failed to build a perfect hash for the cli::StaticCommandLine "
+	    "argument names.");
+
+public:
+	StaticCommandLine(const char *description, Arguments... arguments)
+	    : _description(description)
+	    , _arguments(arguments...)
+	{}
+
+	std::string GetUsage(const char *name) const
+	{
+		std::string usage = name;
+		ForEach([&](const auto &argument, auto) {
+			usage += ' ';
+			usage += argument.ToGeneric().GetUsage();
+		});
+		return usage;
+	}
+
+	/// @brief Gets a help message for this command line.
+	std::string GetHelp(const char *name) const
+	{
+		std::string help = _description;
+		help += "\n\n";
+
+		help += "Usage: \n  " + GetUsage(name);
+		help += "\n\n";
+
+		help += "Arguments: \n";
+		ForEach([&](const auto &argument, auto) {
+			help += "  ";
+			help += argument.ToGeneric().GetHelp();
+			help += '\n';
+		});
+		return help;
+	}
+
+	bool Run(const char *name, int argc, const char *const *argv) const
+	{
+		if(argc < 0)
+		{
+			details::Throw<std::invalid_argument>(
+			    "Invalid argument to cli::StaticCommandLine::Run(name, argc, "
+			    "argv).  argc must be non-negative");
+		}
+		if(argv == nullptr)
+		{
+			details::Throw<std::invalid_argument>(
+			    "Invalid argument to cli::StaticCommandLine::Run(name, argc, "
+			    "argv).  argv must not be null.");
+		}
+
+		std::array<std::size_t, count> counts{};
+		std::size_t positional = 0;
+		details::Generator generator(argv, argv + argc);
+
+		while(!generator.IsEmpty())
+		{
+			const char *const arg = generator.Peek();
+			if(arg == nullptr)
+			{
+				details::Throw<std::invalid_argument>(
+				    "Invalid argument to cli::StaticCommandLine::Run(name, "
+				    "argc, argv).  Null pointer as string in argv.");
+			}
+
+			if(arg[0] == '-')
+			{
+				// this argument is a flag
+				const std::string_view flag(arg);
+				const std::size_t index =
+				    _lookup.Find(details::FlagTable::Hash(flag));
+				if(index == details::FlagTable::npos || _names[index] != flag)
+				{
+					details::Throw<std::invalid_argument>(
+					    "Invalid command line arguments.  Unknown flag: "
+					    + std::string(arg));
+				}
+				bool exit = false;
+				VisitAt(index, [&](const auto &argument, auto i) {
+					exit = HandleFlag(argument, counts[i], name, generator);
+				});
+				if(exit)
+				{
+					return true;
+				}
+			}
+			else
+			{
+				// this argument is a positional
+				if(positional == numPositionals)
+				{
+					details::Throw<std::invalid_argument>(
+					    "Invalid command line arguments.  Unhandled "
+					    "argument: "
+					    + std::string(arg));
+				}
+				const std::size_t index = _positionals[positional];
+				VisitAt(index, [&](const auto &argument, auto i) {
+					HandleValue(argument, counts[i], generator);
+					if(counts[i] == argument.GetArity().inclusiveMax)
+					{
+						++positional;
+					}
+				});
+			}
+		}
+
+		ForEach([&](const auto &argument, auto i) {
+			if(counts[i] < argument.GetArity().inclusiveMin)
+			{
+				details::Throw<std::invalid_argument>(
+				    "Invalid command line arguments.  "
+				    + std::string(argument.name) + " given "
+				    + std::to_string(counts[i])
+				    + " value(s), less than the minimum of "
+				    + std::to_string(argument.GetArity().inclusiveMin)
+				    + " value(s).");
+			}
+		});
+		return false;
+	}
+
+	bool Run(int argc, const char *const *argv) const
+	{
+		if(argc < 1)
+		{
+			details::Throw<std::invalid_argument>(
+			    "Invalid argument to cli::StaticCommandLine::Run(argc, argv).  "
+			    "argc must be at least one.");
+		}
+		if(argv == nullptr)
+		{
+			details::Throw<std::invalid_argument>(
+			    "Invalid argument to cli::StaticCommandLine::Run(argc, argv).  "
+			    "argv can not be NULL.");
+		}
+		return Run(*argv, argc - 1, argv + 1);
+	}
+
+private:
+	template <std::size_t I>
+	using Index = std::integral_constant<std::size_t, I>;
+
+	// calls function(argument, Index<I>) for every argument
+	template <typename Function> void ForEach(Function &&function) const
+	{
+		ForEachImpl(function, std::index_sequence_for<Arguments...>());
+	}
+
+	template <typename Function, std::size_t... Is>
+	void ForEachImpl(Function &function, std::index_sequence<Is...>) const
+	{
+		(function(std::get<Is>(_arguments), Index<Is>()), ...);
+	}
+
+	// calls function(argument, Index<I>) for the argument at a runtime index
+	template <typename Function>
+	void VisitAt(std::size_t index, Function &&function) const
+	{
+		VisitAtImpl(index, function, std::index_sequence_for<Arguments...>());
+	}
+
+	template <typename Function, std::size_t... Is>
+	void VisitAtImpl(
+	    std::size_t index,
+	    Function &function,
+	    std::index_sequence<Is...>) const
+	{
+		(void)((index == Is
+		        && (function(std::get<Is>(_arguments), Index<Is>()), true))
+		       || ...);
+	}
+
+	// handles a flag at the front of the generator, returns true if parsing
+	// must stop
+	template <typename Argument>
+	bool HandleFlag(
+	    const Argument &argument,
+	    std::size_t &argCount,
+	    const char *name,
+	    details::Generator &generator) const
+	{
+		if(argCount == argument.GetArity().inclusiveMax)
+		{
+			details::Throw<std::invalid_argument>(
+			    "Invalid command line arguments.  "
+			    + std::string(generator.Peek())
+			    + " given more than the maximum of "
+			    + std::to_string(argument.GetArity().inclusiveMax)
+			    + " time(s).");
+		}
+		// handle special flags that trigger parser exit
+		if constexpr(Argument::kind == GenericArgument::Kind::HELP)
+		{
+			std::cout << GetHelp(name);
+			return true;
+		}
+		else if constexpr(Argument::kind == GenericArgument::Kind::USAGE)
+		{
+			std::cout << GetUsage(name);
+			return true;
+		}
+		else if constexpr(Argument::kind == GenericArgument::Kind::VERSION)
+		{
+			std::cout << argument.GetVersion() << '\n';
+			return true;
+		}
+		else
+		{
+			// progress passed the flag
+			generator.Next();
+			// and handle any value
+			HandleValue(argument, argCount, generator);
+			return false;
+		}
+	}
+
+	// handles the value of an argument, if any
+	template <typename Argument>
+	static void HandleValue(
+	    const Argument &argument,
+	    std::size_t &argCount,
+	    details::Generator &generator)
+	{
+		if constexpr(Argument::kind == GenericArgument::Kind::BOOL)
+		{
+			argument.Activate();
+		}
+		else if constexpr(Argument::kind == GenericArgument::Kind::NORMAL)
+		{
+			if(generator.IsEmpty())
+			{
+				details::Throw<std::invalid_argument>(
+				    "Invalid command line arguments: Excepted value after "
+				    + std::string(argument.name));
+			}
+			if(!argument.Store(generator.Next(), argCount))
+			{
+				// only reached when exceptions are disabled
+				details::Throw<std::invalid_argument>(details::GetParseError());
+			}
+		}
+		argCount++;
+	}
+
+	const char *_description;
+	std::tuple<Arguments...> _arguments;
+};
+
+
+} // namespace cli
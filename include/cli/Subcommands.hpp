@@ -0,0 +1,396 @@
+/// @file
+/// @brief Contains cli::Subcommand and cli::Subcommands.
+#pragma once
+
+#include "cli/CommandLine.hpp"
+#include "cli/ErrorHandler.hpp"
+#include "cli/GenericArgument.hpp"
+#include "cli/Keywords.hpp"
+#include "cli/ParseResult.hpp"
+#include "cli/details/EditDistance.hpp"
+#include "cli/details/FlagTable.hpp"
+
+#include "keyword.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace cli
+{
+
+
+/// @brief A git style subcommand of a cli::Subcommands.
+/// @details The command line of a subcommand is built by a factory that is
+/// only called when the subcommand is run or its help is requested, so a
+/// program with many subcommands only builds the arguments of the one it
+/// runs.
+class Subcommand
+{
+public:
+	/// @brief Constructor.
+	/// @tparam Factory Callable taking no arguments and returning the
+	/// cli::CommandLine of the subcommand.
+	/// @tparam Keywords Keyword argument types.
+	/// @param name The name of the subcommand.  Must not start with a dash.
+	/// @param factory Builds the command line each time the subcommand is
+	/// run.  The destinations of that command line must outlive the run.
+	/// @param keywords Keyword arguments.  Supports cli::help.
+	template <typename Factory, typename... Keywords>
+	Subcommand(const char *name, Factory factory, Keywords... keywords)
+	    : _name(name)
+	    , _factory(std::move(factory))
+	{
+		keyword::Arguments kwargs{keyword::Names{help}, keywords...};
+		_help = kwargs.GetOrDefault(help, "");
+	}
+
+	const char *GetName() const noexcept
+	{
+		return _name;
+	}
+
+	/// @brief Gets a string to use in the help message of the cli::Subcommands
+	/// for this subcommand.
+	std::string GetHelp() const
+	{
+		return std::string(_name) + ": " + _help;
+	}
+
+	/// @brief Builds the command line of this subcommand.
+	CommandLine Make() const
+	{
+		return _factory();
+	}
+
+private:
+	const char *_name;
+	std::function<CommandLine()> _factory;
+	const char *_help;
+};
+
+
+/// @brief A program made of git style subcommands, each with its own
+/// command line.
+/// @details The first argument names the subcommand, the arguments after it
+/// are run by that subcommand's command line.  Subcommands are found with a
+/// hash table built once on construction, and only the chosen subcommand's
+/// command line is built.  Informational flags such as cli::Help() may be
+/// given in place of a subcommand.
+///
+/// A run keeps the chosen command line, so unlike cli::CommandLine a
+/// Subcommands is not safe to run from multiple threads at once.
+class Subcommands
+{
+public:
+	/// @brief Index returned by GetSelectedIndex() when no subcommand ran.
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	/// @brief Constructor.
+	/// @param description Description of the program used in help messages.
+	/// @param commands The subcommands.
+	/// @param flags Flags that may be given in place of a subcommand, which
+	/// must be created by cli::Help(), cli::Usage() or cli::Version().
+	Subcommands(
+	    const char *description,
+	    std::initializer_list<Subcommand> commands,
+	    std::initializer_list<GenericArgument> flags = {})
+	    : Subcommands(description, commands.begin(), commands.end(), flags)
+	{}
+
+	/// @brief Constructor from a range of subcommands.
+	/// @details Useful when the subcommands are only known at runtime.
+	template <typename Iterator>
+	Subcommands(
+	    const char *description,
+	    Iterator begin,
+	    Iterator end,
+	    std::initializer_list<GenericArgument> flags = {})
+	    : _description(description)
+	    , _commands(begin, end)
+	    , _flags(flags)
+	    , _table(_commands.size())
+	{
+		for(std::size_t i = 0; i < _commands.size(); ++i)
+		{
+			const char *const name = _commands[i].GetName();
+			if(name == nullptr || name[0] == '\0' || name[0] == '-')
+			{
+				details::Throw<std::invalid_argument>(
+				    "Invalid argument to cli::Subcommands::Subcommands().  "
+				    "Subcommand names must be non-empty and must not start "
+				    "with a dash.");
+			}
+			_table.Insert(name, i);
+		}
+		for(const GenericArgument &flag : _flags)
+		{
+			const GenericArgument::Kind kind = flag.GetKind();
+			if(kind != GenericArgument::Kind::HELP
+			   && kind != GenericArgument::Kind::USAGE
+			   && kind != GenericArgument::Kind::VERSION)
+			{
+				details::Throw<std::invalid_argument>(
+				    "Invalid argument to cli::Subcommands::Subcommands().  "
+				    "Only help, usage and version flags can be given in "
+				    "place of a subcommand.");
+			}
+		}
+	}
+
+	std::string GetUsage(const char *name) const
+	{
+		std::string usage = name;
+		for(const GenericArgument &flag : _flags)
+		{
+			usage += ' ';
+			usage += flag.GetUsage();
+		}
+		usage += " command [arguments]...";
+		return usage;
+	}
+
+	/// @brief Gets a help message listing the subcommands.
+	/// @details No subcommand's command line is built.
+	std::string GetHelp(const char *name) const
+	{
+		std::string help = _description;
+		help += "\n\n";
+
+		help += "Usage: \n  " + GetUsage(name);
+		help += "\n\n";
+
+		help += "Commands: \n";
+		for(const Subcommand &command : _commands)
+		{
+			help += "  ";
+			help += command.GetHelp();
+			help += '\n';
+		}
+		if(_flags.size() != 0)
+		{
+			help += "\nArguments: \n";
+			for(const GenericArgument &flag : _flags)
+			{
+				help += "  ";
+				help += flag.GetHelp();
+				help += '\n';
+			}
+		}
+		return help;
+	}
+
+	/// @brief Gets the help message of a single subcommand.
+	/// @details Builds only that subcommand's command line.
+	/// @returns The help message, empty if there is no such subcommand.
+	std::string GetHelp(const char *name, const char *command) const
+	{
+		const std::size_t index = _table.Find(command);
+		if(index == details::FlagTable::npos)
+		{
+			return std::string();
+		}
+		return _commands[index].Make().GetHelp(
+		    (std::string(name) + ' ' + command).c_str());
+	}
+
+	/// @brief Runs a subcommand without throwing on failure.
+	/// @details The first argument names the subcommand.  Its command line is
+	/// built and run with the remaining arguments and a program name of
+	/// "<name> <subcommand>".
+	/// @param name The name of the program, used in help and usage messages.
+	/// @param argc The number of arguments in argv.
+	/// @param argv The arguments, not including the program name.
+	/// @returns The result of the run.  Indices in it are indices into argv.
+	ParseResult TryRun(const char *name, int argc, const char *const *argv)
+	{
+		_selected = npos;
+		_commandLine.reset();
+		if(argc < 0)
+		{
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::Subcommands::Run(name, argc, "
+			    "argv).  argc must be non-negative");
+		}
+		if(argv == nullptr)
+		{
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::Subcommands::Run(name, argc, "
+			    "argv).  argv must not be null.");
+		}
+		if(argc == 0)
+		{
+			return ParseResult::Failure(
+			    ErrorCode::MISSING_COMMAND,
+			    ParseResult::npos,
+			    nullptr,
+			    nullptr);
+		}
+		const char *const command = argv[0];
+		if(command == nullptr)
+		{
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::Subcommands::Run(name, argc, "
+			    "argv).  Null pointer as string in argv.");
+		}
+		if(command[0] == '-')
+		{
+			return RunFlag(name, command);
+		}
+
+		const std::size_t index = _table.Find(command);
+		if(index == details::FlagTable::npos)
+		{
+			ParseResult result = ParseResult::Failure(
+			    ErrorCode::UNKNOWN_COMMAND, 0, command, command);
+			result._suggestion = FindClosestCommand(command);
+			return result;
+		}
+		_selected = index;
+		_name = name;
+		_name += ' ';
+		_name += command;
+		_commandLine.emplace(_commands[index].Make());
+		ParseResult result =
+		    _commandLine->TryRun(_name.c_str(), argc - 1, argv + 1);
+		if(result._index != ParseResult::npos)
+		{
+			result._index++;
+		}
+		return result;
+	}
+
+	/// @brief Runs a subcommand using the program name in argv without
+	/// throwing on failure.
+	/// @returns The result of the run.  Indices in it are indices into argv,
+	/// where the program name is index zero.
+	ParseResult TryRun(int argc, const char *const *argv)
+	{
+		if(argc < 1)
+		{
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::Subcommands::Run(argc, argv).  argc "
+			    "must be at least one.");
+		}
+		if(argv == nullptr)
+		{
+			return ParseResult::InvalidCall(
+			    "Invalid argument to cli::Subcommands::Run(argc, argv).  argv "
+			    "can not be NULL.");
+		}
+		ParseResult result = TryRun(*argv, argc - 1, argv + 1);
+		if(result._index != ParseResult::npos)
+		{
+			result._index++;
+		}
+		return result;
+	}
+
+	/// @brief Runs a subcommand.
+	/// @details Equivalent to TryRun() but failures are thrown, see
+	/// cli::CommandLine::Run().
+	/// @returns True if an informational flag such as help was given and the
+	/// program should exit.
+	bool Run(const char *name, int argc, const char *const *argv)
+	{
+		return CommandLine::ThrowOnFailure(TryRun(name, argc, argv));
+	}
+
+	/// @brief Runs a subcommand using the program name in argv.
+	bool Run(int argc, const char *const *argv)
+	{
+		return CommandLine::ThrowOnFailure(TryRun(argc, argv));
+	}
+
+	/// @brief Gets the name of the subcommand chosen by the last run.
+	/// @returns The name, or null if the last run did not choose one.
+	const char *GetSelected() const noexcept
+	{
+		return _selected == npos ? nullptr : _commands[_selected].GetName();
+	}
+
+	/// @brief Gets the index of the subcommand chosen by the last run, or
+	/// npos.
+	std::size_t GetSelectedIndex() const noexcept
+	{
+		return _selected;
+	}
+
+	/// @brief Gets the command line built for the subcommand chosen by the
+	/// last run, or null.
+	const CommandLine *GetCommandLine() const noexcept
+	{
+		return _commandLine ? &*_commandLine : nullptr;
+	}
+
+private:
+	// handles a flag given in place of a subcommand
+	ParseResult RunFlag(const char *name, const char *flag) const
+	{
+		for(const GenericArgument &candidate : _flags)
+		{
+			const bool isShort = candidate.GetShortName() != '\0'
+			    && flag[1] == candidate.GetShortName() && flag[2] == '\0';
+			if(!isShort && std::strcmp(candidate.GetName(), flag) != 0)
+			{
+				continue;
+			}
+			switch(candidate.GetKind())
+			{
+				case GenericArgument::Kind::HELP:
+					std::cout << GetHelp(name);
+					break;
+				case GenericArgument::Kind::USAGE:
+					std::cout << GetUsage(name);
+					break;
+				default:
+					std::cout << candidate.GetVersion() << '\n';
+					break;
+			}
+			return ParseResult::Success(true);
+		}
+		return ParseResult::Failure(ErrorCode::UNKNOWN_FLAG, 0, flag, flag);
+	}
+
+	// finds the subcommand with the smallest edit distance to a string, if
+	// any is close enough to be a typo of it
+	const char *FindClosestCommand(std::string_view command) const
+	{
+		const char *closest = nullptr;
+		std::size_t bound = CommandLine::maxSuggestionDistance;
+		for(std::size_t i = 0; i < _commands.size() && bound != 0; ++i)
+		{
+			const char *const name = _commands[i].GetName();
+			const std::size_t distance =
+			    details::EditDistance(command, name, bound);
+			if(distance <= bound)
+			{
+				closest = name;
+				bound = distance - 1;
+			}
+		}
+		return closest;
+	}
+
+	const char *_description;
+	std::vector<Subcommand> _commands;
+	std::vector<GenericArgument> _flags;
+	// finds subcommands by name, built once on construction
+	details::FlagTable _table;
+	// the state of the last run
+	std::size_t _selected = npos;
+	std::string _name;
+	std::optional<CommandLine> _commandLine;
+};
+
+
+} // namespace cli
@@ -0,0 +1,203 @@
+/// @file
+/// @brief Contains cli::ThreadPool.
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace cli
+{
+
+
+/// @brief A fixed set of threads that run loops with work stealing.
+/// @details Each thread starts with an even share of a loop's iterations.  A
+/// thread that runs out steals half of the remaining iterations of another
+/// thread, so uneven iterations still keep every thread busy.  The thread
+/// calling ForEach() takes part as worker zero.
+class ThreadPool
+{
+public:
+	/// @brief Constructor.
+	/// @param size The number of workers including the calling thread, zero
+	/// for one per hardware thread.
+	explicit ThreadPool(std::size_t size = 0)
+	{
+		if(size == 0)
+		{
+			size = std::max(1U, std::thread::hardware_concurrency());
+		}
+		_ranges.reserve(size);
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			_ranges.push_back(std::make_unique<Range>());
+		}
+		_threads.reserve(size - 1);
+		for(std::size_t i = 1; i < size; ++i)
+		{
+			_threads.emplace_back([this, i]() { WorkerMain(i); });
+		}
+	}
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_isStopping = true;
+		}
+		_wake.notify_all();
+		for(std::thread &thread : _threads)
+		{
+			thread.join();
+		}
+	}
+
+	/// @brief Gets the number of workers, including the calling thread.
+	std::size_t GetSize() const noexcept
+	{
+		return _ranges.size();
+	}
+
+	/// @brief Calls function(index, worker) for every index in [0, count)
+	/// and waits for all calls to return.
+	/// @details Calls with the same worker are never concurrent, so the
+	/// worker can index per-thread state.  The function must not throw.  Not
+	/// safe to call from multiple threads at once.
+	template <typename Function>
+	void ForEach(std::size_t count, Function &&function)
+	{
+		if(count == 0)
+		{
+			return;
+		}
+		std::unique_lock<std::mutex> lock(_mutex);
+		_function = &function;
+		_invoke = [](void *function, std::size_t index, std::size_t worker) {
+			(*static_cast<std::remove_reference_t<Function> *>(function))(
+			    index, worker);
+		};
+		const std::size_t size = _ranges.size();
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			_ranges[i]->begin = count * i / size;
+			_ranges[i]->end = count * (i + 1) / size;
+		}
+		_active = _threads.size();
+		++_generation;
+		lock.unlock();
+		_wake.notify_all();
+
+		Work(0);
+
+		lock.lock();
+		_done.wait(lock, [this]() { return _active == 0; });
+	}
+
+private:
+	// iterations owned by a worker, stolen from the back
+	struct Range
+	{
+		std::mutex mutex;
+		std::size_t begin = 0;
+		std::size_t end = 0;
+	};
+
+	void WorkerMain(std::size_t worker)
+	{
+		std::size_t generation = 0;
+		std::unique_lock<std::mutex> lock(_mutex);
+		for(;;)
+		{
+			_wake.wait(lock, [&]() {
+				return _isStopping || _generation != generation;
+			});
+			if(_isStopping)
+			{
+				return;
+			}
+			generation = _generation;
+			lock.unlock();
+			Work(worker);
+			lock.lock();
+			if(--_active == 0)
+			{
+				_done.notify_one();
+			}
+		}
+	}
+
+	void Work(std::size_t worker)
+	{
+		std::size_t index;
+		while(Pop(worker, index) || Steal(worker, index))
+		{
+			_invoke(_function, index, worker);
+		}
+	}
+
+	bool Pop(std::size_t worker, std::size_t &index)
+	{
+		Range &range = *_ranges[worker];
+		std::lock_guard<std::mutex> lock(range.mutex);
+		if(range.begin == range.end)
+		{
+			return false;
+		}
+		index = range.begin++;
+		return true;
+	}
+
+	bool Steal(std::size_t worker, std::size_t &index)
+	{
+		const std::size_t size = _ranges.size();
+		for(std::size_t i = 1; i < size; ++i)
+		{
+			Range &victim = *_ranges[(worker + i) % size];
+			std::size_t begin;
+			std::size_t end;
+			{
+				std::lock_guard<std::mutex> lock(victim.mutex);
+				if(victim.begin == victim.end)
+				{
+					continue;
+				}
+				begin = victim.begin + (victim.end - victim.begin) / 2;
+				end = victim.end;
+				victim.end = begin;
+			}
+			// the worker's own range is empty so no one steals from it
+			Range &range = *_ranges[worker];
+			std::lock_guard<std::mutex> lock(range.mutex);
+			range.begin = begin + 1;
+			range.end = end;
+			index = begin;
+			return true;
+		}
+		return false;
+	}
+
+	std::vector<std::unique_ptr<Range>> _ranges;
+	std::vector<std::thread> _threads;
+
+	// guards everything below
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	std::condition_variable _done;
+	bool _isStopping = false;
+	std::size_t _generation = 0;
+	// number of threads that have not finished the current loop
+	std::size_t _active = 0;
+	void *_function = nullptr;
+	void (*_invoke)(void *, std::size_t, std::size_t) = nullptr;
+};
+
+
+} // namespace cli
@@ -0,0 +1,408 @@
+/// @file
+/// @brief Contains cli::details::ConfigFile.
+#pragma once
+
+#include "cli/details/MappedFile.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Reads the entries of a config file written in a subset of INI and
+/// TOML.
+/// @details The file is mapped into memory and read in a single pass, keys
+/// and values point directly into the mapping.  The syntax is:
+///   - "key = value" entries, one per line.  Keys are made of letters,
+///     digits, '_', '-' and '.'.
+///   - "[section]" headers, the section applies to the entries after it.
+///   - values that are bare text up to the end of the line or a '#', with
+///     surrounding blanks removed, "basic strings" with the escapes \\", \\\\,
+///     \\n, \\t and \\r, 'literal strings', or arrays of such values in
+///     brackets separated by commas, which may span lines.
+///   - comments starting with '#' anywhere outside of a string, or with ';'
+///     in place of an entry.
+class ConfigFile
+{
+public:
+	/// @brief An entry of the file, or an element of an array entry.
+	struct Entry
+	{
+		/// @brief The section of the entry, empty before the first section.
+		std::string_view section;
+		/// @brief The key, null terminated.
+		const char *key;
+		/// @brief The value, without quotes and with escapes replaced.
+		std::string_view value;
+		/// @brief If the value is followed by a null character.  Only
+		/// elements of arrays are not.
+		bool isTerminated;
+		/// @brief The line of the value, starting at one.
+		std::size_t line;
+		/// @brief The column of the value in bytes, starting at one.
+		std::size_t column;
+	};
+
+	/// @brief Describes the syntax error that stopped Read().
+	struct Error
+	{
+		/// @brief The description, or null if there was no syntax error.
+		const char *detail = nullptr;
+		std::size_t line = 0;
+		std::size_t column = 0;
+	};
+
+	/// @brief Opens a file, releasing any file opened before.
+	/// @returns False if the file could not be read.
+	bool Open(const char *path)
+	{
+		return _file.Open(path);
+	}
+
+	/// @brief Reads every entry of the open file, giving each to a handler.
+	/// @details The mapping is modified to terminate keys and values, so the
+	/// file can only be read once per Open().
+	/// @param handler Called with each Entry, in the order they appear.
+	/// Returns false to stop reading.
+	/// @returns True if every entry was read.  False if the handler stopped
+	/// reading or there is a syntax error, described by GetError().
+	template <typename Handler> bool Read(Handler &&handler)
+	{
+		_error = Error();
+		char *p = _file.GetData();
+		_end = p + _file.GetSize();
+		_line = 1;
+		_lineStart = p;
+		std::string_view section;
+		while(true)
+		{
+			p = SkipBlanks(p);
+			if(*p == '\0')
+			{
+				return p == _end || Fail(p, "Null character in the file.");
+			}
+			if(*p == ';')
+			{
+				p = SkipComment(p);
+				continue;
+			}
+			if(*p == '\n' || *p == '#')
+			{
+				p = EndLine(p);
+				continue;
+			}
+			if(*p == '[')
+			{
+				if(p[1] == '[')
+				{
+					return Fail(p, "Arrays of tables are not supported.");
+				}
+				char *const name = p = SkipBlanks(p + 1);
+				p = SkipKey(p);
+				section = std::string_view(name, p - name);
+				p = SkipBlanks(p);
+				if(section.empty() || *p != ']')
+				{
+					return Fail(p, "Expected a section name and ']'.");
+				}
+				p = EndLine(p + 1);
+				if(p == nullptr)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			char *const key = p;
+			p = SkipKey(p);
+			char *const keyEnd = p;
+			if(key == keyEnd)
+			{
+				return Fail(p, "Expected a key.");
+			}
+			p = SkipBlanks(p);
+			if(*p != '=')
+			{
+				return Fail(p, "Expected '=' after the key.");
+			}
+			// the key was fully read, its end can be overwritten
+			*keyEnd = '\0';
+			p = SkipBlanks(p + 1);
+
+			if(*p == '[')
+			{
+				p = ReadArray(p + 1, section, key, handler);
+				if(p == nullptr)
+				{
+					return false;
+				}
+				p = EndLine(p);
+				if(p == nullptr)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			Entry entry{section, key, {}, true, _line, Column(p)};
+			p = ReadValue(p, entry.value, false);
+			if(p == nullptr)
+			{
+				return false;
+			}
+			char *const next = EndLine(p);
+			if(next == nullptr)
+			{
+				return false;
+			}
+			char *const valueEnd =
+			    const_cast<char *>(entry.value.data() + entry.value.size());
+			if(valueEnd != _end)
+			{
+				// the rest of the line was already read
+				*valueEnd = '\0';
+			}
+			if(!handler(static_cast<const Entry &>(entry)))
+			{
+				return false;
+			}
+			p = next;
+		}
+	}
+
+	/// @brief Gets the stamp of the open file.
+	/// @returns False if stamps are not supported on this system.
+	bool GetStamp(FileStamp &stamp) const noexcept
+	{
+		return _file.GetStamp(stamp);
+	}
+
+	/// @brief Gets the syntax error that stopped Read(), if any.
+	const Error &GetError() const noexcept
+	{
+		return _error;
+	}
+
+private:
+	static bool IsBlank(char c) noexcept
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	static bool IsKeyCharacter(char c) noexcept
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+		    || (c >= '0' && c <= '9') || c == '_' || c == '-' || c == '.';
+	}
+
+	static char *SkipBlanks(char *p) noexcept
+	{
+		while(IsBlank(*p))
+		{
+			++p;
+		}
+		return p;
+	}
+
+	static char *SkipKey(char *p) noexcept
+	{
+		while(IsKeyCharacter(*p))
+		{
+			++p;
+		}
+		return p;
+	}
+
+	std::size_t Column(const char *p) const noexcept
+	{
+		return static_cast<std::size_t>(p - _lineStart) + 1;
+	}
+
+	bool Fail(const char *p, const char *detail) noexcept
+	{
+		_error = Error{detail, _line, Column(p)};
+		return false;
+	}
+
+	// skips to the newline ending a comment, or the end of the file
+	char *SkipComment(char *p) const noexcept
+	{
+		p = static_cast<char *>(std::memchr(p, '\n', _end - p));
+		return p != nullptr ? p : _end;
+	}
+
+	// skips blanks and a comment to the start of the next line, or fails and
+	// returns null if anything else is left on the line
+	char *EndLine(char *p) noexcept
+	{
+		p = SkipBlanks(p);
+		if(*p == '#')
+		{
+			p = SkipComment(p);
+		}
+		if(*p == '\n')
+		{
+			++_line;
+			_lineStart = p + 1;
+			return p + 1;
+		}
+		if(p != _end)
+		{
+			Fail(p, "Expected the end of the line.");
+			return nullptr;
+		}
+		return p;
+	}
+
+	// skips blanks, comments and newlines between the elements of an array
+	char *SkipSpace(char *p) noexcept
+	{
+		while(true)
+		{
+			p = SkipBlanks(p);
+			if(*p != '#' && *p != '\n')
+			{
+				return p;
+			}
+			p = EndLine(p);
+		}
+	}
+
+	// reads a value starting at p, returning the end of it or null on a
+	// syntax error
+	char *ReadValue(char *p, std::string_view &value, bool isElement) noexcept
+	{
+		if(*p == '"' || *p == '\'')
+		{
+			return ReadString(p, value);
+		}
+		char *const begin = p;
+		char *end = p;
+		while(*p != '\0' && *p != '\n' && *p != '#'
+		      && !(isElement && (*p == ',' || *p == ']')))
+		{
+			++p;
+			if(!IsBlank(p[-1]))
+			{
+				end = p;
+			}
+		}
+		if(begin == end)
+		{
+			Fail(begin, "Expected a value.");
+			return nullptr;
+		}
+		value = std::string_view(begin, end - begin);
+		return end;
+	}
+
+	// reads a quoted string, replacing escapes in place
+	char *ReadString(char *p, std::string_view &value) noexcept
+	{
+		const char quote = *p++;
+		char *const begin = p;
+		char *out = p;
+		while(*p != quote)
+		{
+			if(*p == '\0' || *p == '\n')
+			{
+				Fail(p, "Unterminated string.");
+				return nullptr;
+			}
+			if(*p == '\\' && quote == '"')
+			{
+				++p;
+				switch(*p)
+				{
+					case '"':
+					case '\\':
+						*out++ = *p;
+						break;
+					case 'n':
+						*out++ = '\n';
+						break;
+					case 't':
+						*out++ = '\t';
+						break;
+					case 'r':
+						*out++ = '\r';
+						break;
+					default:
+						Fail(p - 1, "Unsupported escape sequence.");
+						return nullptr;
+				}
+				++p;
+				continue;
+			}
+			*out++ = *p++;
+		}
+		value = std::string_view(begin, out - begin);
+		return p + 1;
+	}
+
+	// reads the elements of an array after its '[', returning the end of the
+	// array or null if reading stopped
+	template <typename Handler>
+	char *ReadArray(
+	    char *p,
+	    std::string_view section,
+	    const char *key,
+	    Handler &handler)
+	{
+		while(true)
+		{
+			p = SkipSpace(p);
+			if(*p == ']')
+			{
+				return p + 1;
+			}
+			if(*p == '\0')
+			{
+				Fail(p, "Unterminated array.");
+				return nullptr;
+			}
+			Entry entry{section, key, {}, false, _line, Column(p)};
+			p = ReadValue(p, entry.value, true);
+			if(p == nullptr || !handler(static_cast<const Entry &>(entry)))
+			{
+				return nullptr;
+			}
+			p = SkipSpace(p);
+			if(*p == ',')
+			{
+				++p;
+			}
+			else if(*p == '\0')
+			{
+				Fail(p, "Unterminated array.");
+				return nullptr;
+			}
+			else if(*p != ']')
+			{
+				Fail(p, "Expected ',' or ']' after an array element.");
+				return nullptr;
+			}
+		}
+	}
+
+	MappedFile _file;
+	// state of the current Read()
+	char *_end = nullptr;
+	char *_lineStart = nullptr;
+	std::size_t _line = 0;
+	Error _error;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -1,14 +1,21 @@
 /// @file
-/// @brief
+/// @brief Contains cli::details::Destination.
 
 #pragma once
 
+#include "cli/ErrorHandler.hpp"
 #include "cli/Parse.hpp"
+#include "cli/Serialize.hpp"
 #include "cli/details/ArrayTraits.hpp"
+#include "cli/details/Lazy_fwd.hpp"
+#include "cli/details/StoreRun.hpp"
 
 #include <array>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <stdexcept>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
@@ -21,78 +28,435 @@ namespace details
 {
 
 
+/// @brief Gets a value that uniquely identifies a type without using RTTI.
+template <typename T> const void *TypeTag() noexcept
+{
+	static const char tag = 0;
+	return &tag;
+}
+
+
+/// @brief Traits of a pointer to a data member.
+template <auto Member> struct MemberTraits;
+
+template <typename Object, typename T, T Object::*Member>
+struct MemberTraits<Member>
+{
+	using object_type = Object;
+	using value_type = T;
+
+	static void *Locate(void *object) noexcept
+	{
+		return &(static_cast<Object *>(object)->*Member);
+	}
+};
+
+
+/// @brief Type erased location that parsed command line values are stored to.
+/// @details A destination is either bound to a single object when it is
+/// constructed or is a member of an object that is only known when parsing.
+/// Destinations are immutable, all per-parse state such as the number of
+/// values already stored is passed in by the caller, so a single destination
+/// can be used from multiple threads at once as long as each thread stores to
+/// a different object.
 class Destination
 {
 private:
 	template <typename T>
-	static void StoreImpl(const char *str, void **dest, void *end)
+	static bool StoreImpl(void *dest, const char *str, std::size_t index)
 	{
-		if(*dest == end)
+		T &value = *static_cast<T *>(dest);
+		if constexpr(IsLazy_v<T>)
+		{
+			// converted when first read
+			return value.Capture(str, index);
+		}
+		else if constexpr(IsArray_v<T>)
 		{
-			// arity checks should have prevented this
-			throw std::runtime_error(
-			    "Internal error: cli::details::Destination wrapping an array "
-			    "given too many arguments.");
+			if constexpr(std::is_same_v<ArrayValue_t<T>, char>)
+			{
+				// arrays of char are treated like a bounded string, this is
+				// handled by cli::Parse()
+				return cli::Parse(value, str);
+			}
+			else
+			{
+				// arrays of non-chars are treated like a bounded vector,
+				// this is handled by this class
+				if(index >= ArraySize_v<T>)
+				{
+					// arity checks should have prevented this
+					Throw<std::runtime_error>(
+					    "Internal error: cli::details::Destination wrapping an "
+					    "array given too many arguments.");
+				}
+				return cli::Parse(ArrayGetData_v<T>(value)[index], str);
+			}
 		}
-		cli::Parse(*static_cast<T *>(*dest), str);
-		if(end != nullptr)
+		else
 		{
-			*dest = static_cast<T *>(*dest) + 1;
+			// non-arrays are handled by cli::Parse()
+			return cli::Parse(value, str);
 		}
 	}
 
-public:
-	Destination(const Destination &other)
-	    : _dest(other._dest)
-	    , _end(other._end)
-	    , _storeFunction(other._storeFunction)
-	{}
-
-	Destination(Destination &other)
-	    : Destination(std::as_const(other))
-	{}
+	template <typename T>
+	static bool StoreRunImpl(
+	    void *dest,
+	    const char *const *values,
+	    std::size_t count,
+	    std::size_t &stored,
+	    ThreadPool *pool)
+	{
+		return details::StoreRun(
+		    *static_cast<T *>(dest), values, count, stored, pool);
+	}
 
+	// stores one element of a list, see StoreElement()
 	template <typename T>
-	Destination(T &value) noexcept
-	    : _dest(nullptr)
-	    , _end(nullptr)
-	    , _storeFunction(nullptr)
+	static bool
+	StoreElementImpl(void *dest, std::string_view element, std::size_t index)
 	{
-		if constexpr(IsArray_v<T>)
+		T &value = *static_cast<T *>(dest);
+		if constexpr(IsLazy_v<T>)
+		{
+			return value.Capture(element, index);
+		}
+		else if constexpr(IsArray_v<T>)
 		{
 			if constexpr(std::is_same_v<ArrayValue_t<T>, char>)
 			{
-				// arrays of char are treated like a bounded string, this is
-				// handled by cli::Parse()
-				_dest = ArrayGetData_v<T>(value);
-				_storeFunction = StoreImpl<T>;
+				return cli::Parse(value, element);
 			}
 			else
 			{
-				// arrays of non-chars are treated like a bounded vector,
-				// this is handled by this class
-				_dest = ArrayGetData_v<T>(value);
-				_storeFunction = StoreImpl<ArrayValue_t<T>>;
-				_end = ArrayGetData_v<T>(value) + ArraySize_v<T>;
+				if(index >= ArraySize_v<T>)
+				{
+					// arity checks should have prevented this
+					Throw<std::runtime_error>(
+					    "Internal error: cli::details::Destination wrapping "
+					    "an array given too many arguments.");
+				}
+				return cli::Parse(ArrayGetData_v<T>(value)[index], element);
+			}
+		}
+		else if constexpr(IsVector_v<T>)
+		{
+			// parse straight into the new element
+			PopBackGuard<T> guard{value};
+			if(!cli::Parse(value.emplace_back(), element))
+			{
+				return false;
 			}
+			guard.isDismissed = true;
+			return true;
 		}
 		else
 		{
-			// non-arrays are handled by cli::Parse()
-			_dest = &value;
-			_storeFunction = StoreImpl<T>;
+			return cli::Parse(value, element);
 		}
 	}
 
-	void Store(const char *str)
+	template <typename T>
+	static void SaveImpl(const void *dest, SnapshotWriter &writer)
+	{
+		cli::Serialize(*static_cast<const T *>(dest), writer);
+	}
+
+	// a null dest only checks that the snapshot holds a valid value
+	template <typename T>
+	static bool LoadImpl(void *dest, SnapshotReader &reader)
+	{
+		if(dest == nullptr)
+		{
+			T value{};
+			return cli::Deserialize(value, reader);
+		}
+		return cli::Deserialize(*static_cast<T *>(dest), reader);
+	}
+
+	using StoreElementFunction =
+	    bool (*)(void *, std::string_view, std::size_t);
+
+	using StoreRunFunction = bool (*)(
+	    void *,
+	    const char *const *,
+	    std::size_t,
+	    std::size_t &,
+	    ThreadPool *);
+
+	template <typename T>
+	static constexpr StoreRunFunction GetStoreRunFunction() noexcept
+	{
+		if constexpr(CanStoreRuns_v<T>)
+		{
+			return StoreRunImpl<T>;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	using SaveFunction = void (*)(const void *, SnapshotWriter &);
+
+	using LoadFunction = bool (*)(void *, SnapshotReader &);
+
+	using FingerprintFunction = std::uint64_t (*)();
+
+	// values are checked by reading them into a temporary, see Check()
+	template <typename T>
+	static constexpr bool isSerializable =
+	    IsSerializable_v<T> && std::is_default_constructible_v<T>;
+
+	template <typename T>
+	static constexpr SaveFunction GetSaveFunction() noexcept
+	{
+		if constexpr(isSerializable<T>)
+		{
+			return SaveImpl<T>;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	template <typename T>
+	static constexpr LoadFunction GetLoadFunction() noexcept
+	{
+		if constexpr(isSerializable<T>)
+		{
+			return LoadImpl<T>;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	template <typename T>
+	static constexpr FingerprintFunction GetFingerprintFunction() noexcept
+	{
+		if constexpr(isSerializable<T>)
+		{
+			return GetSerializeFingerprint<T>;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	Destination(
+	    void *dest,
+	    void *(*locateFunction)(void *),
+	    const void *objectType,
+	    bool (*storeFunction)(void *, const char *, std::size_t),
+	    StoreElementFunction storeElementFunction,
+	    StoreRunFunction storeRunFunction,
+	    SaveFunction saveFunction,
+	    LoadFunction loadFunction,
+	    FingerprintFunction fingerprintFunction,
+	    bool refersToInput)
+	    : _dest(dest)
+	    , _locateFunction(locateFunction)
+	    , _objectType(objectType)
+	    , _storeFunction(storeFunction)
+	    , _storeElementFunction(storeElementFunction)
+	    , _storeRunFunction(storeRunFunction)
+	    , _saveFunction(saveFunction)
+	    , _loadFunction(loadFunction)
+	    , _fingerprintFunction(fingerprintFunction)
+	    , _refersToInput(refersToInput)
+	{}
+
+public:
+	Destination(const Destination &other) = default;
+
+	Destination(Destination &other)
+	    : Destination(std::as_const(other))
+	{}
+
+	/// @brief Constructs a destination bound to a single object.
+	template <typename T>
+	Destination(T &value) noexcept
+	    : Destination(
+	        &value,
+	        nullptr,
+	        nullptr,
+	        StoreImpl<T>,
+	        StoreElementImpl<T>,
+	        GetStoreRunFunction<T>(),
+	        GetSaveFunction<T>(),
+	        GetLoadFunction<T>(),
+	        GetFingerprintFunction<T>(),
+	        RefersToInput_v<T>)
+	{}
+
+	/// @brief Constructs a destination that is a data member of an object
+	/// that is supplied when storing.
+	/// @tparam Member Pointer to the data member.
+	template <auto Member> static Destination ForMember() noexcept
+	{
+		using Traits = MemberTraits<Member>;
+		return Destination(
+		    nullptr,
+		    Traits::Locate,
+		    TypeTag<typename Traits::object_type>(),
+		    StoreImpl<typename Traits::value_type>,
+		    StoreElementImpl<typename Traits::value_type>,
+		    GetStoreRunFunction<typename Traits::value_type>(),
+		    GetSaveFunction<typename Traits::value_type>(),
+		    GetLoadFunction<typename Traits::value_type>(),
+		    GetFingerprintFunction<typename Traits::value_type>(),
+		    RefersToInput_v<typename Traits::value_type>);
+	}
+
+	/// @brief Gets the TypeTag() of the object this destination is a member
+	/// of, or nullptr if this destination is bound to a single object.
+	const void *GetObjectType() const noexcept
+	{
+		return _objectType;
+	}
+
+	/// @brief Gets if values stored to this destination refer to the strings
+	/// they were parsed from, see RefersToInput.
+	bool RefersToInput() const noexcept
+	{
+		return _refersToInput;
+	}
+
+	/// @brief Gets the address of the destination's value.
+	/// @param object The object this destination is a member of.  Ignored if
+	/// this destination is bound to a single object.
+	void *Locate(void *object) const noexcept
+	{
+		if(_locateFunction == nullptr)
+		{
+			return _dest;
+		}
+		assert(object != nullptr);
+		return _locateFunction(object);
+	}
+
+	/// @brief Parses and stores a value.
+	/// @param str The value to parse.
+	/// @param index The number of values previously stored to this
+	/// destination during the current parse.
+	/// @param object The object this destination is a member of.  Ignored if
+	/// this destination is bound to a single object.
+	/// @returns True on success.  On failure the exception thrown by the
+	/// parser propagates, or when exceptions are disabled false is returned.
+	bool Store(const char *str, std::size_t index, void *object = nullptr) const
+	{
+		return _storeFunction(Locate(object), str, index);
+	}
+
+	/// @brief Parses and stores one element of a list value.
+	/// @details Like Store() but the element need not be null terminated, it
+	/// is parsed with the string view overload of cli::Parse().
+	/// @param element The element.
+	/// @param index The number of values previously stored to this
+	/// destination during the current parse.
+	/// @param object The object this destination is a member of.  Ignored if
+	/// this destination is bound to a single object.
+	/// @returns True on success, see Store().
+	bool StoreElement(
+	    std::string_view element,
+	    std::size_t index,
+	    void *object = nullptr) const
+	{
+		return _storeElementFunction(Locate(object), element, index);
+	}
+
+	/// @brief Gets if StoreRun() is supported, which is the case for
+	/// std::vector, set and map destinations.
+	bool CanStoreRuns() const noexcept
+	{
+		return _storeRunFunction != nullptr;
+	}
+
+	/// @brief Parses and stores a run of values with one typed call.
+	/// @details Reserves room for all values of a vector up front.  Values
+	/// stored before a failure are kept.  See details::StoreRun() for how a
+	/// pool is used.
+	/// @pre CanStoreRuns().
+	/// @param values The values to parse.
+	/// @param count The number of values.
+	/// @param object The object this destination is a member of.  Ignored if
+	/// this destination is bound to a single object.
+	/// @param[out] stored The number of values stored, the index of the
+	/// failing value on failure.
+	/// @param pool The pool to convert long runs on, may be null.
+	/// @returns True on success.  On failure the exception thrown by the
+	/// parser propagates, or when exceptions are disabled false is returned.
+	bool StoreRun(
+	    const char *const *values,
+	    std::size_t count,
+	    void *object,
+	    std::size_t &stored,
+	    ThreadPool *pool = nullptr) const
+	{
+		return _storeRunFunction(Locate(object), values, count, stored, pool);
+	}
+
+	/// @brief Gets if Save(), Check() and Load() are supported, which is the
+	/// case when the value is serializable, see cli::IsSerializable_v, and
+	/// default constructible.
+	bool CanSerialize() const noexcept
+	{
+		return _saveFunction != nullptr;
+	}
+
+	/// @brief Writes the value of this destination to a snapshot.
+	/// @pre CanSerialize().
+	/// @param object The object this destination is a member of.  Ignored if
+	/// this destination is bound to a single object.
+	void Save(SnapshotWriter &writer, void *object = nullptr) const
+	{
+		_saveFunction(Locate(object), writer);
+	}
+
+	/// @brief Replaces the value of this destination with one read from a
+	/// snapshot.
+	/// @pre CanSerialize().
+	/// @param object The object this destination is a member of.  Ignored if
+	/// this destination is bound to a single object.
+	/// @returns False if the snapshot does not hold a valid value.
+	bool Load(SnapshotReader &reader, void *object = nullptr) const
+	{
+		return _loadFunction(Locate(object), reader);
+	}
+
+	/// @brief Reads a value like Load() without storing it.
+	/// @pre CanSerialize().
+	/// @returns False if the snapshot does not hold a valid value.
+	bool Check(SnapshotReader &reader) const
+	{
+		return _loadFunction(nullptr, reader);
+	}
+
+	/// @brief Gets the cli::GetSerializeFingerprint() of the value type.
+	/// @pre CanSerialize().
+	std::uint64_t GetFingerprint() const
 	{
-		_storeFunction(str, &_dest, _end);
+		return _fingerprintFunction();
 	}
 
 private:
 	void *_dest;
-	void *_end;
-	void (*_storeFunction)(const char *, void **, void *);
+	void *(*_locateFunction)(void *);
+	const void *_objectType;
+	bool (*_storeFunction)(void *, const char *, std::size_t);
+	StoreElementFunction _storeElementFunction;
+	// null unless the destination is a std::vector, set or map
+	StoreRunFunction _storeRunFunction;
+	// null unless the value is serializable
+	SaveFunction _saveFunction;
+	LoadFunction _loadFunction;
+	FingerprintFunction _fingerprintFunction;
+	bool _refersToInput;
 };
 
 
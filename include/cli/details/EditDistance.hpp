@@ -0,0 +1,110 @@
+/// @file
+/// @brief Contains the edit distance used to suggest flags for typos.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief The longest string EditDistance() compares once a common prefix and
+/// suffix are skipped, longer strings are never within the bound.
+constexpr std::size_t maxEditDistanceLength = 64;
+
+
+/// @brief Gets the number of single character insertions, deletions,
+/// substitutions and transpositions of adjacent characters that turn one
+/// string into another, stopping early once it exceeds a bound.
+/// @details Strings whose lengths differ by more than the bound are rejected
+/// without comparing characters, and a common prefix and suffix are skipped.
+/// Only the band of entries within the bound
+/// of the diagonal is computed, and the comparison stops as soon as every
+/// entry of a row exceeds the bound.  Does not allocate.
+/// @returns The distance, or bound + 1 if it is more than bound.
+inline std::size_t
+EditDistance(std::string_view a, std::string_view b, std::size_t bound)
+{
+	if(a.size() < b.size())
+	{
+		std::swap(a, b);
+	}
+	// b is the shorter string, rows are indexed by its characters
+	if(a.size() - b.size() > bound)
+	{
+		return bound + 1;
+	}
+	// a common prefix and suffix do not change the distance
+	std::size_t prefix = 0;
+	while(prefix < b.size() && a[prefix] == b[prefix])
+	{
+		++prefix;
+	}
+	a.remove_prefix(prefix);
+	b.remove_prefix(prefix);
+	while(!b.empty() && a.back() == b.back())
+	{
+		a.remove_suffix(1);
+		b.remove_suffix(1);
+	}
+	if(b.size() > maxEditDistanceLength)
+	{
+		return bound + 1;
+	}
+	const std::size_t over = bound + 1;
+	using Row = std::array<std::size_t, maxEditDistanceLength + 2>;
+	Row rows[3];
+	Row *previous2 = &rows[0];
+	Row *previous = &rows[1];
+	Row *current = &rows[2];
+	for(std::size_t j = 0; j <= b.size(); ++j)
+	{
+		(*previous)[j] = std::min(j, over);
+	}
+	(*previous)[b.size() + 1] = over;
+	for(std::size_t i = 1; i <= a.size(); ++i)
+	{
+		const std::size_t first = i > bound ? i - bound : 1;
+		const std::size_t last = std::min(b.size(), i + bound);
+		// entries left and right of the band are over the bound
+		(*current)[first - 1] = first == 1 ? std::min(i, over) : over;
+		(*current)[last + 1] = over;
+		std::size_t rowMinimum = (*current)[first - 1];
+		for(std::size_t j = first; j <= last; ++j)
+		{
+			const std::size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+			std::size_t distance = (*previous)[j - 1] + cost;
+			distance = std::min(distance, (*previous)[j] + 1);
+			distance = std::min(distance, (*current)[j - 1] + 1);
+			if(i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+			{
+				distance = std::min(distance, (*previous2)[j - 2] + 1);
+			}
+			distance = std::min(distance, over);
+			(*current)[j] = distance;
+			rowMinimum = std::min(rowMinimum, distance);
+		}
+		if(rowMinimum > bound)
+		{
+			return over;
+		}
+		std::swap(previous2, previous);
+		std::swap(previous, current);
+	}
+	return (*previous)[b.size()];
+}
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -0,0 +1,36 @@
+/// @file
+/// @brief Contains cli::details::GetEnvironment().
+#pragma once
+
+#include <cstdlib>
+
+#ifndef _WIN32
+extern char **environ;
+#endif
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Gets the environment variables of the process.
+/// @returns A null terminated array of "NAME=value" strings.  Only valid
+/// until the environment is next modified.
+inline const char *const *GetEnvironment() noexcept
+{
+#ifdef _WIN32
+	return _environ;
+#else
+	return environ;
+#endif
+}
+
+
+} // namespace details
+
+
+} // namespace cli
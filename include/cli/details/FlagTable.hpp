@@ -0,0 +1,124 @@
+/// @file
+/// @brief Contains cli::details::FlagTable.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Immutable lookup table from flag names to argument indices.
+/// @details Open addressed hash table with linear probing.  The table is
+/// built once when a command line is constructed and is only read from while
+/// parsing, so a lookup never allocates.  Names are not copied, the strings
+/// they refer to must outlive the table.
+class FlagTable
+{
+public:
+	/// @brief Index returned by Find() when a name is not in the table.
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	/// @brief Constructs an empty table.
+	FlagTable() = default;
+
+	/// @brief Constructs a table with room for a given number of names.
+	/// @details A table with room for no names does not allocate.
+	/// @param count The number of names.
+	/// @param resource The memory resource the table is allocated from.
+	explicit FlagTable(
+	    std::size_t count,
+	    std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+	    : _slots(resource)
+	{
+		if(count == 0)
+		{
+			// an empty table does not allocate, Find() checks for this
+			return;
+		}
+		// keep the load factor at or below one half
+		std::size_t capacity = 4;
+		while(capacity < 2 * count)
+		{
+			capacity *= 2;
+		}
+		_slots.resize(capacity);
+	}
+
+	/// @brief Adds a name to this table.
+	/// @details If the name is already present the first index is kept.
+	/// @pre This table was constructed with room for this name.
+	void Insert(std::string_view name, std::size_t index)
+	{
+		const std::size_t mask = _slots.size() - 1;
+		for(std::size_t i = Hash(name) & mask;; i = (i + 1) & mask)
+		{
+			Slot &slot = _slots[i];
+			if(slot.index == npos)
+			{
+				slot.name = name;
+				slot.index = index;
+				return;
+			}
+			if(slot.name == name)
+			{
+				return;
+			}
+		}
+	}
+
+	/// @brief Finds the index associated with a name.
+	/// @returns The index or npos if the name is not in this table.
+	std::size_t Find(std::string_view name) const noexcept
+	{
+		if(_slots.empty())
+		{
+			return npos;
+		}
+		const std::size_t mask = _slots.size() - 1;
+		for(std::size_t i = Hash(name) & mask;; i = (i + 1) & mask)
+		{
+			const Slot &slot = _slots[i];
+			if(slot.index == npos || slot.name == name)
+			{
+				return slot.index;
+			}
+		}
+	}
+
+	/// @brief 64 bit FNV-1a hash.
+	static constexpr std::size_t Hash(std::string_view name) noexcept
+	{
+		std::uint64_t hash = 14695981039346656037ULL;
+		for(const char c : name)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ULL;
+		}
+		return static_cast<std::size_t>(hash);
+	}
+
+private:
+	struct Slot
+	{
+		std::string_view name;
+		std::size_t index = npos;
+	};
+
+	std::pmr::vector<Slot> _slots;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "cli/ArgumentStream.hpp"
+#include "cli/ErrorHandler.hpp"
+
 #include <cstddef>
 #include <stdexcept>
 
@@ -13,8 +16,10 @@ namespace details
 
 
 /// @brief Yields strings from a command line invocation.
-/// @details All member functions throw std::runtime_error on precondition
-/// violations.
+/// @details Strings come either from an array, such as argv, or are read from
+/// a cli::ArgumentStream.  A string yielded from a stream is only valid until
+/// the next string is peeked.  All member functions throw std::runtime_error on
+/// precondition violations, see details::Throw().
 class Generator
 {
 public:
@@ -24,44 +29,110 @@ public:
 	    , _end(end)
 	{}
 
-	/// @brief Gets the number of strings remaining in this generator.
-	std::size_t Remaining() const noexcept
+	/// @brief Constructor from a stream.
+	/// @param stream The stream, must outlive this generator.
+	explicit Generator(ArgumentStream &stream)
+	    : _stream(&stream)
+	{}
+
+	/// @brief Gets if no strings remain in this generator.
+	/// @details May read from the stream of this generator.
+	bool IsEmpty()
+	{
+		if(_stream != nullptr)
+		{
+			return _stream->Peek() == nullptr;
+		}
+		return _next == _end;
+	}
+
+	/// @brief Gets the number of strings already yielded by this generator.
+	std::size_t GetIndex() const noexcept
+	{
+		return _index;
+	}
+
+	/// @brief Gets a description of why the stream of this generator failed.
+	/// @returns The description or nullptr if it has not failed.
+	const char *GetError() const noexcept
 	{
-		return static_cast<std::size_t>(_end - _next);
+		return _stream != nullptr ? _stream->GetError() : nullptr;
 	}
 
 	/// @brief Gets the next value to be yielded by this generator without
 	/// consuming it.
-	/// @pre Remaining() != 0.
-	const char *Peek() const
+	/// @pre !IsEmpty().
+	const char *Peek()
 	{
-		if(_next == _end)
+		if(IsEmpty())
 		{
-			throw std::runtime_error(
+			Throw<std::runtime_error>(
 			    "Internal cli error: cli::details::Generator::Peek() called on "
 			    "exhausted generator.");
 		}
-		return *_next;
+		return _stream != nullptr ? _stream->Peek() : *_next;
 	}
 
 	/// @brief Yields a value from this generator, consuming it.
-	/// @pre Remaining() != 0.
+	/// @pre !IsEmpty().
 	const char *Next()
 	{
-		if(_next == _end)
+		if(IsEmpty())
 		{
-			throw std::runtime_error(
+			Throw<std::runtime_error>(
 			    "Internal cli error: cli::details::Generator::Next() called on "
 			    "exhausted generator.");
 		}
+		++_index;
+		if(_stream != nullptr)
+		{
+			const char *ret = _stream->Peek();
+			_stream->Pop();
+			return ret;
+		}
 		const char *ret = *_next;
 		_next++;
 		return ret;
 	}
 
+	/// @brief Gets the next strings that can be handled as one run of
+	/// values, those before the next flag or null string.
+	/// @details Runs are only found in arrays, strings read from a stream are
+	/// only valid one at a time so their runs are empty.
+	/// @param limit The maximum length of the run.
+	/// @param[out] count The length of the run.
+	/// @returns The first string of the run.
+	const char *const *
+	PeekRun(std::size_t limit, std::size_t &count) const noexcept
+	{
+		count = 0;
+		if(_stream == nullptr)
+		{
+			const std::size_t available =
+			    static_cast<std::size_t>(_end - _next);
+			limit = limit < available ? limit : available;
+			while(count < limit && _next[count] != nullptr
+			      && _next[count][0] != '-')
+			{
+				++count;
+			}
+		}
+		return _next;
+	}
+
+	/// @brief Consumes strings of a run returned by PeekRun().
+	/// @pre count is at most the length of the run.
+	void Skip(std::size_t count) noexcept
+	{
+		_next += count;
+		_index += count;
+	}
+
 private:
-	const char *const *_next;
-	const char *const *_end;
+	const char *const *_next = nullptr;
+	const char *const *_end = nullptr;
+	ArgumentStream *_stream = nullptr;
+	std::size_t _index = 0;
 };
 
 
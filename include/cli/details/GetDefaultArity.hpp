@@ -2,6 +2,7 @@
 
 #include "cli/Arity.hpp"
 #include "cli/details/ArrayTraits.hpp"
+#include "cli/details/Lazy_fwd.hpp"
 
 #include <map>
 #include <optional>
@@ -22,11 +23,13 @@ template <typename T> constexpr Arity GetDefaultArity(const T &);
 
 template <typename T> constexpr Arity GetDefaultArity(const std::optional<T> &);
 
+template <typename T> constexpr Arity GetDefaultArity(const Lazy<T> &);
+
 template <typename T, typename Allocator>
 constexpr Arity GetDefaultArity(const std::vector<T, Allocator> &);
 
-template <typename T, typename Allocator>
-constexpr Arity GetDefaultArity(const std::set<T, Allocator> &);
+template <typename T, typename Compare, typename Allocator>
+constexpr Arity GetDefaultArity(const std::set<T, Compare, Allocator> &);
 
 template <typename T, typename Hash, typename Equal, typename Allocator>
 constexpr Arity
@@ -72,14 +75,21 @@ template <typename T> constexpr Arity GetDefaultArity(const std::optional<T> &)
 	return Arity::NoMoreThan(valueArity.inclusiveMax);
 }
 
+template <typename T> constexpr Arity GetDefaultArity(const Lazy<T> &)
+{
+	// a lazy value takes the strings its value would
+	const T value{};
+	return GetDefaultArity(value);
+}
+
 template <typename T, typename Allocator>
 constexpr Arity GetDefaultArity(const std::vector<T, Allocator> &)
 {
 	return Arity::Unbounded();
 }
 
-template <typename T, typename Allocator>
-constexpr Arity GetDefaultArity(const std::set<T, Allocator> &)
+template <typename T, typename Compare, typename Allocator>
+constexpr Arity GetDefaultArity(const std::set<T, Compare, Allocator> &)
 {
 	return Arity::Unbounded();
 }
@@ -0,0 +1,32 @@
+/// @file
+/// @brief Forward declares cli::Lazy for the headers that recognize it.
+#pragma once
+
+#include <type_traits>
+
+
+namespace cli
+{
+
+
+template <typename T> class Lazy;
+
+
+namespace details
+{
+
+
+/// @brief Detector for cli::Lazy destinations.
+template <typename T> struct IsLazy : std::false_type
+{};
+
+template <typename T> struct IsLazy<Lazy<T>> : std::true_type
+{};
+
+template <typename T> constexpr bool IsLazy_v = IsLazy<T>::value;
+
+
+} // namespace details
+
+
+} // namespace cli
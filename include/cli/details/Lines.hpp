@@ -0,0 +1,137 @@
+/// @file
+/// @brief Contains cli::details::Lines.
+#pragma once
+
+#include "cli/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Splits a buffer of newline separated lines into chunks that can be
+/// processed in parallel.
+/// @details Chunks are fixed size ranges of the buffer, each holds the lines
+/// that start in it.  Lines are found and counted in parallel when
+/// constructed, so each chunk knows the number of its first line without
+/// reading any other chunk.
+class Lines
+{
+public:
+	/// @brief The size in bytes of each chunk.
+	static constexpr std::size_t chunkSize = 64 * 1024;
+
+	/// @brief Constructor.
+	/// @param data The buffer.  Must be followed by a null character.
+	/// @param size The size of the buffer, not including the null character.
+	/// @param pool The pool to find lines with.
+	Lines(char *data, std::size_t size, ThreadPool &pool)
+	    : _data(data)
+	    , _size(size)
+	    , _firstLines((size + chunkSize - 1) / chunkSize)
+	    , _firstStarts(_firstLines.size())
+	{
+		pool.ForEach(
+		    _firstLines.size(),
+		    [this](std::size_t chunk, std::size_t) { FindLines(chunk); });
+		// turn the line count of each chunk into the number of its first line
+		std::size_t line = 1;
+		for(std::size_t &count : _firstLines)
+		{
+			line += std::exchange(count, line);
+		}
+		_count = line - 1;
+	}
+
+	/// @brief Gets the number of chunks.
+	std::size_t GetChunkCount() const noexcept
+	{
+		return _firstLines.size();
+	}
+
+	/// @brief Gets the number of lines.
+	/// @details A final newline does not start another line.
+	std::size_t GetLineCount() const noexcept
+	{
+		return _count;
+	}
+
+	/// @brief Calls function(line, begin, end) for each line that starts in
+	/// a chunk.
+	/// @details The line number is one based, [begin, end) is the line
+	/// without its newline.  Lines of different chunks never overlap, so
+	/// chunks can be processed concurrently and modify their lines.
+	template <typename Function>
+	void ForEachLine(std::size_t chunk, Function &&function) const
+	{
+		char *const chunkEnd =
+		    _data + std::min(_size, (chunk + 1) * chunkSize);
+		char *const end = _data + _size;
+		std::size_t line = _firstLines[chunk];
+		for(char *begin = _data + _firstStarts[chunk]; begin < chunkEnd;
+		    ++line)
+		{
+			char *newline =
+			    static_cast<char *>(std::memchr(begin, '\n', end - begin));
+			if(newline == nullptr)
+			{
+				newline = end;
+			}
+			function(line, begin, newline);
+			begin = newline + 1;
+		}
+	}
+
+private:
+	// counts the lines that start in a chunk and finds the first one
+	void FindLines(std::size_t chunk)
+	{
+		const std::size_t begin = chunk * chunkSize;
+		const std::size_t end = std::min(_size, begin + chunkSize);
+		// a line starts after each newline, and at the start of the buffer
+		std::size_t count = chunk == 0 ? 1 : 0;
+		const char *c = _data + (chunk == 0 ? 0 : begin - 1);
+		const char *const last = _data + end - 1;
+		std::size_t firstStart = chunk == 0 ? 0 : end;
+		while(c < last)
+		{
+			c = static_cast<const char *>(std::memchr(c, '\n', last - c));
+			if(c == nullptr)
+			{
+				break;
+			}
+			if(count == 0)
+			{
+				firstStart = static_cast<std::size_t>(c - _data) + 1;
+			}
+			++count;
+			++c;
+		}
+		_firstLines[chunk] = count;
+		_firstStarts[chunk] = firstStart;
+	}
+
+	char *_data;
+	std::size_t _size;
+	// one based number of the first line of each chunk
+	std::vector<std::size_t> _firstLines;
+	// offset of the first line of each chunk, the chunk end if it has none
+	std::vector<std::size_t> _firstStarts;
+	std::size_t _count = 0;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -0,0 +1,265 @@
+/// @file
+/// @brief Contains cli::details::MappedFile.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CLI_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Identifies a version of a file without reading it.
+/// @details A file that is replaced or written to gets a different stamp,
+/// unless it is written to twice within the resolution of its modification
+/// time without changing its size.
+struct FileStamp
+{
+	std::uint64_t device = 0;
+	std::uint64_t inode = 0;
+	std::uint64_t size = 0;
+	/// @brief The modification time in nanoseconds.
+	std::int64_t modified = 0;
+
+	bool operator==(const FileStamp &other) const noexcept
+	{
+		return device == other.device && inode == other.inode
+		    && size == other.size && modified == other.modified;
+	}
+
+	bool operator!=(const FileStamp &other) const noexcept
+	{
+		return !(*this == other);
+	}
+};
+
+
+#ifdef CLI_HAS_MMAP
+/// @brief Makes the stamp of a file from its status.
+inline FileStamp MakeFileStamp(const struct stat &status) noexcept
+{
+	FileStamp stamp;
+	stamp.device = static_cast<std::uint64_t>(status.st_dev);
+	stamp.inode = static_cast<std::uint64_t>(status.st_ino);
+	stamp.size = static_cast<std::uint64_t>(status.st_size);
+#ifdef __APPLE__
+	const struct timespec &modified = status.st_mtimespec;
+#else
+	const struct timespec &modified = status.st_mtim;
+#endif
+	stamp.modified = static_cast<std::int64_t>(modified.tv_sec) * 1000000000
+	    + static_cast<std::int64_t>(modified.tv_nsec);
+	return stamp;
+}
+#endif
+
+
+/// @brief Gets the stamp of the file at a path.
+/// @returns False if the file does not exist or stamps are not supported on
+/// this system, which is the case without POSIX.
+inline bool GetFileStamp(const char *path, FileStamp &stamp) noexcept
+{
+#ifdef CLI_HAS_MMAP
+	struct stat status;
+	if(::stat(path, &status) != 0)
+	{
+		return false;
+	}
+	stamp = MakeFileStamp(status);
+	return true;
+#else
+	static_cast<void>(path);
+	static_cast<void>(stamp);
+	return false;
+#endif
+}
+
+
+/// @brief A private, writable view of the contents of a file.
+/// @details On POSIX systems the file is mapped copy-on-write, writes are
+/// never visible to other processes and only copy the pages written to.
+/// Elsewhere the file is read into memory.  The contents are followed by a
+/// single null character that may be read but not written.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+
+	MappedFile(MappedFile &&other) noexcept
+	    : _data(std::exchange(other._data, nullptr))
+	    , _size(std::exchange(other._size, 0))
+	    , _length(std::exchange(other._length, 0))
+	    , _buffer(std::move(other._buffer))
+	    , _stamp(other._stamp)
+	{}
+
+	MappedFile &operator=(MappedFile &&other) noexcept
+	{
+		if(this != &other)
+		{
+			Close();
+			_data = std::exchange(other._data, nullptr);
+			_size = std::exchange(other._size, 0);
+			_length = std::exchange(other._length, 0);
+			_buffer = std::move(other._buffer);
+			_stamp = other._stamp;
+		}
+		return *this;
+	}
+
+	~MappedFile()
+	{
+		Close();
+	}
+
+	/// @brief Opens a file.
+	/// @param path The path of the file.
+	/// @returns False if the file could not be read.
+	bool Open(const char *path)
+	{
+		Close();
+#ifdef CLI_HAS_MMAP
+		const int fd = ::open(path, O_RDONLY);
+		if(fd < 0)
+		{
+			return false;
+		}
+		struct stat status;
+		if(::fstat(fd, &status) != 0 || !S_ISREG(status.st_mode))
+		{
+			::close(fd);
+			return false;
+		}
+		const std::size_t size = static_cast<std::size_t>(status.st_size);
+		const std::size_t page =
+		    static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+		// reserve at least one zero filled byte past the end of the file for
+		// the null terminator, the file is then mapped over the start
+		const std::size_t length = (size / page + 1) * page;
+		void *data = ::mmap(
+		    nullptr,
+		    length,
+		    PROT_READ | PROT_WRITE,
+		    MAP_PRIVATE | MAP_ANONYMOUS,
+		    -1,
+		    0);
+		if(data != MAP_FAILED && size != 0
+		   && ::mmap(
+		          data,
+		          size,
+		          PROT_READ | PROT_WRITE,
+		          MAP_PRIVATE | MAP_FIXED,
+		          fd,
+		          0)
+		       == MAP_FAILED)
+		{
+			::munmap(data, length);
+			data = MAP_FAILED;
+		}
+		::close(fd);
+		if(data == MAP_FAILED)
+		{
+			return false;
+		}
+		_data = static_cast<char *>(data);
+		_size = size;
+		_length = length;
+		_stamp = MakeFileStamp(status);
+		return true;
+#else
+		std::FILE *file = std::fopen(path, "rb");
+		if(file == nullptr)
+		{
+			return false;
+		}
+		bool isRead = std::fseek(file, 0, SEEK_END) == 0;
+		const long size = isRead ? std::ftell(file) : -1;
+		isRead = size >= 0 && std::fseek(file, 0, SEEK_SET) == 0;
+		if(isRead)
+		{
+			_buffer.reset(new char[size + 1]);
+			isRead = std::fread(_buffer.get(), 1, size, file)
+			    == static_cast<std::size_t>(size);
+			_buffer[size] = '\0';
+			_data = _buffer.get();
+			_size = static_cast<std::size_t>(size);
+		}
+		std::fclose(file);
+		if(!isRead)
+		{
+			Close();
+		}
+		return isRead;
+#endif
+	}
+
+	/// @brief Gets the contents of the file.
+	char *GetData() const noexcept
+	{
+		return _data;
+	}
+
+	/// @brief Gets the size of the file, not including the null terminator.
+	std::size_t GetSize() const noexcept
+	{
+		return _size;
+	}
+
+	/// @brief Gets the stamp of the file when it was opened.
+	/// @returns False if stamps are not supported on this system.
+	bool GetStamp(FileStamp &stamp) const noexcept
+	{
+#ifdef CLI_HAS_MMAP
+		stamp = _stamp;
+		return true;
+#else
+		static_cast<void>(stamp);
+		return false;
+#endif
+	}
+
+private:
+	void Close() noexcept
+	{
+#ifdef CLI_HAS_MMAP
+		if(_length != 0)
+		{
+			::munmap(_data, _length);
+		}
+#endif
+		_buffer.reset();
+		_data = nullptr;
+		_size = 0;
+		_length = 0;
+		_stamp = FileStamp();
+	}
+
+	char *_data = nullptr;
+	std::size_t _size = 0;
+	// length of the mapping, zero if the file was read into _buffer
+	std::size_t _length = 0;
+	std::unique_ptr<char[]> _buffer;
+	FileStamp _stamp;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -3,22 +3,36 @@
 /// for standard library types.
 #pragma once
 
-#include <algorithm>
+#include "cli/Config.hpp"
+#include "cli/ErrorHandler.hpp"
+#include "cli/details/TerminatedCopy.hpp"
+
 #include <array>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
 #include <cstddef>
+#include <cstdlib>
 #include <cstring>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+// floating point std::from_chars is missing from some standard libraries
+#if defined(__cpp_lib_to_chars) || (defined(_MSC_VER) && _MSC_VER >= 1924)
+#define CLI_HAS_FLOAT_FROM_CHARS
+#endif
+
 
 namespace cli
 {
@@ -28,44 +42,217 @@ namespace details
 {
 
 
-inline void Parse(std::string &string, const char *input)
+/// @brief Parses a number in decimal, or for floating point types in the
+/// format of std::strtod() without hexadecimal.
+/// @details Unlike stream extraction this is independent of the locale, does
+/// not allocate, and rejects values that are out of range, negative values of
+/// unsigned types, whitespace and trailing characters.  A leading '+' is
+/// accepted.
+template <typename T>
+std::enable_if_t<IsNumber_v<T>, bool>
+Parse(T &number, std::string_view input)
+{
+	const char *begin = input.data();
+	const char *const end = begin + input.size();
+	if(begin != end && begin[0] == '+'
+	   && (end - begin == 1 || begin[1] != '-'))
+	{
+		++begin;
+	}
+
+	T value;
+	std::from_chars_result result{begin, std::errc()};
+	if constexpr(std::is_integral_v<T>)
+	{
+		result = std::from_chars(begin, end, value);
+	}
+	else
+	{
+#ifdef CLI_HAS_FLOAT_FROM_CHARS
+		result = std::from_chars(begin, end, value);
+#else
+		// strtod() needs a null terminated string, skips whitespace and
+		// accepts hexadecimal, from_chars() does not
+		const TerminatedCopy copy(
+		    std::string_view(begin, static_cast<std::size_t>(end - begin)));
+		const char *const terminated = copy.Get();
+		const unsigned char first = static_cast<unsigned char>(*terminated);
+		const bool isDecimal = begin != end
+		    && (std::isdigit(first) || first == '-' || first == '.'
+		        || std::tolower(first) == 'i' || std::tolower(first) == 'n')
+		    && std::strpbrk(terminated, "xX") == nullptr;
+		char *parsed = const_cast<char *>(terminated);
+		errno = 0;
+		if(isDecimal)
+		{
+			if constexpr(std::is_same_v<T, float>)
+			{
+				value = std::strtof(terminated, &parsed);
+			}
+			else if constexpr(std::is_same_v<T, double>)
+			{
+				value = std::strtod(terminated, &parsed);
+			}
+			else
+			{
+				value = std::strtold(terminated, &parsed);
+			}
+		}
+		result.ptr = begin + (parsed - terminated);
+		if(parsed == terminated)
+		{
+			result.ec = std::errc::invalid_argument;
+		}
+		else if(errno == ERANGE)
+		{
+			result.ec = std::errc::result_out_of_range;
+		}
+#endif
+	}
+
+	if(result.ec == std::errc::result_out_of_range)
+	{
+		return ParseFailure("Number out of range.");
+	}
+	if(result.ec != std::errc())
+	{
+		return ParseFailure("Value is not a number.");
+	}
+	if(result.ptr != end)
+	{
+		return ParseFailure("Trailing characters after number.");
+	}
+	number = value;
+	return true;
+}
+
+
+template <typename Allocator>
+bool Parse(
+    std::basic_string<char, std::char_traits<char>, Allocator> &string,
+    std::string_view input)
+{
+	string = input;
+	return true;
+}
+
+
+/// @brief Stores a view of the input itself, nothing is copied.
+inline bool Parse(std::string_view &view, std::string_view input)
+{
+	view = input;
+	return true;
+}
+
+
+/// @brief Stores the input pointer itself, nothing is copied.
+inline bool Parse(const char *&string, const char *input)
 {
 	string = input;
+	return true;
+}
+
+
+/// @brief Fails, a view such as an element of a list is not null terminated
+/// so it can not be stored as a const char *.
+inline bool Parse(const char *&, std::string_view)
+{
+	return ParseFailure(
+	    "A const char * destination can only store a whole argument, use a "
+	    "std::string_view destination instead.");
 }
 
 
-template <std::size_t N> void Parse(char (&array)[N], const char *input)
+template <std::size_t N> bool Parse(char (&array)[N], std::string_view input)
 {
-	std::size_t length = std::strlen(input);
-	if(length >= N)
+	if(input.size() >= N)
 	{
-		throw std::invalid_argument(
+		return ParseFailure(
 		    "Command line argument does not fit in fixed size character array");
 	}
-	std::memcpy(array, input, length + 1);
+	std::memcpy(array, input.data(), input.size());
+	array[input.size()] = '\0';
+	return true;
 }
 
 
 template <std::size_t N>
-void Parse(std::array<char, N> &array, const char *input)
+bool Parse(std::array<char, N> &array, std::string_view input)
 {
-	std::size_t length = std::strlen(input);
-	if(length >= N)
+	if(input.size() >= N)
 	{
-		throw std::invalid_argument(
+		return ParseFailure(
 		    "Command line argument does not fit in fixed size character array");
 	}
-	std::memcpy(&array[0], input, length + 1);
+	std::memcpy(&array[0], input.data(), input.size());
+	array[input.size()] = '\0';
+	return true;
+}
+
+
+// the characters of an input after an offset, in the form of the input
+inline const char *Suffix(const char *input, std::size_t offset) noexcept
+{
+	return input + offset;
+}
+
+inline std::string_view
+Suffix(std::string_view input, std::size_t offset) noexcept
+{
+	return input.substr(offset);
+}
+
+
+// constructs an element with the allocator of its container if it uses
+// one, so moving it into a container of std::pmr types does not copy it
+template <typename T, typename Allocator>
+T MakeElement(const Allocator &allocator)
+{
+	if constexpr(std::uses_allocator_v<T, Allocator>)
+	{
+		return T(allocator);
+	}
+	else
+	{
+		return T();
+	}
+}
+
+
+// parses the <key>=<value> entry of a map
+template <typename Key, typename T, typename Input>
+bool ParseEntry(Key &key, T &value, Input input)
+{
+	const std::string_view view(input);
+	const std::size_t equal = view.find('=');
+	if(equal == std::string_view::npos)
+	{
+		return ParseFailure("Command line argument not in <key>=<value> form");
+	}
+	// the key is parsed straight from the view, it is not copied
+	return cli::Parse(key, view.substr(0, equal))
+	    && cli::Parse(value, Suffix(input, equal + 1));
 }
 
 
-template <typename T> void Parse(std::optional<T> &optional, const char *input)
+template <typename T, typename Input>
+bool Parse(std::optional<T> &optional, Input input)
 {
 	const bool startedEmpty = !optional.has_value();
 	if(startedEmpty)
 	{
 		optional.emplace();
 	}
+#ifdef CLI_NO_EXCEPTIONS
+	if(!cli::Parse(*optional, input))
+	{
+		if(startedEmpty)
+		{
+			optional.reset();
+		}
+		return false;
+	}
+#else
 	try
 	{
 		cli::Parse(*optional, input);
@@ -78,53 +265,97 @@ template <typename T> void Parse(std::optional<T> &optional, const char *input)
 		}
 		throw;
 	}
+#endif
+	return true;
 }
 
 
-template <typename T, typename Allocator>
-void Parse(std::vector<T, Allocator> &vector, const char *input)
+template <typename T, typename Allocator, typename Input>
+bool Parse(std::vector<T, Allocator> &vector, Input input)
 {
-	T value;
-	cli::Parse(value, input);
-	vector.push_back(std::move(value));
+	if constexpr(std::is_same_v<T, bool>)
+	{
+		// std::vector<bool> has no references to its elements
+		bool value;
+		if(!cli::Parse(value, input))
+		{
+			return false;
+		}
+		vector.push_back(value);
+	}
+	else
+	{
+		// the new element is constructed by the vector with its allocator
+		vector.emplace_back();
+#ifdef CLI_NO_EXCEPTIONS
+		if(!cli::Parse(vector.back(), input))
+		{
+			vector.pop_back();
+			return false;
+		}
+#else
+		try
+		{
+			cli::Parse(vector.back(), input);
+		}
+		catch(...)
+		{
+			vector.pop_back();
+			throw;
+		}
+#endif
+	}
+	return true;
 }
 
 
-template <typename T, typename Allocator>
-void Parse(std::set<T, Allocator> &set, const char *input)
+template <typename T, typename Compare, typename Allocator, typename Input>
+bool Parse(std::set<T, Compare, Allocator> &set, Input input)
 {
-	T value;
-	cli::Parse(value, input);
+	T value = MakeElement<T>(set.get_allocator());
+	if(!cli::Parse(value, input))
+	{
+		return false;
+	}
 	(void)set.insert(std::move(value));
+	return true;
 }
 
 
-template <typename T, typename Hash, typename Equal, typename Allocator>
-void Parse(
-    std::unordered_set<T, Hash, Equal, Allocator> &set,
-    const char *input)
+template <
+    typename T,
+    typename Hash,
+    typename Equal,
+    typename Allocator,
+    typename Input>
+bool Parse(std::unordered_set<T, Hash, Equal, Allocator> &set, Input input)
 {
-	T value;
-	cli::Parse(value, input);
+	T value = MakeElement<T>(set.get_allocator());
+	if(!cli::Parse(value, input))
+	{
+		return false;
+	}
 	(void)set.insert(std::move(value));
+	return true;
 }
 
 
-template <typename Key, typename T, typename Compare, typename Allocator>
-void Parse(std::map<Key, T, Compare, Allocator> &map, const char *input)
+template <
+    typename Key,
+    typename T,
+    typename Compare,
+    typename Allocator,
+    typename Input>
+bool Parse(std::map<Key, T, Compare, Allocator> &map, Input input)
 {
-	Key key;
-	T value;
-	const char *const end = input + std::strlen(input);
-	const char *const equal = std::find(input, end, '=');
-	if(equal == end)
+	Key key = MakeElement<Key>(map.get_allocator());
+	T value = MakeElement<T>(map.get_allocator());
+	if(!ParseEntry(key, value, input))
 	{
-		throw std::invalid_argument(
-		    "Command line argument not in <key>=<value> form");
+		return false;
 	}
-	cli::Parse(key, std::string(input, equal - input).c_str());
-	cli::Parse(value, equal + 1);
 	(void)map.insert_or_assign(std::move(key), std::move(value));
+	return true;
 }
 
 
@@ -133,23 +364,20 @@ template <
     typename T,
     typename Hash,
     typename Equal,
-    typename Allocator>
-void Parse(
+    typename Allocator,
+    typename Input>
+bool Parse(
     std::unordered_map<Key, T, Hash, Equal, Allocator> &map,
-    const char *input)
+    Input input)
 {
-	Key key;
-	T value;
-	const char *const end = input + std::strlen(input);
-	const char *const equal = std::find(input, end, '=');
-	if(equal == end)
+	Key key = MakeElement<Key>(map.get_allocator());
+	T value = MakeElement<T>(map.get_allocator());
+	if(!ParseEntry(key, value, input))
 	{
-		throw std::invalid_argument(
-		    "Command line argument not in <key>=<value> form");
+		return false;
 	}
-	cli::Parse(key, std::string(input, equal - input).c_str());
-	cli::Parse(value, equal + 1);
 	(void)map.insert_or_assign(std::move(key), std::move(value));
+	return true;
 }
 
 
@@ -1,7 +1,20 @@
 #pragma once
 
+#include "cli/details/Lazy_fwd.hpp"
 #include "cli/details/Parse_fwd.hpp"
 
+#include <array>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 
 namespace cli
 {
@@ -14,7 +27,10 @@ namespace details
 /// @brief Detector for user defined parse functions.
 /// @details A user defined parse function has the highest priority within
 /// cli::Parse().  The signature of these functions are
-/// "void CLIParse(T &, const char *)".
+/// "void CLIParse(T &, const char *)" or
+/// "void CLIParse(T &, std::string_view)".  Parsers that can not throw may
+/// return bool instead, false meaning the input was invalid.  Either
+/// signature is detected as a string view converts from a const char *.
 template <typename T> struct HasUserDefinedParse
 {
 private:
@@ -40,16 +56,46 @@ template <typename T>
 constexpr bool HasUserDefinedParse_v = HasUserDefinedParse<T>::value;
 
 
+/// @brief Detector for user defined parse functions that take a string view,
+/// "void CLIParse(T &, std::string_view)".
+/// @details These parse sub-ranges of a value, such as the key of a map or
+/// an element of a list, without copying them.
+template <typename T> struct HasUserDefinedViewParse
+{
+private:
+	template <typename U>
+	static constexpr decltype(
+	    CLIParse(std::declval<U &>(), std::declval<std::string_view>()),
+	    bool())
+	Test(int)
+	{
+		return true;
+	}
+
+	template <typename U> static constexpr bool Test(...)
+	{
+		return false;
+	}
+
+public:
+	static constexpr bool value = Test<T>(int());
+};
+
+template <typename T>
+constexpr bool HasUserDefinedViewParse_v = HasUserDefinedViewParse<T>::value;
+
+
 /// @brief Detector for an internal parse function.
 /// @details These parse functions have the signature
-/// "void cli::details::Parse(T &, const char *)" and are considered if
+/// "bool cli::details::Parse(T &, std::string_view)" and are considered if
 /// no suitable user defined parser exists.
 template <typename T> struct HasInternalParse
 {
 private:
 	template <typename U>
 	static constexpr decltype(
-	    cli::details::Parse(std::declval<U &>(), std::declval<const char *>()),
+	    cli::details::Parse(
+	        std::declval<U &>(), std::declval<std::string_view>()),
 	    bool())
 	Test(int)
 	{
@@ -97,6 +143,62 @@ template <typename T>
 constexpr bool HasStreamExtraction_v = HasStreamExtraction<T>::value;
 
 
+/// @brief Detector for destinations that refer to the string they were parsed
+/// from instead of copying it, std::string_view, const char *, cli::Lazy and
+/// containers of them.
+/// @details Such destinations are only valid as long as the strings of the
+/// run that filled them, see cli::CommandLine for how long that is.
+template <typename T> struct RefersToInput : std::false_type
+{};
+
+template <> struct RefersToInput<std::string_view> : std::true_type
+{};
+
+template <> struct RefersToInput<const char *> : std::true_type
+{};
+
+// lazy values keep the strings until they are converted
+template <typename T> struct RefersToInput<Lazy<T>> : std::true_type
+{};
+
+template <typename T>
+struct RefersToInput<std::optional<T>> : RefersToInput<T>
+{};
+
+template <typename T, std::size_t N>
+struct RefersToInput<std::array<T, N>> : RefersToInput<T>
+{};
+
+template <typename T, std::size_t N>
+struct RefersToInput<T[N]> : RefersToInput<T>
+{};
+
+template <typename T, typename... Rest>
+struct RefersToInput<std::vector<T, Rest...>> : RefersToInput<T>
+{};
+
+template <typename T, typename... Rest>
+struct RefersToInput<std::set<T, Rest...>> : RefersToInput<T>
+{};
+
+template <typename T, typename... Rest>
+struct RefersToInput<std::unordered_set<T, Rest...>> : RefersToInput<T>
+{};
+
+template <typename Key, typename T, typename... Rest>
+struct RefersToInput<std::map<Key, T, Rest...>>
+    : std::bool_constant<RefersToInput<Key>::value || RefersToInput<T>::value>
+{};
+
+template <typename Key, typename T, typename... Rest>
+struct RefersToInput<std::unordered_map<Key, T, Rest...>>
+    : std::bool_constant<RefersToInput<Key>::value || RefersToInput<T>::value>
+{};
+
+template <typename T>
+constexpr bool RefersToInput_v = RefersToInput<T>::value;
+
+
 } // namespace details
 
 
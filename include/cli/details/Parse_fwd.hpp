@@ -6,6 +6,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -15,45 +16,81 @@ namespace cli
 {
 
 
-template <typename T> void Parse(T &value, const char *input);
+template <typename T> bool Parse(T &value, const char *input);
+
+template <typename T> bool Parse(T &value, std::string_view input);
 
 
 namespace details
 {
 
 
-inline void Parse(std::string &string, const char *input);
+/// @brief Gets if T is parsed as a number, all arithmetic types except bool
+/// and character types, which are parsed by stream extraction.
+template <typename T>
+constexpr bool IsNumber_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+    && !std::is_same_v<T, char> && !std::is_same_v<T, signed char>
+    && !std::is_same_v<T, unsigned char> && !std::is_same_v<T, wchar_t>
+    && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+template <typename T>
+std::enable_if_t<IsNumber_v<T>, bool>
+Parse(T &number, std::string_view input);
+
+template <typename Allocator>
+bool Parse(
+    std::basic_string<char, std::char_traits<char>, Allocator> &string,
+    std::string_view input);
+
+inline bool Parse(std::string_view &view, std::string_view input);
 
-template <std::size_t N> void Parse(char (&array)[N], const char *input);
+inline bool Parse(const char *&string, const char *input);
+
+inline bool Parse(const char *&string, std::string_view input);
+
+template <std::size_t N> bool Parse(char (&array)[N], std::string_view input);
 
 template <std::size_t N>
-void Parse(std::array<char, N> &array, const char *input);
+bool Parse(std::array<char, N> &array, std::string_view input);
+
+// parsers of containers forward their input, a const char * or a string view,
+// to the parser of their elements in the form they were given it
 
-template <typename T> void Parse(std::optional<T> &optional, const char *input);
+template <typename T, typename Input>
+bool Parse(std::optional<T> &optional, Input input);
 
-template <typename T, typename Allocator>
-void Parse(std::vector<T, Allocator> &vector, const char *input);
+template <typename T, typename Allocator, typename Input>
+bool Parse(std::vector<T, Allocator> &vector, Input input);
 
-template <typename T, typename Allocator>
-void Parse(std::set<T, Allocator> &set, const char *input);
+template <typename T, typename Compare, typename Allocator, typename Input>
+bool Parse(std::set<T, Compare, Allocator> &set, Input input);
 
-template <typename T, typename Hash, typename Equal, typename Allocator>
-void Parse(
-    std::unordered_set<T, Hash, Equal, Allocator> &set,
-    const char *input);
+template <
+    typename T,
+    typename Hash,
+    typename Equal,
+    typename Allocator,
+    typename Input>
+bool Parse(std::unordered_set<T, Hash, Equal, Allocator> &set, Input input);
 
-template <typename Key, typename T, typename Compare, typename Allocator>
-void Parse(std::map<Key, T, Compare, Allocator> &map, const char *input);
+template <
+    typename Key,
+    typename T,
+    typename Compare,
+    typename Allocator,
+    typename Input>
+bool Parse(std::map<Key, T, Compare, Allocator> &map, Input input);
 
 template <
     typename Key,
     typename T,
     typename Hash,
     typename Equal,
-    typename Allocator>
-void Parse(
+    typename Allocator,
+    typename Input>
+bool Parse(
     std::unordered_map<Key, T, Hash, Equal, Allocator> &map,
-    const char *input);
+    Input input);
 
 
 } // namespace details
@@ -0,0 +1,177 @@
+/// @file
+/// @brief Contains a compile time perfect hash for argument names.
+#pragma once
+
+#include "cli/details/FlagTable.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Gets the smallest power of two that is at least a given value.
+constexpr std::size_t NextPowerOfTwo(std::size_t value) noexcept
+{
+	std::size_t power = 1;
+	while(power < value)
+	{
+		power *= 2;
+	}
+	return power;
+}
+
+
+/// @brief Perfect hash from a fixed set of names to their indices.
+/// @details Uses hash and displace: a name's hash selects a bucket and the
+/// bucket's displacement is mixed into the hash to select a slot.  The
+/// displacements are chosen when the table is built so that no two names share
+/// a slot.  A lookup is one hash of the input and two array reads, the caller
+/// must still compare the input with the name at the returned index.
+/// @tparam Count The number of names, including unused (empty) names.
+template <std::size_t Count> class PerfectHash
+{
+public:
+	static constexpr std::size_t bucketCount = NextPowerOfTwo(Count);
+	static constexpr std::size_t slotCount = NextPowerOfTwo(2 * Count);
+
+	/// @brief Builds the table.
+	/// @param names The names to hash.  Empty names are not inserted.  Must not
+	/// contain duplicates.
+	constexpr explicit PerfectHash(
+	    const std::array<std::string_view, Count> &names)
+	    : _displacements()
+	    , _slots()
+	    , _valid(true)
+	{
+		std::array<std::size_t, Count> hashes{};
+		std::array<std::size_t, bucketCount> bucketSizes{};
+		std::size_t maxBucketSize = 0;
+		for(std::size_t i = 0; i < Count; ++i)
+		{
+			if(!names[i].empty())
+			{
+				hashes[i] = FlagTable::Hash(names[i]);
+				const std::size_t bucket = Bucket(hashes[i]);
+				bucketSizes[bucket]++;
+				if(bucketSizes[bucket] > maxBucketSize)
+				{
+					maxBucketSize = bucketSizes[bucket];
+				}
+			}
+		}
+
+		// place the largest buckets first while the table is emptiest
+		for(std::size_t size = maxBucketSize; size != 0; --size)
+		{
+			for(std::size_t bucket = 0; bucket < bucketCount; ++bucket)
+			{
+				if(bucketSizes[bucket] == size
+				   && !Place(names, hashes, bucket))
+				{
+					_valid = false;
+					return;
+				}
+			}
+		}
+	}
+
+	/// @brief Gets if a table could be built for the names.
+	constexpr bool IsValid() const noexcept
+	{
+		return _valid;
+	}
+
+	/// @brief Gets the index of the only name that could have a hash.
+	/// @param hash The FlagTable::Hash() of the input.
+	/// @returns The index or FlagTable::npos if no name can match.
+	constexpr std::size_t Find(std::size_t hash) const noexcept
+	{
+		const std::size_t slot =
+		    Slot(hash, _displacements[Bucket(hash)]) & (slotCount - 1);
+		return _slots[slot] - 1;
+	}
+
+private:
+	static constexpr std::size_t Bucket(std::size_t hash) noexcept
+	{
+		return static_cast<std::size_t>(
+		           static_cast<std::uint64_t>(hash) >> 40)
+		    & (bucketCount - 1);
+	}
+
+	static constexpr std::size_t
+	Slot(std::size_t hash, std::uint32_t displacement) noexcept
+	{
+		std::uint64_t mixed = static_cast<std::uint64_t>(hash)
+		    ^ (displacement * 0x9E3779B97F4A7C15ULL);
+		mixed ^= mixed >> 29;
+		mixed *= 0xBF58476D1CE4E5B9ULL;
+		mixed ^= mixed >> 32;
+		return static_cast<std::size_t>(mixed);
+	}
+
+	// finds a displacement for all names in a bucket
+	constexpr bool Place(
+	    const std::array<std::string_view, Count> &names,
+	    const std::array<std::size_t, Count> &hashes,
+	    std::size_t bucket)
+	{
+		constexpr std::uint32_t maxDisplacement = 1U << 20;
+		for(std::uint32_t displacement = 0; displacement < maxDisplacement;
+		    ++displacement)
+		{
+			std::array<std::size_t, Count> chosen{};
+			std::size_t chosenCount = 0;
+			bool fits = true;
+			for(std::size_t i = 0; i < Count && fits; ++i)
+			{
+				if(names[i].empty() || Bucket(hashes[i]) != bucket)
+				{
+					continue;
+				}
+				const std::size_t slot =
+				    Slot(hashes[i], displacement) & (slotCount - 1);
+				fits = _slots[slot] == 0;
+				for(std::size_t j = 0; j < chosenCount && fits; ++j)
+				{
+					fits = chosen[j] != slot;
+				}
+				chosen[chosenCount++] = slot;
+			}
+			if(fits)
+			{
+				_displacements[bucket] = displacement;
+				chosenCount = 0;
+				for(std::size_t i = 0; i < Count; ++i)
+				{
+					if(!names[i].empty() && Bucket(hashes[i]) == bucket)
+					{
+						_slots[chosen[chosenCount++]] = i + 1;
+					}
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+
+	std::array<std::uint32_t, bucketCount> _displacements;
+	// argument index plus one, zero for an empty slot
+	std::array<std::size_t, slotCount> _slots;
+	bool _valid;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -0,0 +1,117 @@
+/// @file
+/// @brief Contains cli::details::PrefixTable.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Immutable table of flag names sorted for prefix lookups.
+/// @details Names that start with a prefix are adjacent in a sorted array,
+/// so a lookup is one binary search and looking at the next name.  Names are
+/// not copied, the strings they refer to must outlive the table.
+class PrefixTable
+{
+public:
+	/// @brief Index returned by Find() when no name starts with a prefix.
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	/// @brief The result of Find().
+	struct Match
+	{
+		/// @brief The index of the only name starting with the prefix, or
+		/// npos.
+		std::size_t index = npos;
+		/// @brief When more than one name starts with the prefix, the first
+		/// two of them in sorted order.  Null otherwise.
+		const char *first = nullptr;
+		const char *second = nullptr;
+	};
+
+	/// @brief Constructs an empty table.
+	explicit PrefixTable(
+	    std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+	    : _entries(resource)
+	{}
+
+	/// @brief Reserves room for a number of names.
+	void Reserve(std::size_t count)
+	{
+		_entries.reserve(count);
+	}
+
+	/// @brief Adds a name, Sort() must be called before the next Find().
+	/// @param name The name, which must be null terminated.
+	void Insert(std::string_view name, std::size_t index)
+	{
+		_entries.push_back(Entry{name, index});
+	}
+
+	/// @brief Sorts the names added by Insert().
+	void Sort()
+	{
+		std::sort(
+		    _entries.begin(),
+		    _entries.end(),
+		    [](const Entry &left, const Entry &right) {
+			    return left.name < right.name;
+		    });
+	}
+
+	/// @brief Finds the names starting with a prefix.
+	Match Find(std::string_view prefix) const
+	{
+		const auto it = std::lower_bound(
+		    _entries.begin(),
+		    _entries.end(),
+		    prefix,
+		    [](const Entry &entry, std::string_view value) {
+			    return entry.name < value;
+		    });
+		Match match;
+		if(it == _entries.end() || !StartsWith(it->name, prefix))
+		{
+			return match;
+		}
+		const auto next = it + 1;
+		if(next == _entries.end() || !StartsWith(next->name, prefix)
+		   || it->name == prefix)
+		{
+			match.index = it->index;
+			return match;
+		}
+		match.first = it->name.data();
+		match.second = next->name.data();
+		return match;
+	}
+
+private:
+	struct Entry
+	{
+		std::string_view name;
+		std::size_t index;
+	};
+
+	static bool StartsWith(std::string_view name, std::string_view prefix)
+	{
+		return name.substr(0, prefix.size()) == prefix;
+	}
+
+	std::pmr::vector<Entry> _entries;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
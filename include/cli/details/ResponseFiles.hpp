@@ -0,0 +1,254 @@
+/// @file
+/// @brief Contains cli::details::ResponseFiles.
+#pragma once
+
+#include "cli/details/MappedFile.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Expands "@path" arguments into the arguments listed in the file at
+/// path.
+/// @details Response files are mapped into memory and tokenized in place, the
+/// expanded arguments point directly into the mappings.  A file containing a
+/// null character lists arguments separated by null characters, as written by
+/// "find -print0", otherwise arguments are separated by newlines, an optional
+/// carriage return before a newline is ignored and empty lines are skipped.
+/// Arguments of a response file that start with '@' are expanded recursively.
+/// A response file that names itself, directly or through other files, is an
+/// error, as is reading more than maxFiles files in one expansion.
+class ResponseFiles
+{
+public:
+	/// @brief Maximum depth of nested response files.
+	static constexpr std::size_t maxDepth = 32;
+
+	/// @brief Maximum number of response files read by one expansion.
+	/// @details Files may be named more than once, so without this limit a
+	/// few small files could expand exponentially.
+	static constexpr std::size_t maxFiles = 4096;
+
+	/// @brief The reason an expansion failed.
+	enum class Status
+	{
+		OK,
+		UNREADABLE,
+		TOO_DEEP,
+		RECURSIVE,
+		TOO_MANY
+	};
+
+	/// @brief Gets if any argument names a response file.
+	static bool IsNeeded(const char *const *argv, std::size_t argc) noexcept
+	{
+		return std::any_of(argv, argv + argc, [](const char *arg) {
+			return arg != nullptr && arg[0] == '@';
+		});
+	}
+
+	/// @brief Expands arguments, releasing the files of any prior expansion.
+	/// @param argv The arguments.
+	/// @param argc The number of arguments.
+	/// @returns The status of the expansion, GetFailedArgument() gives the
+	/// argument that failed.
+	Status Expand(const char *const *argv, std::size_t argc)
+	{
+		_files.clear();
+		_paths.clear();
+		_arguments.clear();
+		_starts.clear();
+		_open.clear();
+		_failed = nullptr;
+		_starts.reserve(argc);
+		for(std::size_t i = 0; i < argc; ++i)
+		{
+			_starts.push_back(_arguments.size());
+			const Status status = ExpandArgument(argv[i], 0);
+			if(status != Status::OK)
+			{
+				return status;
+			}
+		}
+		return Status::OK;
+	}
+
+	/// @brief Gets the expanded arguments.
+	const char *const *GetArguments() const noexcept
+	{
+		return _arguments.data();
+	}
+
+	/// @brief Gets the number of expanded arguments.
+	std::size_t GetCount() const noexcept
+	{
+		return _arguments.size();
+	}
+
+	/// @brief Gets the index of the argument given to Expand() that an
+	/// expanded argument came from.
+	std::size_t GetOrigin(std::size_t index) const noexcept
+	{
+		return static_cast<std::size_t>(
+		    std::upper_bound(_starts.begin(), _starts.end(), index)
+		    - _starts.begin() - 1);
+	}
+
+	/// @brief Gets the number of response files read by the last expansion.
+	std::size_t GetFileCount() const noexcept
+	{
+		return _files.size();
+	}
+
+	/// @brief Gets the path of a response file read by the last expansion.
+	const char *GetPath(std::size_t index) const noexcept
+	{
+		return _paths[index];
+	}
+
+	/// @brief Gets a response file read by the last expansion.
+	const MappedFile &GetFile(std::size_t index) const noexcept
+	{
+		return _files[index];
+	}
+
+	/// @brief Gets the argument naming the response file that could not be
+	/// expanded.
+	const char *GetFailedArgument() const noexcept
+	{
+		return _failed;
+	}
+
+private:
+	Status ExpandArgument(const char *arg, std::size_t depth)
+	{
+		if(arg == nullptr || arg[0] != '@')
+		{
+			_arguments.push_back(arg);
+			return Status::OK;
+		}
+		if(depth == maxDepth)
+		{
+			_failed = arg;
+			return Status::TOO_DEEP;
+		}
+		if(_files.size() == maxFiles)
+		{
+			_failed = arg;
+			return Status::TOO_MANY;
+		}
+		MappedFile file;
+		if(!file.Open(arg + 1))
+		{
+			_failed = arg;
+			return Status::UNREADABLE;
+		}
+		if(IsOpen(file, arg + 1))
+		{
+			_failed = arg;
+			return Status::RECURSIVE;
+		}
+		char *const begin = file.GetData();
+		char *const end = begin + file.GetSize();
+		_open.push_back(_files.size());
+		_files.push_back(std::move(file));
+		_paths.push_back(arg + 1);
+		const Status status = ExpandFile(begin, end, depth);
+		_open.pop_back();
+		return status;
+	}
+
+	// expands the arguments listed in the contents of a response file
+	Status ExpandFile(char *begin, char *end, std::size_t depth)
+	{
+		if(std::memchr(begin, '\0', end - begin) != nullptr)
+		{
+			// the file is already null terminated, the mapping is only read
+			for(char *token = begin; token < end;
+			    token += std::strlen(token) + 1)
+			{
+				const Status status = ExpandArgument(token, depth + 1);
+				if(status != Status::OK)
+				{
+					return status;
+				}
+			}
+			return Status::OK;
+		}
+
+		char *token = begin;
+		while(token < end)
+		{
+			char *newline =
+			    static_cast<char *>(std::memchr(token, '\n', end - token));
+			if(newline == nullptr)
+			{
+				// the file mapping is followed by a null character
+				newline = end;
+			}
+			char *tokenEnd = newline;
+			if(tokenEnd != token && tokenEnd[-1] == '\r')
+			{
+				--tokenEnd;
+			}
+			if(tokenEnd != token)
+			{
+				if(tokenEnd != end)
+				{
+					*tokenEnd = '\0';
+				}
+				const Status status = ExpandArgument(token, depth + 1);
+				if(status != Status::OK)
+				{
+					return status;
+				}
+			}
+			token = newline + 1;
+		}
+		return Status::OK;
+	}
+
+	// gets if a file is one of the response files being expanded
+	bool IsOpen(const MappedFile &file, const char *path) const noexcept
+	{
+		FileStamp stamp;
+		const bool hasStamp = file.GetStamp(stamp);
+		return std::any_of(_open.begin(), _open.end(), [&](std::size_t i) {
+			FileStamp other;
+			if(hasStamp && _files[i].GetStamp(other))
+			{
+				return stamp.device == other.device
+				    && stamp.inode == other.inode;
+			}
+			// without stamps different paths to the same file are missed,
+			// the depth limit then stops the expansion
+			return std::strcmp(_paths[i], path) == 0;
+		});
+	}
+
+	// keeps expanded arguments alive
+	std::vector<MappedFile> _files;
+	std::vector<const char *> _paths;
+	std::vector<const char *> _arguments;
+	// index in _arguments of the first argument from each argument of argv
+	std::vector<std::size_t> _starts;
+	// indices in _files of the files being expanded, outermost first
+	std::vector<std::size_t> _open;
+	const char *_failed = nullptr;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -0,0 +1,77 @@
+/// @file
+/// @brief Contains cli::details::ShortFlagTable.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Immutable lookup table from single character flag names to
+/// argument indices.
+/// @details Indexed directly by the character, so a lookup is one load with
+/// no hashing or comparing of strings.  Only ASCII characters can be names.
+class ShortFlagTable
+{
+public:
+	/// @brief Index returned by Find() when a name is not in the table.
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	/// @brief The number of characters that can be names.
+	static constexpr std::size_t size = 128;
+
+	/// @brief Constructs an empty table.
+	ShortFlagTable() noexcept
+	{
+		_indices.fill(empty);
+	}
+
+	/// @brief Gets if a character can be a name.
+	static constexpr bool IsValid(char name) noexcept
+	{
+		return static_cast<unsigned char>(name) < size && name != '\0';
+	}
+
+	/// @brief Adds a name to this table.
+	/// @details If the name is already present the first index is kept.
+	/// @pre IsValid(name).
+	void Insert(char name, std::size_t index) noexcept
+	{
+		std::uint32_t &slot = _indices[static_cast<unsigned char>(name)];
+		if(slot == empty)
+		{
+			slot = static_cast<std::uint32_t>(index);
+		}
+	}
+
+	/// @brief Finds the index associated with a name.
+	/// @returns The index or npos if the name is not in this table.
+	std::size_t Find(char name) const noexcept
+	{
+		const unsigned char key = static_cast<unsigned char>(name);
+		if(key >= size || _indices[key] == empty)
+		{
+			return npos;
+		}
+		return _indices[key];
+	}
+
+private:
+	static constexpr std::uint32_t empty = static_cast<std::uint32_t>(-1);
+
+	std::array<std::uint32_t, size> _indices;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
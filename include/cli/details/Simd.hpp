@@ -0,0 +1,45 @@
+/// @file
+/// @brief Selects the vector instructions used to scan strings.
+/// @details CLI_SIMD_AVX2 or CLI_SIMD_SSE2 is defined when the compiler
+/// targets AVX2 or SSE2, scanners fall back to a byte at a time otherwise.
+#pragma once
+
+#if defined(__AVX2__)
+#define CLI_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLI_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Gets the index of the lowest set bit of a non-zero mask.
+inline unsigned CountTrailingZeros(unsigned mask) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+
+} // namespace details
+
+
+} // namespace cli
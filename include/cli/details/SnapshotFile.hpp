@@ -0,0 +1,206 @@
+/// @file
+/// @brief Contains cli::details::SnapshotFile.
+#pragma once
+
+#include "cli/Serialize.hpp"
+#include "cli/details/MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Hashes bytes, a word at a time.
+/// @details Not a cryptographic hash, it only detects changes.
+inline std::uint64_t
+HashBytes(const void *data, std::size_t size, std::uint64_t seed) noexcept
+{
+	constexpr std::uint64_t prime = 0x100000001b3;
+	const unsigned char *bytes = static_cast<const unsigned char *>(data);
+	std::uint64_t hash = seed ^ (size * prime);
+	for(; size >= sizeof(std::uint64_t); size -= sizeof(std::uint64_t))
+	{
+		std::uint64_t word;
+		std::memcpy(&word, bytes, sizeof(word));
+		bytes += sizeof(word);
+		hash = (hash ^ word) * prime;
+		hash ^= hash >> 32;
+	}
+	for(; size != 0; --size)
+	{
+		hash = (hash ^ *bytes++) * prime;
+	}
+	return hash ^ (hash >> 29);
+}
+
+/// @brief Hashes a string, including its size.
+inline std::uint64_t
+HashString(std::string_view string, std::uint64_t seed) noexcept
+{
+	return HashBytes(string.data(), string.size(), seed);
+}
+
+
+/// @brief Reads and writes snapshot files, which cache the values of a run.
+/// @details A snapshot starts with a header:
+///   - a magic number, which also detects a different byte order.
+///   - the checksum of everything after it.
+///   - the hash of the arguments of the command line that wrote it.
+///   - the hash of the inputs of the run, such as its argv.
+///   - the path and FileStamp of each file the run read.
+///
+/// The values of the run follow, written by cli::Serialize().  A snapshot is
+/// only used if every part of its header matches, which is checked before
+/// any value is read.
+class SnapshotFile
+{
+public:
+	/// @brief Opens a snapshot and checks that it was written by a run of the
+	/// same command line with the same inputs.
+	/// @details The snapshot stays mapped, and strings read from it valid,
+	/// until this is opened again or destroyed.
+	/// @param path The path of the snapshot.
+	/// @param layout The hash of the arguments of the command line.
+	/// @param input The hash of the inputs of the run.
+	/// @returns False if the snapshot can not be read, is corrupt, or does not
+	/// match.  Otherwise GetReader() is at the start of the values.
+	bool Open(const char *path, std::uint64_t layout, std::uint64_t input)
+	{
+		if(!_file.Open(path) || _file.GetSize() < headerSize)
+		{
+			return false;
+		}
+		const char *const begin = _file.GetData();
+		const char *const end = begin + _file.GetSize();
+		std::uint64_t header[headerWords];
+		std::memcpy(header, begin, sizeof(header));
+		const std::uint64_t checksum = HashBytes(
+		    begin + checkedOffset, _file.GetSize() - checkedOffset, 0);
+		if(header[0] != magic || header[1] != checksum || header[2] != layout
+		   || header[3] != input)
+		{
+			return false;
+		}
+
+		_reader = SnapshotReader(begin + headerSize, end);
+		std::size_t fileCount;
+		if(!_reader.ReadSize(fileCount))
+		{
+			return false;
+		}
+		for(std::size_t i = 0; i < fileCount; ++i)
+		{
+			std::string_view filePath;
+			FileStamp saved;
+			FileStamp current;
+			if(!_reader.ReadString(filePath)
+			   || !_reader.Read(&saved, sizeof(saved))
+			   || !GetFileStamp(filePath.data(), current) || saved != current)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// @brief Gets the reader of the values of the open snapshot.
+	SnapshotReader &GetReader() noexcept
+	{
+		return _reader;
+	}
+
+	/// @brief Starts writing a snapshot, discarding any started before.
+	/// @param layout The hash of the arguments of the command line.
+	/// @param input The hash of the inputs of the run.
+	/// @param fileCount The number of files that AddFile() will be called
+	/// with.
+	void Start(std::uint64_t layout, std::uint64_t input, std::size_t fileCount)
+	{
+		const std::uint64_t header[headerWords] = {magic, 0, layout, input};
+		_writer.Clear();
+		_writer.Write(header, sizeof(header));
+		_writer.WriteSize(fileCount);
+	}
+
+	/// @brief Adds a file that the run read.
+	void AddFile(const char *path, const FileStamp &stamp)
+	{
+		_writer.WriteString(path);
+		_writer.Write(&stamp, sizeof(stamp));
+	}
+
+	/// @brief Gets the writer that the values of the run are written to after
+	/// the files were added.
+	SnapshotWriter &GetWriter() noexcept
+	{
+		return _writer;
+	}
+
+	/// @brief Writes the started snapshot to a file.
+	/// @details The snapshot is written to a temporary file next to path that
+	/// then replaces it, so a reader never sees a partial snapshot.
+	/// @returns False if the file could not be written.
+	bool Save(const char *path)
+	{
+		const std::string &data = _writer.GetData();
+		const std::size_t checkedSize = data.size() - checkedOffset;
+		const std::uint64_t checksum =
+		    HashBytes(data.data() + checkedOffset, checkedSize, 0);
+
+		const std::string temporary = std::string(path) + ".tmp";
+		std::FILE *file = std::fopen(temporary.c_str(), "wb");
+		if(file == nullptr)
+		{
+			return false;
+		}
+		// the checksum is written in place of the zero that Start() wrote
+		const bool isWritten = std::fwrite(&magic, sizeof(magic), 1, file) == 1
+		    && std::fwrite(&checksum, sizeof(checksum), 1, file) == 1
+		    && std::fwrite(data.data() + checkedOffset, 1, checkedSize, file)
+		        == checkedSize;
+		if(std::fclose(file) != 0 || !isWritten)
+		{
+			std::remove(temporary.c_str());
+			return false;
+		}
+		// renaming over an existing file fails on some systems
+		if(std::rename(temporary.c_str(), path) != 0
+		   && (std::remove(path) != 0
+		       || std::rename(temporary.c_str(), path) != 0))
+		{
+			std::remove(temporary.c_str());
+			return false;
+		}
+		return true;
+	}
+
+private:
+	// "CLISNAP1" read as a little endian number
+	static constexpr std::uint64_t magic = 0x3150414e53494c43;
+	static constexpr std::size_t headerWords = 4;
+	static constexpr std::size_t headerSize =
+	    headerWords * sizeof(std::uint64_t);
+	// the checksum covers everything after the magic number and itself
+	static constexpr std::size_t checkedOffset = 2 * sizeof(std::uint64_t);
+
+	MappedFile _file;
+	SnapshotReader _reader;
+	SnapshotWriter _writer;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
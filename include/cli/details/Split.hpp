@@ -0,0 +1,86 @@
+/// @file
+/// @brief Contains the functions that split list values into elements.
+#pragma once
+
+#include "cli/details/Simd.hpp"
+
+#include <cstddef>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Calls function(position) for every separator in [begin, end) in
+/// order.
+/// @details Separators are found 16 or 32 bytes at a time with SSE2 or AVX2
+/// when the compiler targets them, all separators in a block are visited
+/// from one comparison mask.
+template <typename Function>
+void ForEachSeparator(
+    const char *begin,
+    const char *end,
+    char separator,
+    Function &&function)
+{
+#if defined(CLI_SIMD_AVX2)
+	const __m256i wanted = _mm256_set1_epi8(separator);
+	for(; end - begin >= 32; begin += 32)
+	{
+		const __m256i chunk =
+		    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+		unsigned mask = static_cast<unsigned>(
+		    _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, wanted)));
+		for(; mask != 0; mask &= mask - 1)
+		{
+			function(begin + CountTrailingZeros(mask));
+		}
+	}
+#elif defined(CLI_SIMD_SSE2)
+	const __m128i wanted = _mm_set1_epi8(separator);
+	for(; end - begin >= 16; begin += 16)
+	{
+		const __m128i chunk =
+		    _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+		unsigned mask = static_cast<unsigned>(
+		    _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, wanted)));
+		for(; mask != 0; mask &= mask - 1)
+		{
+			function(begin + CountTrailingZeros(mask));
+		}
+	}
+#endif
+	for(; begin != end; ++begin)
+	{
+		if(*begin == separator)
+		{
+			function(begin);
+		}
+	}
+}
+
+
+/// @brief Gets the number of elements in a list.
+/// @details An empty list has no elements, otherwise there is one more
+/// element than there are separators.
+inline std::size_t
+CountElements(const char *begin, const char *end, char separator)
+{
+	if(begin == end)
+	{
+		return 0;
+	}
+	std::size_t count = 1;
+	ForEachSeparator(begin, end, separator, [&](const char *) { ++count; });
+	return count;
+}
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -0,0 +1,287 @@
+/// @file
+/// @brief Contains the functions that store runs of values into containers,
+/// optionally converting them on the threads of a cli::ThreadPool.
+#pragma once
+
+#include "cli/Parse.hpp"
+#include "cli/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief Detector for std::vector destinations that store runs of values at
+/// once, which excludes the std::vector<bool> specialization.
+template <typename T> struct IsVector : std::false_type
+{};
+
+template <typename T, typename Allocator>
+struct IsVector<std::vector<T, Allocator>>
+    : std::bool_constant<!std::is_same_v<T, bool>>
+{};
+
+template <typename T> constexpr bool IsVector_v = IsVector<T>::value;
+
+
+/// @brief Detector for std::set and std::unordered_set destinations.
+template <typename T> struct IsSet : std::false_type
+{};
+
+template <typename T, typename... Rest>
+struct IsSet<std::set<T, Rest...>> : std::true_type
+{};
+
+template <typename T, typename... Rest>
+struct IsSet<std::unordered_set<T, Rest...>> : std::true_type
+{};
+
+template <typename T> constexpr bool IsSet_v = IsSet<T>::value;
+
+
+/// @brief Detector for std::map and std::unordered_map destinations.
+template <typename T> struct IsMap : std::false_type
+{};
+
+template <typename Key, typename T, typename... Rest>
+struct IsMap<std::map<Key, T, Rest...>> : std::true_type
+{};
+
+template <typename Key, typename T, typename... Rest>
+struct IsMap<std::unordered_map<Key, T, Rest...>> : std::true_type
+{};
+
+template <typename T> constexpr bool IsMap_v = IsMap<T>::value;
+
+
+/// @brief Gets if runs of values can be stored to a T with StoreRun().
+template <typename T>
+constexpr bool CanStoreRuns_v = IsVector_v<T> || IsSet_v<T> || IsMap_v<T>;
+
+
+/// @brief Removes the last element of a vector unless dismissed.
+template <typename Vector> struct PopBackGuard
+{
+	Vector &vector;
+	bool isDismissed = false;
+
+	~PopBackGuard()
+	{
+		if(!isDismissed)
+		{
+			vector.pop_back();
+		}
+	}
+};
+
+
+/// @brief Runs shorter than this are not split between threads.
+constexpr std::size_t parallelRunLength = 16 * 1024;
+
+/// @brief The number of values each thread converts at a time.
+constexpr std::size_t parallelChunkLength = 4 * 1024;
+
+
+// parses one value of a run into an element, never throws
+template <typename Element, typename Parser>
+bool TryParseElement(Element &element, const char *value, Parser &parser)
+{
+#ifdef CLI_NO_EXCEPTIONS
+	return parser(element, value);
+#else
+	try
+	{
+		return parser(element, value);
+	}
+	catch(...)
+	{
+		return false;
+	}
+#endif
+}
+
+
+/// @brief Parses the values of a run into a range of elements on the threads
+/// of a pool.
+/// @details Chunks after a failure are skipped, a chunk that was already
+/// started when a failure was found is finished.
+/// @returns The index of the first value that failed, or count.
+template <typename Element, typename Parser>
+std::size_t ParseInParallel(
+    Element *elements,
+    const char *const *values,
+    std::size_t count,
+    ThreadPool &pool,
+    Parser &&parser)
+{
+	std::atomic<std::size_t> firstFailure{count};
+	const std::size_t chunks =
+	    (count + parallelChunkLength - 1) / parallelChunkLength;
+	pool.ForEach(chunks, [&](std::size_t chunk, std::size_t) {
+		const std::size_t begin = chunk * parallelChunkLength;
+		const std::size_t end = std::min(count, begin + parallelChunkLength);
+		if(begin > firstFailure.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+		for(std::size_t i = begin; i < end; ++i)
+		{
+			if(!TryParseElement(elements[i], values[i], parser))
+			{
+				std::size_t failure = firstFailure.load();
+				while(i < failure
+				      && !firstFailure.compare_exchange_weak(failure, i))
+				{}
+				return;
+			}
+		}
+	});
+	return firstFailure.load();
+}
+
+
+/// @brief Parses and stores a run of values into a container one at a time.
+template <typename T>
+bool StoreRunSequential(
+    T &container,
+    const char *const *values,
+    std::size_t count,
+    std::size_t &stored)
+{
+	if constexpr(IsVector_v<T>)
+	{
+		const std::size_t size = container.size() + count - stored;
+		if(size > container.capacity())
+		{
+			// keep growth geometric when many short runs are stored
+			container.reserve(std::max(size, 2 * container.capacity()));
+		}
+		for(; stored < count; ++stored)
+		{
+			// parse straight into the new element rather than moving in a
+			// temporary
+			PopBackGuard<T> guard{container};
+			if(!cli::Parse(container.emplace_back(), values[stored]))
+			{
+				return false;
+			}
+			guard.isDismissed = true;
+		}
+	}
+	else
+	{
+		for(; stored < count; ++stored)
+		{
+			if(!cli::Parse(container, values[stored]))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+/// @brief Parses and stores a run of values into a container.
+/// @details With a pool of more than one thread long runs are converted in
+/// parallel.  Vectors are grown once and each value is parsed in place, sets
+/// and maps parse into a temporary vector of elements.  Elements are then
+/// added in the order of their values, so the result is the same as storing
+/// the values one at a time.  The values from the first failure on are
+/// stored one at a time on the calling thread, which reports the failure as
+/// a sequential store would.
+/// @param container The destination.
+/// @param values The values to parse.
+/// @param count The number of values.
+/// @param[out] stored The number of values stored, the index of the failing
+/// value on failure.
+/// @param pool The pool to convert on, may be null.
+/// @returns True on success.  On failure the exception thrown by the parser
+/// propagates, or when exceptions are disabled false is returned.
+template <typename T>
+bool StoreRun(
+    T &container,
+    const char *const *values,
+    std::size_t count,
+    std::size_t &stored,
+    ThreadPool *pool)
+{
+	stored = 0;
+	if(pool == nullptr || pool->GetSize() < 2 || count < parallelRunLength)
+	{
+		return StoreRunSequential(container, values, count, stored);
+	}
+
+	if constexpr(IsVector_v<T>)
+	{
+		const std::size_t size = container.size();
+		container.resize(size + count);
+		stored = ParseInParallel(
+		    container.data() + size,
+		    values,
+		    count,
+		    *pool,
+		    [](auto &element, const char *value) {
+			    return cli::Parse(element, value);
+		    });
+		container.resize(size + stored);
+	}
+	else if constexpr(IsSet_v<T>)
+	{
+		using Element = typename T::value_type;
+		std::vector<Element> elements(count);
+		stored = ParseInParallel(
+		    elements.data(),
+		    values,
+		    count,
+		    *pool,
+		    [](Element &element, const char *value) {
+			    return cli::Parse(element, value);
+		    });
+		for(std::size_t i = 0; i < stored; ++i)
+		{
+			(void)container.insert(std::move(elements[i]));
+		}
+	}
+	else
+	{
+		using Element =
+		    std::pair<typename T::key_type, typename T::mapped_type>;
+		std::vector<Element> elements(count);
+		stored = ParseInParallel(
+		    elements.data(),
+		    values,
+		    count,
+		    *pool,
+		    [](Element &element, const char *value) {
+			    return ParseEntry(element.first, element.second, value);
+		    });
+		for(std::size_t i = 0; i < stored; ++i)
+		{
+			(void)container.insert_or_assign(
+			    std::move(elements[i].first), std::move(elements[i].second));
+		}
+	}
+	return StoreRunSequential(container, values, count, stored);
+}
+
+
+} // namespace details
+
+
+} // namespace cli
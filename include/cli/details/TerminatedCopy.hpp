@@ -0,0 +1,59 @@
+/// @file
+/// @brief Contains cli::details::TerminatedCopy.
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+/// @brief A null terminated copy of a string view, for parsers that need a
+/// null terminated string.
+/// @details Short strings are copied to a buffer inside this object, only
+/// long strings allocate.
+class TerminatedCopy
+{
+public:
+	explicit TerminatedCopy(std::string_view input)
+	{
+		if(input.size() < sizeof(_small))
+		{
+			std::memcpy(_small, input.data(), input.size());
+			_small[input.size()] = '\0';
+			_data = _small;
+		}
+		else
+		{
+			_large.assign(input.data(), input.size());
+			_data = _large.c_str();
+		}
+	}
+
+	TerminatedCopy(const TerminatedCopy &) = delete;
+	TerminatedCopy &operator=(const TerminatedCopy &) = delete;
+
+	const char *Get() const noexcept
+	{
+		return _data;
+	}
+
+private:
+	char _small[64];
+	std::string _large;
+	const char *_data;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -0,0 +1,340 @@
+/// @file
+/// @brief Contains cli::details::Tokenizer.
+#pragma once
+
+#include "cli/details/Simd.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+
+namespace cli
+{
+
+
+namespace details
+{
+
+
+// the characters that end a run of ordinary characters outside of quotes
+constexpr std::array<bool, 256> MakeTokenizerSpecials() noexcept
+{
+	std::array<bool, 256> specials{};
+	for(const char c : {' ', '\t', '\n', '\v', '\f', '\r', '\'', '"', '\\'})
+	{
+		specials[static_cast<unsigned char>(c)] = true;
+	}
+	return specials;
+}
+
+inline constexpr std::array<bool, 256> tokenizerSpecials =
+    MakeTokenizerSpecials();
+
+
+/// @brief Splits a command string into arguments with POSIX shell quoting
+/// rules.
+/// @details Arguments are separated by whitespace.  Outside of quotes a
+/// backslash escapes the next character.  Single quotes preserve everything
+/// up to the next single quote.  Double quotes preserve everything up to the
+/// next double quote except that a backslash escapes a following '$', '`',
+/// '"', '\' or newline.  An escaped newline is removed.  Nothing is expanded.
+///
+/// Strings are tokenized in place, unquoted arguments are written over the
+/// input and null terminated, so all arguments live in a single buffer.  Runs
+/// of ordinary characters are found 16 or 32 bytes at a time with SSE2 or
+/// AVX2 when the compiler targets them, otherwise a byte at a time.
+class Tokenizer
+{
+public:
+	/// @brief The result of tokenizing.
+	enum class Status
+	{
+		OK,
+		UNTERMINATED_QUOTE,
+		TRAILING_BACKSLASH
+	};
+
+	/// @brief Copies a string into the buffer of this tokenizer and
+	/// tokenizes it.
+	/// @details The buffer is reused, after the first call tokenizing a
+	/// string no longer than any before it does not allocate.
+	Status Tokenize(const char *data, std::size_t size)
+	{
+		_buffer.resize(size + 1);
+		std::memcpy(_buffer.data(), data, size);
+		_buffer[size] = '\0';
+		return TokenizeInPlace(_buffer.data(), _buffer.data() + size);
+	}
+
+	/// @brief Tokenizes a string in place.
+	/// @param begin The start of the string.
+	/// @param end The end of the string.  Must be readable and is
+	/// overwritten with a null character unless it already is one.
+	Status TokenizeInPlace(char *begin, char *end)
+	{
+		_arguments.clear();
+		const char *in = begin;
+		char *out = begin;
+		for(;;)
+		{
+			// escaped newlines between arguments are removed like whitespace
+			for(; in != end; ++in)
+			{
+				if(*in == '\\' && end - in >= 2 && in[1] == '\n')
+				{
+					++in;
+				}
+				else if(!IsSpace(*in))
+				{
+					break;
+				}
+			}
+			if(in == end)
+			{
+				return Status::OK;
+			}
+
+			char *const argument = out;
+			while(in != end && !IsSpace(*in))
+			{
+				const char *const special = FindSpecial(in, end);
+				out = Copy(in, special, out);
+				in = special;
+				if(in == end || IsSpace(*in))
+				{
+					break;
+				}
+
+				const char quote = *in++;
+				if(quote == '\\')
+				{
+					if(in == end)
+					{
+						return Status::TRAILING_BACKSLASH;
+					}
+					if(*in != '\n')
+					{
+						*out++ = *in;
+					}
+					++in;
+				}
+				else if(quote == '\'')
+				{
+					const char *const close = static_cast<const char *>(
+					    std::memchr(in, '\'', end - in));
+					if(close == nullptr)
+					{
+						return Status::UNTERMINATED_QUOTE;
+					}
+					out = Copy(in, close, out);
+					in = close + 1;
+				}
+				else
+				{
+					for(;;)
+					{
+						const char *const close = FindDoubleQuoted(in, end);
+						out = Copy(in, close, out);
+						in = close;
+						if(in == end)
+						{
+							return Status::UNTERMINATED_QUOTE;
+						}
+						if(*in++ == '"')
+						{
+							break;
+						}
+						if(in == end)
+						{
+							return Status::UNTERMINATED_QUOTE;
+						}
+						if(*in == '\n')
+						{
+							++in;
+						}
+						else
+						{
+							if(!IsDoubleQuoteEscape(*in))
+							{
+								*out++ = '\\';
+							}
+							*out++ = *in++;
+						}
+					}
+				}
+			}
+			// the argument is never longer than the input it was read from,
+			// so at worst its terminator overwrites the following separator
+			if(out != end || *end != '\0')
+			{
+				*out = '\0';
+			}
+			++out;
+			_arguments.push_back(argument);
+			if(in != end)
+			{
+				++in;
+			}
+		}
+	}
+
+	/// @brief Gets the arguments of the last tokenized string.
+	/// @details Never null, even when there are no arguments.
+	const char *const *GetArguments() const noexcept
+	{
+		static const char *const none = nullptr;
+		return _arguments.empty() ? &none : _arguments.data();
+	}
+
+	/// @brief Gets the number of arguments of the last tokenized string.
+	std::size_t GetCount() const noexcept
+	{
+		return _arguments.size();
+	}
+
+	/// @brief Finds the first whitespace, quote or backslash.
+	/// @returns The character or end if there is none.
+	static const char *
+	FindSpecial(const char *begin, const char *end) noexcept
+	{
+#if defined(CLI_SIMD_AVX2)
+		for(; end - begin >= 32; begin += 32)
+		{
+			const __m256i chunk =
+			    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+			// '\t' through '\r' are the only other whitespace
+			const __m256i offset = _mm256_sub_epi8(chunk, _mm256_set1_epi8(9));
+			__m256i special = _mm256_cmpeq_epi8(
+			    _mm256_min_epu8(offset, _mm256_set1_epi8(4)), offset);
+			special = _mm256_or_si256(
+			    special, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')));
+			special = _mm256_or_si256(
+			    special, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\'')));
+			special = _mm256_or_si256(
+			    special, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')));
+			special = _mm256_or_si256(
+			    special, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\')));
+			const unsigned mask =
+			    static_cast<unsigned>(_mm256_movemask_epi8(special));
+			if(mask != 0)
+			{
+				return begin + CountTrailingZeros(mask);
+			}
+		}
+#elif defined(CLI_SIMD_SSE2)
+		for(; end - begin >= 16; begin += 16)
+		{
+			const __m128i chunk =
+			    _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			// '\t' through '\r' are the only other whitespace
+			const __m128i offset = _mm_sub_epi8(chunk, _mm_set1_epi8(9));
+			__m128i special = _mm_cmpeq_epi8(
+			    _mm_min_epu8(offset, _mm_set1_epi8(4)), offset);
+			special = _mm_or_si128(
+			    special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')));
+			special = _mm_or_si128(
+			    special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\'')));
+			special = _mm_or_si128(
+			    special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')));
+			special = _mm_or_si128(
+			    special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+			const unsigned mask =
+			    static_cast<unsigned>(_mm_movemask_epi8(special));
+			if(mask != 0)
+			{
+				return begin + CountTrailingZeros(mask);
+			}
+		}
+#endif
+		return FindSpecialScalar(begin, end);
+	}
+
+	/// @brief Finds the first whitespace, quote or backslash a byte at a
+	/// time.
+	static const char *
+	FindSpecialScalar(const char *begin, const char *end) noexcept
+	{
+		while(begin != end
+		      && !tokenizerSpecials[static_cast<unsigned char>(*begin)])
+		{
+			++begin;
+		}
+		return begin;
+	}
+
+private:
+	static bool IsSpace(char c) noexcept
+	{
+		return c == ' ' || (c >= '\t' && c <= '\r');
+	}
+
+	static bool IsDoubleQuoteEscape(char c) noexcept
+	{
+		return c == '$' || c == '`' || c == '"' || c == '\\' || c == '\n';
+	}
+
+	// finds the first double quote or backslash
+	static const char *
+	FindDoubleQuoted(const char *begin, const char *end) noexcept
+	{
+#if defined(CLI_SIMD_AVX2)
+		for(; end - begin >= 32; begin += 32)
+		{
+			const __m256i chunk =
+			    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+			const __m256i special = _mm256_or_si256(
+			    _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')),
+			    _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\')));
+			const unsigned mask =
+			    static_cast<unsigned>(_mm256_movemask_epi8(special));
+			if(mask != 0)
+			{
+				return begin + CountTrailingZeros(mask);
+			}
+		}
+#elif defined(CLI_SIMD_SSE2)
+		for(; end - begin >= 16; begin += 16)
+		{
+			const __m128i chunk =
+			    _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			const __m128i special = _mm_or_si128(
+			    _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+			    _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+			const unsigned mask =
+			    static_cast<unsigned>(_mm_movemask_epi8(special));
+			if(mask != 0)
+			{
+				return begin + CountTrailingZeros(mask);
+			}
+		}
+#endif
+		while(begin != end && *begin != '"' && *begin != '\\')
+		{
+			++begin;
+		}
+		return begin;
+	}
+
+	// moves [begin, end) to out, which is never after begin
+	static char *Copy(const char *begin, const char *end, char *out) noexcept
+	{
+		const std::size_t size = static_cast<std::size_t>(end - begin);
+		if(out != begin)
+		{
+			std::memmove(out, begin, size);
+		}
+		return out + size;
+	}
+
+	// holds strings passed to Tokenize()
+	std::vector<char> _buffer;
+	std::vector<const char *> _arguments;
+};
+
+
+} // namespace details
+
+
+} // namespace cli
@@ -0,0 +1,27 @@
+/// @file
+/// @brief Assertions on cli errors that work with and without exceptions.
+#pragma once
+
+#include "cli/Config.hpp"
+
+#include "gtest/gtest.h"
+
+
+#ifdef CLI_NO_EXCEPTIONS
+
+/// @brief Asserts that a statement reports an error through
+/// cli::SetErrorHandler(), which aborts.
+#define CLI_ASSERT_ERROR(statement, exception) ASSERT_DEATH(statement, "")
+
+/// @brief Asserts that a statement returning the result of a parse fails.
+#define CLI_ASSERT_PARSE_ERROR(statement, exception) ASSERT_FALSE(statement)
+
+#else
+
+#define CLI_ASSERT_ERROR(statement, exception) \
+	ASSERT_THROW(statement, exception)
+
+#define CLI_ASSERT_PARSE_ERROR(statement, exception) \
+	ASSERT_THROW(statement, exception)
+
+#endif
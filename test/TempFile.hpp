@@ -0,0 +1,31 @@
+/// @file
+/// @brief Writes files that tests read, such as response and config files.
+#pragma once
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <string>
+
+
+/// @brief Writes a file in the temporary directory of the tests.
+/// @details Failing to write the file fails the current test, which then
+/// continues with the file missing or incomplete.
+/// @returns The path of the file.
+inline std::string WriteTempFile(const char *name, const std::string &contents)
+{
+	const std::string path = ::testing::TempDir() + name;
+	std::FILE *file = std::fopen(path.c_str(), "wb");
+	if(file == nullptr)
+	{
+		ADD_FAILURE() << "Can not open " << path << " for writing.";
+		return path;
+	}
+	if(std::fwrite(contents.data(), 1, contents.size(), file)
+	   != contents.size())
+	{
+		ADD_FAILURE() << "Can not write " << path << '.';
+	}
+	std::fclose(file);
+	return path;
+}
@@ -0,0 +1,266 @@
+#include "cli/Argument.hpp"
+#include "cli/BooleanFlags.hpp"
+#include "cli/CommandLine.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace
+{
+
+// number of allocations made by operator new while counting is enabled
+thread_local bool isCounting = false;
+thread_local std::size_t allocationCount = 0;
+
+// counts the allocations made by a function
+template <typename Function> std::size_t CountAllocations(Function &&function)
+{
+	allocationCount = 0;
+	isCounting = true;
+	function();
+	isCounting = false;
+	return allocationCount;
+}
+
+} // namespace
+
+
+void *operator new(std::size_t size)
+{
+	if(isCounting)
+	{
+		allocationCount++;
+	}
+	if(void *pointer = std::malloc(size == 0 ? 1 : size))
+	{
+		return pointer;
+	}
+#ifdef CLI_NO_EXCEPTIONS
+	std::abort();
+#else
+	throw std::bad_alloc();
+#endif
+}
+
+void operator delete(void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+
+namespace
+{
+
+
+using cli::arity;
+
+
+// user type with a parser that does not allocate
+struct Port
+{
+	unsigned value = 0;
+};
+
+bool CLIParse(Port &port, const char *input)
+{
+	port.value = 0;
+	for(; *input != '\0'; ++input)
+	{
+		if(*input < '0' || *input > '9')
+		{
+			return false;
+		}
+		port.value = port.value * 10 + static_cast<unsigned>(*input - '0');
+	}
+	return true;
+}
+
+
+TEST(allocation, count_works)
+{
+	ASSERT_EQ(1, CountAllocations([]() {
+	              int *volatile pointer = new int(1);
+	              delete pointer;
+	          }));
+}
+
+
+TEST(allocation, run_success_path)
+{
+	bool verbose;
+	bool quiet;
+	char user[16];
+	std::array<Port, 4> ports;
+	std::optional<Port> adminPort;
+	std::string mode;
+	mode.reserve(32);
+	std::vector<Port> extra;
+	extra.reserve(8);
+
+	cli::CommandLine test(
+	    "test",
+	    {cli::StoreTrue("--verbose", verbose),
+	     cli::StoreFalse("--quiet", quiet),
+	     cli::Argument("--user", user),
+	     cli::Argument("--port", ports),
+	     cli::Argument("--admin-port", adminPort),
+	     cli::Argument("--mode", mode),
+	     cli::Argument("extra", extra, arity = cli::Arity::NoMoreThan(8))});
+
+	const std::array<const char *, 14> args{
+	    "--verbose",
+	    "--user",
+	    "admin",
+	    "--port",
+	    "80",
+	    "--port",
+	    "443",
+	    "--admin-port",
+	    "8080",
+	    "--mode",
+	    "a-mode-that-does-not-fit-in-sso",
+	    "1",
+	    "--quiet",
+	    "2"};
+
+	for(int run = 0; run < 3; ++run)
+	{
+		extra.clear();
+		EXPECT_EQ(0, CountAllocations([&]() {
+			          test.Run("test", args.size(), args.data());
+		          }));
+	}
+	ASSERT_TRUE(verbose);
+	ASSERT_FALSE(quiet);
+	ASSERT_STREQ("admin", user);
+	ASSERT_EQ(443, ports[1].value);
+	ASSERT_EQ(8080, adminPort->value);
+	ASSERT_EQ("a-mode-that-does-not-fit-in-sso", mode);
+	ASSERT_EQ(2, extra.size());
+}
+
+
+TEST(allocation, map_keys_are_not_copied)
+{
+	std::map<std::string, int> limits;
+	std::map<int, std::string> names;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("--limit", limits), cli::Argument("--name", names)});
+	const std::array<const char *, 6> args{
+	    "--limit",
+	    "a-key-that-does-not-fit-in-sso=1",
+	    "--limit",
+	    "another-key-that-does-not-fit-in-sso=2",
+	    "--name",
+	    "3=short"};
+
+	// one node and one key for each string key, one node for the int key
+	EXPECT_EQ(5, CountAllocations([&]() {
+		          test.Run("test", args.size(), args.data());
+	          }));
+	ASSERT_EQ(2, limits.at("another-key-that-does-not-fit-in-sso"));
+	ASSERT_EQ("short", names.at(3));
+}
+
+
+TEST(allocation, views_are_not_copied)
+{
+	std::string_view name;
+	std::vector<std::string_view> paths;
+	paths.reserve(4);
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("--name", name), cli::Argument("paths", paths)});
+	const std::array<const char *, 4> args{
+	    "--name",
+	    "a-name-that-does-not-fit-in-sso",
+	    "a/path/that/does/not/fit/in/sso",
+	    "another/path/that/does/not/fit/in/sso"};
+	EXPECT_EQ(0, CountAllocations([&]() {
+		          test.Run("test", args.size(), args.data());
+	          }));
+	ASSERT_EQ(args[1], name.data());
+	ASSERT_EQ(2, paths.size());
+}
+
+
+TEST(allocation, memory_resource)
+{
+	// everything the command line and its destinations need fits here
+	std::array<std::byte, 4096> buffer;
+	std::pmr::monotonic_buffer_resource resource(
+	    buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+	std::pmr::vector<std::pmr::string> files(&resource);
+	std::pmr::map<std::pmr::string, int> limits(&resource);
+	std::pmr::string mode(&resource);
+	bool verbose = false;
+	const std::array<const char *, 7> args{
+	    "--limit",
+	    "a-key-that-does-not-fit-in-sso=1",
+	    "--mode",
+	    "a-mode-that-does-not-fit-in-sso",
+	    "--verbose",
+	    "a/path/that/does/not/fit/in/sso",
+	    "another/path/that/does/not/fit/in/sso"};
+
+	EXPECT_EQ(0, CountAllocations([&]() {
+		          cli::CommandLine test(
+		              "test",
+		              {cli::Argument("--limit", limits),
+		               cli::Argument("--mode", mode),
+		               cli::StoreTrue("--verbose", verbose),
+		               cli::Argument("files", files)},
+		              cli::memoryResource = &resource);
+		          test.Run("test", args.size(), args.data());
+	          }));
+	ASSERT_EQ(1, limits.at("a-key-that-does-not-fit-in-sso"));
+	ASSERT_EQ("a-mode-that-does-not-fit-in-sso", mode);
+	ASSERT_TRUE(verbose);
+	ASSERT_EQ(2, files.size());
+}
+
+
+struct Settings
+{
+	bool verbose;
+	Port port;
+};
+
+
+TEST(allocation, run_with_context)
+{
+	const cli::CommandLine test(
+	    "test",
+	    {cli::StoreTrue<&Settings::verbose>("--verbose"),
+	     cli::Argument<&Settings::port>("--port")});
+	const std::array<const char *, 3> args{"--verbose", "--port", "22"};
+
+	Settings options;
+	cli::ParseContext context = test.MakeContext();
+	context.Bind(options);
+	EXPECT_EQ(0, CountAllocations([&]() {
+		          test.Run(context, "test", args.size(), args.data());
+	          }));
+	ASSERT_TRUE(options.verbose);
+	ASSERT_EQ(22, options.port.value);
+}
+
+
+} // namespace
@@ -0,0 +1,191 @@
+#include "cli/Argument.hpp"
+#include "cli/ArgumentStream.hpp"
+#include "cli/BooleanFlags.hpp"
+#include "cli/CommandLine.hpp"
+#include "cli/Lazy.hpp"
+
+#include "gtest/gtest.h"
+
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+
+
+using cli::ArgumentStream;
+
+// owns a file descriptor reading the given contents
+class Input
+{
+public:
+	explicit Input(const std::string &contents)
+	{
+		const std::string path = ::testing::TempDir() + "stream.txt";
+		const int out =
+		    ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+		EXPECT_EQ(
+		    static_cast<ssize_t>(contents.size()),
+		    ::write(out, contents.data(), contents.size()));
+		::close(out);
+		_fd = ::open(path.c_str(), O_RDONLY);
+	}
+
+	~Input()
+	{
+		::close(_fd);
+	}
+
+	int Get() const
+	{
+		return _fd;
+	}
+
+private:
+	int _fd;
+};
+
+
+std::vector<std::string> ReadAll(ArgumentStream &stream)
+{
+	std::vector<std::string> arguments;
+	while(const char *argument = stream.Peek())
+	{
+		arguments.push_back(argument);
+		stream.Pop();
+	}
+	return arguments;
+}
+
+
+TEST(argument_stream, null_delimited)
+{
+	Input input(std::string("a\nb\0\0c", 6));
+	ArgumentStream stream(input.Get());
+	ASSERT_EQ((std::vector<std::string>{"a\nb", "", "c"}), ReadAll(stream));
+	ASSERT_EQ(nullptr, stream.GetError());
+}
+
+
+TEST(argument_stream, newline_delimited)
+{
+	Input input("a\r\n\nb c\nd\n");
+	ArgumentStream stream(input.Get(), ArgumentStream::Delimiter::NEWLINE);
+	ASSERT_EQ((std::vector<std::string>{"a", "b c", "d"}), ReadAll(stream));
+}
+
+
+TEST(argument_stream, small_buffer)
+{
+	// arguments span many refills of the buffer
+	std::string contents;
+	std::vector<std::string> expected;
+	for(int i = 0; i < 100; ++i)
+	{
+		expected.push_back(std::to_string(i * 1000));
+		contents += expected.back() + '\n';
+	}
+	Input input(contents);
+	ArgumentStream stream(input.Get(), ArgumentStream::Delimiter::NEWLINE, 8);
+	ASSERT_EQ(expected, ReadAll(stream));
+}
+
+
+TEST(argument_stream, too_long)
+{
+	Input input("short\nmuch too long\n");
+	ArgumentStream stream(input.Get(), ArgumentStream::Delimiter::NEWLINE, 8);
+	ASSERT_EQ(std::vector<std::string>{"short"}, ReadAll(stream));
+	ASSERT_NE(nullptr, stream.GetError());
+}
+
+
+TEST(argument_stream, run)
+{
+	std::vector<int> values;
+	bool verbose = false;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("values", values),
+	     cli::StoreTrue("--verbose", verbose)});
+
+	Input input(std::string("1\0--verbose\0002\0003", 16));
+	ArgumentStream stream(input.Get(), ArgumentStream::Delimiter::NUL, 16);
+	ASSERT_TRUE(test.TryRun("test", stream));
+	ASSERT_EQ((std::vector<int>{1, 2, 3}), values);
+	ASSERT_TRUE(verbose);
+
+	// an inline value stays valid while the buffer is refilled
+	int count = 0;
+	cli::CommandLine counted("test", {cli::Argument("--count", count)});
+	Input inlineInput("--count=12345\n");
+	ArgumentStream inlineStream(
+	    inlineInput.Get(), ArgumentStream::Delimiter::NEWLINE, 16);
+	ASSERT_TRUE(counted.TryRun("test", inlineStream));
+	ASSERT_EQ(12345, count);
+}
+
+
+TEST(argument_stream, run_errors)
+{
+	std::vector<int> values;
+	int count = 0;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("values", values), cli::Argument("--count", count)});
+
+	Input invalid("1\n2\nx\n");
+	ArgumentStream invalidStream(
+	    invalid.Get(), ArgumentStream::Delimiter::NEWLINE);
+	cli::ParseResult result = test.TryRun("test", invalidStream);
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(2U, result.GetIndex());
+
+	Input missing("1\n--count\n");
+	ArgumentStream missingStream(
+	    missing.Get(), ArgumentStream::Delimiter::NEWLINE);
+	result = test.TryRun("test", missingStream);
+	ASSERT_EQ(cli::ErrorCode::MISSING_VALUE, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+
+	Input tooLong("1\n12345678\n");
+	ArgumentStream tooLongStream(
+	    tooLong.Get(), ArgumentStream::Delimiter::NEWLINE, 4);
+	result = test.TryRun("test", tooLongStream);
+	ASSERT_EQ(cli::ErrorCode::INVALID_STREAM, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Argument longer than the argument "
+	    "stream buffer.",
+	    result.GetMessage());
+}
+
+
+TEST(argument_stream, rejects_views)
+{
+	std::string_view name;
+	cli::CommandLine test("test", {cli::Argument("--name", name)});
+
+	Input input("--name\nx\n");
+	ArgumentStream stream(input.Get(), ArgumentStream::Delimiter::NEWLINE);
+	const cli::ParseResult result = test.TryRun("test", stream);
+	ASSERT_EQ(cli::ErrorCode::INVALID_CALL, result.GetErrorCode());
+	ASSERT_TRUE(name.empty());
+
+	// lazy values keep the strings until they are read
+	cli::Lazy<int> count;
+	cli::CommandLine lazy("test", {cli::Argument("--count", count)});
+	Input lazyInput("--count\n1\n");
+	ArgumentStream lazyStream(
+	    lazyInput.Get(), ArgumentStream::Delimiter::NEWLINE);
+	ASSERT_EQ(
+	    cli::ErrorCode::INVALID_CALL,
+	    lazy.TryRun("test", lazyStream).GetErrorCode());
+	ASSERT_FALSE(count.IsPending());
+}
+
+
+} // namespace
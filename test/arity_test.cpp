@@ -3,6 +3,14 @@
 
 #include "gtest/gtest.h"
 
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace
 {
 
@@ -28,8 +36,13 @@ TYPED_TEST_P(one, optional)
 
 REGISTER_TYPED_TEST_CASE_P(one, normal, optional);
 
-using OneTypes =
-    ::testing::Types<char, int, float, std::string, std::array<char, 30>>;
+using OneTypes = ::testing::Types<
+    char,
+    int,
+    float,
+    std::string,
+    std::pmr::string,
+    std::array<char, 30>>;
 
 INSTANTIATE_TYPED_TEST_CASE_P(arity, one, OneTypes);
 
@@ -61,7 +74,12 @@ using UnboundedTypes = ::testing::Types<
     std::set<int>,
     std::unordered_set<int>,
     std::map<int, std::string>,
-    std::unordered_map<int, std::string>>;
+    std::unordered_map<int, std::string>,
+    std::pmr::vector<int>,
+    std::pmr::set<int>,
+    std::pmr::unordered_set<int>,
+    std::pmr::map<int, std::pmr::string>,
+    std::pmr::unordered_map<int, std::pmr::string>>;
 
 INSTANTIATE_TYPED_TEST_CASE_P(arity, unbounded, UnboundedTypes);
 
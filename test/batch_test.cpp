@@ -0,0 +1,200 @@
+#include "cli/Argument.hpp"
+#include "cli/Batch.hpp"
+#include "cli/BooleanFlags.hpp"
+#include "cli/CommandLine.hpp"
+#include "cli/InfoFlags.hpp"
+#include "cli/ThreadPool.hpp"
+
+#include "ErrorAssertions.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+
+struct Job
+{
+	std::optional<int> id;
+	bool verbose;
+	std::vector<std::string> files;
+};
+
+
+cli::CommandLine MakeJobCommandLine()
+{
+	return cli::CommandLine(
+	    "test",
+	    {cli::Argument<&Job::id>("--id"),
+	     cli::StoreTrue<&Job::verbose>("--verbose"),
+	     cli::Argument<&Job::files>("files")});
+}
+
+
+TEST(thread_pool, visits_every_index_once)
+{
+	cli::ThreadPool pool(4);
+	ASSERT_EQ(4, pool.GetSize());
+	std::vector<std::atomic<int>> visits(10000);
+	for(int run = 1; run <= 3; ++run)
+	{
+		pool.ForEach(visits.size(), [&](std::size_t index, std::size_t worker) {
+			EXPECT_LT(worker, 4);
+			++visits[index];
+		});
+		for(const std::atomic<int> &count : visits)
+		{
+			ASSERT_EQ(run, count.load());
+		}
+	}
+}
+
+
+TEST(batch, parse_results)
+{
+	const cli::CommandLine test = MakeJobCommandLine();
+	std::string lines = "--id 1 a.txt\n\n  --verbose\tb.txt c.txt\r\n--bad\n";
+	cli::BatchInput input(lines.data(), lines.size());
+	cli::ThreadPool pool(3);
+
+	const std::vector<cli::LineResult<Job>> results =
+	    cli::ParseBatch<Job>(test, "test", input, pool);
+	ASSERT_EQ(4, results.size());
+
+	ASSERT_EQ(1, results[0].line);
+	ASSERT_TRUE(results[0].result);
+	ASSERT_EQ(1, results[0].object.id);
+	ASSERT_FALSE(results[0].object.verbose);
+	ASSERT_EQ(std::vector<std::string>{"a.txt"}, results[0].object.files);
+
+	ASSERT_EQ(2, results[1].line);
+	ASSERT_TRUE(results[1].result);
+	ASSERT_TRUE(results[1].object.files.empty());
+
+	ASSERT_EQ(3, results[2].line);
+	ASSERT_TRUE(results[2].result);
+	ASSERT_TRUE(results[2].object.verbose);
+	ASSERT_EQ(
+	    (std::vector<std::string>{"b.txt", "c.txt"}), results[2].object.files);
+
+	ASSERT_EQ(4, results[3].line);
+	ASSERT_EQ(cli::ErrorCode::UNKNOWN_FLAG, results[3].result.GetErrorCode());
+	ASSERT_EQ(0, results[3].result.GetIndex());
+}
+
+
+TEST(batch, info_flags_do_not_print)
+{
+	const cli::CommandLine test(
+	    "test",
+	    {cli::Argument<&Job::id>("--id"),
+	     cli::Help("--help"),
+	     cli::Version("--version", "1.0")});
+	std::string lines = "--help\n--id 2\n--version\n";
+	cli::BatchInput input(lines.data(), lines.size());
+	cli::ThreadPool pool(2);
+
+	testing::internal::CaptureStdout();
+	const std::vector<cli::LineResult<Job>> results =
+	    cli::ParseBatch<Job>(test, "test", input, pool);
+	ASSERT_EQ("", testing::internal::GetCapturedStdout());
+	ASSERT_EQ(3, results.size());
+	ASSERT_TRUE(results[0].result.IsExit());
+	ASSERT_FALSE(results[1].result.IsExit());
+	ASSERT_EQ(2, results[1].object.id);
+	ASSERT_TRUE(results[2].result.IsExit());
+
+	// other contexts still print
+	testing::internal::CaptureStdout();
+	const std::array<const char *, 1> args{"--version"};
+	Job job;
+	cli::ParseContext context;
+	context.Bind(job);
+	ASSERT_TRUE(test.TryRun(context, "test", 1, args.data()).IsExit());
+	ASSERT_EQ("1.0\n", testing::internal::GetCapturedStdout());
+}
+
+
+TEST(batch, run_many_chunks)
+{
+	const cli::CommandLine test = MakeJobCommandLine();
+	std::string lines;
+	constexpr int count = 20000;
+	for(int i = 1; i <= count; ++i)
+	{
+		lines += "--id " + std::to_string(i) + " some/file.txt\n";
+	}
+	ASSERT_GT(lines.size(), 4 * cli::details::Lines::chunkSize);
+	cli::BatchInput input(lines.data(), lines.size());
+	cli::ThreadPool pool(4);
+
+	std::vector<std::atomic<int>> ids(count + 1);
+	std::atomic<int> failures(0);
+	cli::RunBatch<Job>(
+	    test,
+	    "test",
+	    input,
+	    pool,
+	    [&](std::size_t line, Job &job, const cli::ParseResult &result) {
+		    if(!result || job.files.size() != 1)
+		    {
+			    ++failures;
+		    }
+		    ids[line] = job.id.value_or(-1);
+	    });
+	ASSERT_EQ(0, failures.load());
+	for(int i = 1; i <= count; ++i)
+	{
+		ASSERT_EQ(i, ids[i].load());
+	}
+}
+
+
+TEST(batch, file)
+{
+	const std::string path = ::testing::TempDir() + "batch.txt";
+	std::FILE *file = std::fopen(path.c_str(), "wb");
+	ASSERT_NE(nullptr, file);
+	std::fputs("--id 7\n--id x", file);
+	std::fclose(file);
+
+	const cli::CommandLine test = MakeJobCommandLine();
+	cli::BatchInput input;
+	ASSERT_TRUE(input.Open(path.c_str()));
+	cli::ThreadPool pool(2);
+	const std::vector<cli::LineResult<Job>> results =
+	    cli::ParseBatch<Job>(test, "test", input, pool);
+	ASSERT_EQ(2, results.size());
+	ASSERT_EQ(7, results[0].object.id);
+	ASSERT_EQ(2, results[1].line);
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, results[1].result.GetErrorCode());
+	ASSERT_EQ(1, results[1].result.GetIndex());
+
+	ASSERT_FALSE(input.Open("missing/batch.txt"));
+}
+
+
+TEST(batch, requires_member_arguments)
+{
+	bool verbose = false;
+	const cli::CommandLine test(
+	    "test",
+	    {cli::Argument<&Job::id>("--id"),
+	     cli::StoreTrue("--verbose", verbose)});
+	std::string lines = "--verbose\n";
+	cli::BatchInput input(lines.data(), lines.size());
+	cli::ThreadPool pool(1);
+	CLI_ASSERT_ERROR(
+	    cli::ParseBatch<Job>(test, "test", input, pool), std::invalid_argument);
+}
+
+
+} // namespace
@@ -1,14 +1,27 @@
 #include "cli/Argument.hpp"
+#include "cli/BooleanFlags.hpp"
 #include "cli/CommandLine.hpp"
+#include "cli/ThreadPool.hpp"
+
+#include "ErrorAssertions.hpp"
 
 #include "gtest/gtest.h"
 
 #include <array>
+#include <cstdlib>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 namespace
 {
 
 
+using cli::arity;
 using cli::help;
 
 TEST(command_line, flag)
@@ -35,4 +48,754 @@ TEST(command_line, positional)
 }
 
 
+TEST(command_line, many_flags)
+{
+	std::vector<std::string> names;
+	std::vector<int> values(100, -1);
+	for(std::size_t i = 0; i < values.size(); ++i)
+	{
+		names.push_back("--flag" + std::to_string(i));
+	}
+	std::vector<cli::GenericArgument> arguments;
+	for(std::size_t i = 0; i < values.size(); ++i)
+	{
+		arguments.push_back(cli::Argument(
+		    names[i].c_str(), values[i], arity = cli::Arity::Optional()));
+	}
+	cli::CommandLine many("test", arguments.begin(), arguments.end());
+	std::array<const char *, 4> args{"--flag7", "7", "--flag93", "93"};
+
+	// the lookup table is reused across runs
+	for(int run = 0; run < 2; ++run)
+	{
+		many.Run("test", 4, args.data());
+		ASSERT_EQ(7, values[7]);
+		ASSERT_EQ(93, values[93]);
+	}
+
+	std::array<const char *, 1> unknown{"--flag100"};
+	CLI_ASSERT_ERROR(
+	    many.Run("test", 1, unknown.data()), std::invalid_argument);
+}
+
+
+struct Options
+{
+	int count = 0;
+	std::vector<std::string> files;
+	bool verbose = true;
+};
+
+
+TEST(command_line, members)
+{
+	const cli::CommandLine test(
+	    "test",
+	    {cli::Argument<&Options::count>(
+	         "--count", arity = cli::Arity::Optional()),
+	     cli::StoreTrue<&Options::verbose>("--verbose"),
+	     cli::Argument<&Options::files>("files")});
+
+	cli::ParseContext context;
+	std::array<const char *, 4> args{"a", "--count", "3", "b"};
+	Options first;
+	context.Bind(first);
+	ASSERT_FALSE(test.Run(context, "test", 4, args.data()));
+	ASSERT_EQ(3, first.count);
+	ASSERT_EQ((std::vector<std::string>{"a", "b"}), first.files);
+	ASSERT_FALSE(first.verbose);
+
+	std::array<const char *, 2> other{"--verbose", "c"};
+	Options second;
+	context.Bind(second);
+	ASSERT_FALSE(test.Run(context, "test", 2, other.data()));
+	ASSERT_EQ(0, second.count);
+	ASSERT_EQ(std::vector<std::string>{"c"}, second.files);
+	ASSERT_TRUE(second.verbose);
+
+	// the first object is untouched by the second run
+	ASSERT_EQ(3, first.count);
+
+	context.Unbind();
+	CLI_ASSERT_ERROR(
+	    test.Run(context, "test", 2, other.data()), std::invalid_argument);
+}
+
+
+TEST(command_line, mixed_member_types)
+{
+	int other = 0;
+	CLI_ASSERT_ERROR(
+	    cli::CommandLine(
+	        "test",
+	        {cli::Argument<&Options::count>("--count"),
+	         cli::Argument<&std::pair<int, int>::first>("--first")}),
+	    std::invalid_argument);
+
+	// members may be mixed with arguments bound to a single object
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument<&Options::count>("--count"),
+	     cli::Argument("--other", other)});
+	cli::ParseContext context;
+	Options options;
+	context.Bind(options);
+	std::array<const char *, 4> args{"--count", "1", "--other", "2"};
+	test.Run(context, "test", 4, args.data());
+	ASSERT_EQ(1, options.count);
+	ASSERT_EQ(2, other);
+}
+
+
+TEST(command_line, concurrent)
+{
+	const cli::CommandLine test(
+	    "test",
+	    {cli::Argument<&Options::count>("--count"),
+	     cli::Argument<&Options::files>("files")});
+
+	std::vector<std::thread> threads;
+	std::vector<int> failures(4, 0);
+	for(int thread = 0; thread < 4; ++thread)
+	{
+		threads.emplace_back([&test, &failures, thread]() {
+			cli::ParseContext context;
+			const std::string count = std::to_string(thread);
+			const std::array<const char *, 3> args{
+			    "--count", count.c_str(), "file"};
+			for(int i = 0; i < 1000; ++i)
+			{
+				Options options;
+				context.Bind(options);
+				test.Run(context, "test", 3, args.data());
+				if(options.count != thread || options.files.size() != 1)
+				{
+					failures[thread]++;
+				}
+			}
+		});
+	}
+	for(std::thread &thread : threads)
+	{
+		thread.join();
+	}
+	ASSERT_EQ(std::vector<int>(4, 0), failures);
+}
+
+
+TEST(command_line, copies)
+{
+	int count = 0;
+	std::vector<std::string> files;
+	cli::CommandLine original(
+	    "test",
+	    {cli::Argument("--count", count, cli::shortName = 'c'),
+	     cli::Argument("files", files)},
+	    cli::responseFiles = true,
+	    cli::abbreviations = true);
+	cli::CommandLine copy = original;
+	const std::array<const char *, 3> args{"--cou", "1", "a"};
+	ASSERT_TRUE(original.TryRun("test", 3, args.data()));
+	ASSERT_TRUE(copy.TryRun("test", 3, args.data()));
+	ASSERT_EQ(1, count);
+	ASSERT_EQ((std::vector<std::string>{"a", "a"}), files);
+
+	int other = 0;
+	copy = cli::CommandLine("other", {cli::Argument("--other", other)});
+	copy = original;
+	const std::array<const char *, 2> shortArgs{"-c2", "b"};
+	ASSERT_TRUE(copy.TryRun("test", 2, shortArgs.data()));
+	ASSERT_TRUE(original.TryRun("test", 3, args.data()));
+	ASSERT_EQ(1, count);
+	ASSERT_EQ((std::vector<std::string>{"a", "a", "b", "a"}), files);
+}
+
+
+TEST(command_line, positional_runs)
+{
+	std::vector<int> first;
+	std::vector<std::string> rest;
+	bool verbose = false;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("first", first, arity = cli::Arity::Inclusive(1, 3)),
+	     cli::Argument("rest", rest, arity = cli::Arity::Unbounded()),
+	     cli::StoreTrue("--verbose", verbose)});
+
+	const std::array<const char *, 7> args{
+	    "1", "2", "--verbose", "3", "a", "b", "c"};
+	ASSERT_TRUE(test.TryRun("test", 7, args.data()));
+	ASSERT_EQ((std::vector<int>{1, 2, 3}), first);
+	ASSERT_EQ((std::vector<std::string>{"a", "b", "c"}), rest);
+	ASSERT_TRUE(verbose);
+
+	first.clear();
+	rest.clear();
+	const std::array<const char *, 4> invalid{"4", "5", "x", "6"};
+	const cli::ParseResult result = test.TryRun("test", 4, invalid.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(2U, result.GetIndex());
+	ASSERT_STREQ("first", result.GetArgumentName());
+	// values before the failure are kept, as when stored one at a time
+	ASSERT_EQ((std::vector<int>{4, 5}), first);
+}
+
+
+TEST(command_line, separated_lists)
+{
+	std::vector<int> ids;
+	std::array<double, 3> point{};
+	std::set<std::string> tags;
+	std::map<std::string, int> limits;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("--ids", ids, cli::separator = ','),
+	     cli::Argument("--point", point, cli::separator = ','),
+	     cli::Argument("--tags", tags, cli::separator = ':'),
+	     cli::Argument("--limits", limits, cli::separator = ',')});
+
+	// long enough to be split a vector at a time
+	const std::string manyIds =
+	    "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24";
+	const std::array<const char *, 10> args{
+	    "--ids",
+	    manyIds.c_str(),
+	    "--point",
+	    "1.5,-2,+3",
+	    "--tags",
+	    "b:a:b",
+	    "--limits",
+	    "x=1,y=2",
+	    "--ids",
+	    "25,26"};
+	ASSERT_TRUE(test.TryRun("test", 10, args.data()));
+	ASSERT_EQ(26U, ids.size());
+	for(int i = 0; i < 26; ++i)
+	{
+		ASSERT_EQ(i + 1, ids[i]);
+	}
+	ASSERT_EQ((std::array<double, 3>{1.5, -2, 3}), point);
+	ASSERT_EQ((std::set<std::string>{"a", "b"}), tags);
+	ASSERT_EQ((std::map<std::string, int>{{"x", 1}, {"y", 2}}), limits);
+
+	// empty lists have no elements, empty elements are values
+	ids.clear();
+	tags.clear();
+	const std::array<const char *, 4> empty{"--ids", "", "--tags", "::"};
+	ASSERT_TRUE(test.TryRun("test", 4, empty.data()));
+	ASSERT_TRUE(ids.empty());
+	ASSERT_EQ(std::set<std::string>{""}, tags);
+}
+
+
+TEST(command_line, separated_list_errors)
+{
+	std::vector<int> ids;
+	std::array<int, 2> pair{};
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("pair", pair, cli::separator = ','),
+	     cli::Argument(
+	         "--ids",
+	         ids,
+	         cli::separator = ',',
+	         arity = cli::Arity::NoMoreThan(3))});
+
+	// the arity limits the number of elements
+	const std::array<const char *, 4> tooMany{"--ids", "1,2", "--ids", "3,4"};
+	cli::ParseResult result = test.TryRun("test", 4, tooMany.data());
+	ASSERT_EQ(cli::ErrorCode::TOO_MANY_VALUES, result.GetErrorCode());
+	ASSERT_EQ(3U, result.GetIndex());
+	ASSERT_STREQ("--ids", result.GetArgumentName());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  --ids given more than the maximum "
+	    "of 3 time(s).",
+	    result.GetMessage());
+	ASSERT_EQ((std::vector<int>{1, 2}), ids);
+
+	const std::array<const char *, 1> overflow{"1,2,3"};
+	result = test.TryRun("test", 1, overflow.data());
+	ASSERT_EQ(cli::ErrorCode::TOO_MANY_VALUES, result.GetErrorCode());
+
+	const std::array<const char *, 2> split{"1", "2"};
+	ASSERT_TRUE(test.TryRun("test", 2, split.data()));
+	ASSERT_EQ((std::array<int, 2>{1, 2}), pair);
+
+	ids.clear();
+	const std::array<const char *, 2> invalid{"--ids", "1,x,3"};
+	result = test.TryRun("test", 2, invalid.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+	// elements before the failure are kept, as when given one at a time
+	ASSERT_EQ(std::vector<int>{1}, ids);
+}
+
+
+TEST(command_line, views_refer_to_argv)
+{
+	std::string_view name;
+	const char *mode = nullptr;
+	std::vector<std::string_view> paths;
+	std::vector<std::string_view> tags;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("--name", name),
+	     cli::Argument("--mode", mode),
+	     cli::Argument("--tags", tags, cli::separator = ','),
+	     cli::Argument("paths", paths)});
+
+	const std::array<const char *, 8> args{
+	    "--name", "n", "--mode", "fast", "--tags", "x,yz", "a/b", "c"};
+	ASSERT_TRUE(test.TryRun("test", 8, args.data()));
+	ASSERT_EQ(args[1], name.data());
+	ASSERT_EQ(args[3], mode);
+	ASSERT_EQ((std::vector<std::string_view>{"x", "yz"}), tags);
+	ASSERT_EQ(args[5] + 2, tags[1].data());
+	ASSERT_EQ(2U, paths.size());
+	ASSERT_EQ(args[6], paths[0].data());
+	ASSERT_EQ(args[7], paths[1].data());
+
+	// elements of a list are not null terminated
+	const char *first = nullptr;
+	cli::CommandLine list(
+	    "test", {cli::Argument("--first", first, cli::separator = ',')});
+	const std::array<const char *, 2> listArgs{"--first", "a"};
+	const cli::ParseResult result = list.TryRun("test", 2, listArgs.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(nullptr, first);
+}
+
+
+TEST(command_line, parallel_runs)
+{
+	// long enough to be converted on the pool
+	constexpr std::size_t count = 100000;
+	std::vector<std::string> strings;
+	strings.reserve(count);
+	for(std::size_t i = 0; i < count; ++i)
+	{
+		strings.push_back(std::to_string(i % 1000) + '=' + std::to_string(i));
+	}
+	std::vector<const char *> args;
+	for(const std::string &string : strings)
+	{
+		args.push_back(string.c_str());
+	}
+	const int argc = static_cast<int>(count);
+
+	cli::ThreadPool pool(4);
+	std::map<int, std::size_t> map;
+	cli::CommandLine mapTest("test", {cli::Argument("values", map)});
+	cli::ParseContext mapContext = mapTest.MakeContext();
+	mapContext.SetThreadPool(&pool);
+	ASSERT_TRUE(mapTest.TryRun(mapContext, "test", argc, args.data()));
+	// later entries replace earlier ones as they would without a pool
+	ASSERT_EQ(1000U, map.size());
+	ASSERT_EQ(count - 1000, map.at(0));
+	ASSERT_EQ(count - 1, map.at(999));
+
+	for(std::size_t i = 0; i < count; ++i)
+	{
+		strings[i] = std::to_string(i);
+		args[i] = strings[i].c_str();
+	}
+	std::vector<int> vector{-1};
+	std::set<std::string> set;
+	cli::CommandLine vectorTest("test", {cli::Argument("values", vector)});
+	cli::CommandLine setTest("test", {cli::Argument("values", set)});
+	cli::ParseContext vectorContext = vectorTest.MakeContext();
+	cli::ParseContext setContext = setTest.MakeContext();
+	vectorContext.SetThreadPool(&pool);
+	setContext.SetThreadPool(&pool);
+	ASSERT_TRUE(vectorTest.TryRun(vectorContext, "test", argc, args.data()));
+	ASSERT_TRUE(setTest.TryRun(setContext, "test", argc, args.data()));
+	ASSERT_EQ(count + 1, vector.size());
+	ASSERT_EQ(-1, vector[0]);
+	ASSERT_EQ(static_cast<int>(count - 1), vector.back());
+	ASSERT_EQ(count, set.size());
+
+	// the first failure is reported and the values before it are kept
+	strings[70000] = "x";
+	strings[90000] = "y";
+	args[70000] = strings[70000].c_str();
+	args[90000] = strings[90000].c_str();
+	vector.clear();
+	const cli::ParseResult result =
+	    vectorTest.TryRun(vectorContext, "test", argc, args.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(70000U, result.GetIndex());
+	ASSERT_EQ(70000U, vector.size());
+	ASSERT_EQ(69999, vector.back());
+}
+
+
+TEST(command_line, abbreviations)
+{
+	bool verbose = false;
+	std::optional<int> value;
+	std::vector<int> values;
+	cli::CommandLine test(
+	    "test",
+	    {cli::StoreTrue("--verbose", verbose),
+	     cli::Argument("--value", value),
+	     cli::Argument("--values", values)},
+	    cli::abbreviations = true);
+
+	const std::array<const char *, 5> args{
+	    "--verb", "--value", "1", "--values", "2"};
+	ASSERT_TRUE(test.TryRun("test", 5, args.data()));
+	ASSERT_TRUE(verbose);
+	ASSERT_EQ(1, value);
+	ASSERT_EQ(std::vector<int>{2}, values);
+
+	const std::array<const char *, 3> ambiguous{"--verbose", "--va", "1"};
+	const cli::ParseResult result = test.TryRun("test", 3, ambiguous.data());
+	ASSERT_EQ(cli::ErrorCode::AMBIGUOUS_FLAG, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Ambiguous flag: --va matches more "
+	    "than one flag, including --value and --values.",
+	    result.GetMessage());
+
+	const std::array<const char *, 1> dashes{"--"};
+	ASSERT_EQ(
+	    cli::ErrorCode::UNKNOWN_FLAG,
+	    test.TryRun("test", 1, dashes.data()).GetErrorCode());
+
+	// abbreviations are opt in
+	cli::CommandLine exact("test", {cli::StoreTrue("--verbose", verbose)});
+	const cli::ParseResult unknown = exact.TryRun("test", 1, args.data());
+	ASSERT_EQ(cli::ErrorCode::UNKNOWN_FLAG, unknown.GetErrorCode());
+	ASSERT_EQ(nullptr, unknown.GetSuggestion());
+}
+
+
+TEST(command_line, suggestions)
+{
+	bool verbose = false;
+	int count = 0;
+	cli::CommandLine test(
+	    "test",
+	    {cli::StoreTrue("--verbose", verbose),
+	     cli::Argument("--count", count, cli::arity = cli::Arity::Optional()),
+	     cli::Argument(
+	         "--counts", count, cli::arity = cli::Arity::Optional())});
+
+	const std::array<const char *, 4> args{
+	    "--verbsoe", "--countz", "--cont", "--unrelated"};
+	ASSERT_STREQ(
+	    "--verbose", test.TryRun("test", 1, &args[0]).GetSuggestion());
+	// ties go to the first flag
+	ASSERT_STREQ("--count", test.TryRun("test", 1, &args[1]).GetSuggestion());
+	ASSERT_STREQ("--count", test.TryRun("test", 1, &args[2]).GetSuggestion());
+	ASSERT_EQ(nullptr, test.TryRun("test", 1, &args[3]).GetSuggestion());
+}
+
+
+TEST(command_line, short_flags)
+{
+	bool extract = false;
+	bool verbose = false;
+	std::string file;
+	std::optional<int> count;
+	std::vector<std::string> names;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("names", names, cli::arity = cli::Arity::Unbounded()),
+	     cli::StoreTrue("--extract", extract, cli::shortName = 'x'),
+	     cli::StoreTrue("--verbose", verbose, cli::shortName = 'v'),
+	     cli::Argument("--file", file, cli::shortName = 'f'),
+	     cli::Argument("--count", count, cli::shortName = 'n')});
+
+	// a cluster ending with a flag that takes the next argument
+	const std::array<const char *, 3> cluster{"-xvf", "out.tar", "a"};
+	ASSERT_TRUE(test.TryRun("test", 3, cluster.data()));
+	ASSERT_TRUE(extract);
+	ASSERT_TRUE(verbose);
+	ASSERT_EQ("out.tar", file);
+	ASSERT_EQ(std::vector<std::string>{"a"}, names);
+
+	// attached values, and short and long names of the same flag
+	extract = false;
+	const std::array<const char *, 3> attached{"-vn10", "-fx.tar", "b"};
+	ASSERT_TRUE(test.TryRun("test", 3, attached.data()));
+	ASSERT_FALSE(extract);
+	ASSERT_EQ(10, count);
+	ASSERT_EQ("x.tar", file);
+	const std::array<const char *, 3> mixed{"-f", "y.tar", "--file"};
+	const cli::ParseResult twice = test.TryRun("test", 3, mixed.data());
+	ASSERT_EQ(cli::ErrorCode::TOO_MANY_VALUES, twice.GetErrorCode());
+	ASSERT_EQ(2U, twice.GetIndex());
+	const std::array<const char *, 1> repeated{"-vxv"};
+	ASSERT_EQ(
+	    cli::ErrorCode::TOO_MANY_VALUES,
+	    test.TryRun("test", 1, repeated.data()).GetErrorCode());
+
+	// failures in a cluster are reported at the cluster
+	const std::array<const char *, 2> unknown{"a", "-xqf"};
+	cli::ParseResult result = test.TryRun("test", 2, unknown.data());
+	ASSERT_EQ(cli::ErrorCode::UNKNOWN_FLAG, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Unknown flag: -xqf",
+	    result.GetMessage());
+	const std::array<const char *, 2> invalid{"a", "-vnx"};
+	result = test.TryRun("test", 2, invalid.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+	const std::array<const char *, 2> missing{"a", "-vf"};
+	result = test.TryRun("test", 2, missing.data());
+	ASSERT_EQ(cli::ErrorCode::MISSING_VALUE, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+
+	ASSERT_EQ(
+	    "-v, --verbose: \n",
+	    cli::StoreTrue("--verbose", verbose, cli::shortName = 'v').GetHelp()
+	        + '\n');
+	CLI_ASSERT_ERROR(
+	    cli::CommandLine(
+	        "test", {cli::Argument("file", file, cli::shortName = 'f')}),
+	    std::invalid_argument);
+	CLI_ASSERT_ERROR(
+	    cli::CommandLine(
+	        "test", {cli::StoreTrue("--dash", verbose, cli::shortName = '-')}),
+	    std::invalid_argument);
+}
+
+
+TEST(command_line, inline_values)
+{
+	bool verbose = false;
+	std::optional<int> threads;
+	std::vector<std::string> tags;
+	std::vector<int> ids;
+	std::string_view name;
+	cli::CommandLine test(
+	    "test",
+	    {cli::StoreTrue("--verbose", verbose),
+	     cli::Argument("--threads", threads),
+	     cli::Argument("--tag", tags, cli::arity = cli::Arity::Inclusive(0, 2)),
+	     cli::Argument(
+	         "--ids",
+	         ids,
+	         cli::separator = ',',
+	         cli::arity = cli::Arity::Optional()),
+	     cli::Argument("--name", name, cli::arity = cli::Arity::Optional())});
+
+	const std::array<const char *, 6> args{
+	    "--threads=8", "--tag=a=b", "--tag", "", "--name=x", "--ids=7"};
+	ASSERT_TRUE(test.TryRun("test", 6, args.data()));
+	ASSERT_EQ(8, threads);
+	ASSERT_EQ((std::vector<std::string>{"a=b", ""}), tags);
+	ASSERT_EQ(std::vector<int>{7}, ids);
+	// the value refers to argv
+	ASSERT_EQ(args[4] + 7, name.data());
+
+	// both forms count toward the same arity
+	const std::array<const char *, 4> tooMany{
+	    "--tag=a", "--tag", "b", "--tag="};
+	ASSERT_TRUE(test.TryRun("test", 3, tooMany.data()));
+	cli::ParseResult result = test.TryRun("test", 4, tooMany.data());
+	ASSERT_EQ(cli::ErrorCode::TOO_MANY_VALUES, result.GetErrorCode());
+	ASSERT_EQ(3U, result.GetIndex());
+
+	const std::array<const char *, 2> errors{"--threads=x", "--verbose=1"};
+	result = test.TryRun("test", 1, &errors[0]);
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(0U, result.GetIndex());
+	result = test.TryRun("test", 1, &errors[1]);
+	ASSERT_EQ(cli::ErrorCode::UNEXPECTED_VALUE, result.GetErrorCode());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  --verbose does not take a value: "
+	    "--verbose=1",
+	    result.GetMessage());
+	const std::array<const char *, 1> unknown{"--thread=8"};
+	result = test.TryRun("test", 1, unknown.data());
+	ASSERT_EQ(cli::ErrorCode::UNKNOWN_FLAG, result.GetErrorCode());
+	ASSERT_STREQ("--threads", result.GetSuggestion());
+}
+
+
+TEST(command_line, environment)
+{
+	int threads = 0;
+	bool verbose = false;
+	std::vector<int> ids;
+	std::string file;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("file", file, cli::environment = "TEST_FILE"),
+	     cli::Argument("--threads", threads, cli::environment = "TEST_THREADS"),
+	     cli::StoreTrue(
+	         "--verbose", verbose, cli::environment = "TEST_VERBOSE"),
+	     cli::Argument(
+	         "--ids",
+	         ids,
+	         cli::separator = ',',
+	         cli::arity = cli::Arity::Inclusive(2, 3),
+	         cli::environment = "TEST_IDS")});
+	cli::ParseContext context = test.MakeContext();
+
+	// variables fill arguments that were not given, including required ones
+	const std::array<const char *, 6> environment{
+	    "TEST_THREADS=8",
+	    "TEST_VERBOSE=yes",
+	    "TEST_IDS=1,2",
+	    "TEST_FILE=in.txt",
+	    "TEST_UNRELATED=x",
+	    nullptr};
+	context.SetEnvironment(environment.data());
+	ASSERT_TRUE(test.TryRun(context, "test", 0, environment.data()));
+	ASSERT_EQ(8, threads);
+	ASSERT_TRUE(verbose);
+	ASSERT_EQ((std::vector<int>{1, 2}), ids);
+	ASSERT_EQ("in.txt", file);
+
+	// the command line takes precedence
+	ids.clear();
+	const std::array<const char *, 5> args{
+	    "out.txt", "--threads", "2", "--ids", "3,4,5"};
+	ASSERT_TRUE(test.TryRun(context, "test", 5, args.data()));
+	ASSERT_EQ(2, threads);
+	ASSERT_EQ((std::vector<int>{3, 4, 5}), ids);
+	ASSERT_EQ("out.txt", file);
+
+	// values from the environment count toward the arity
+	ids.clear();
+	const std::array<const char *, 4> tooFew{
+	    "TEST_IDS=1", "TEST_THREADS=1", "TEST_FILE=a", nullptr};
+	context.SetEnvironment(tooFew.data());
+	cli::ParseResult result = test.TryRun(context, "test", 0, args.data());
+	ASSERT_EQ(cli::ErrorCode::TOO_FEW_VALUES, result.GetErrorCode());
+	ASSERT_STREQ("--ids", result.GetArgumentName());
+	const std::array<const char *, 4> tooMany{
+	    "TEST_IDS=1,2,3,4", "TEST_THREADS=1", "TEST_FILE=a", nullptr};
+	context.SetEnvironment(tooMany.data());
+	result = test.TryRun(context, "test", 0, args.data());
+	ASSERT_EQ(cli::ErrorCode::TOO_MANY_VALUES, result.GetErrorCode());
+	ASSERT_EQ(cli::ParseResult::npos, result.GetIndex());
+
+	const std::array<const char *, 3> invalid{
+	    "TEST_IDS=1,2", "TEST_THREADS=many", nullptr};
+	context.SetEnvironment(invalid.data());
+	result = test.TryRun(context, "test", 1, args.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(cli::ParseResult::npos, result.GetIndex());
+	ASSERT_STREQ("--threads", result.GetArgumentName());
+	const std::array<const char *, 3> invalidSwitch{
+	    "TEST_IDS=1,2", "TEST_VERBOSE=maybe", nullptr};
+	context.SetEnvironment(invalidSwitch.data());
+	result = test.TryRun(context, "test", 3, args.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_STREQ("--verbose", result.GetArgumentName());
+
+	// contexts read the environment of the process by default
+	cli::CommandLine process(
+	    "test",
+	    {cli::Argument(
+	        "--threads", threads, cli::environment = "TEST_THREADS")});
+	::setenv("TEST_THREADS", "16", 1);
+	const bool isSuccess = process.TryRun("test", 0, args.data()).IsSuccess();
+	::unsetenv("TEST_THREADS");
+	ASSERT_TRUE(isSuccess);
+	ASSERT_EQ(16, threads);
+}
+
+
+TEST(command_line, try_run_success)
+{
+	int count = 0;
+	bool verbose = false;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("--count", count),
+	     cli::StoreTrue("--verbose", verbose)});
+
+	const std::array<const char *, 4> args{
+	    "test", "--count", "3", "--verbose"};
+	const cli::ParseResult result = test.TryRun(args.size(), args.data());
+	ASSERT_TRUE(result);
+	ASSERT_FALSE(result.IsExit());
+	ASSERT_EQ(cli::ErrorCode::NONE, result.GetErrorCode());
+	ASSERT_EQ("", result.GetMessage());
+	ASSERT_EQ(3, count);
+	ASSERT_TRUE(verbose);
+}
+
+
+TEST(command_line, try_run_errors)
+{
+	int count = 0;
+	std::vector<int> values;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("--count", count, arity = cli::Arity::Optional()),
+	     cli::Argument("values", values, arity = cli::Arity::AtLeast(1))});
+
+	const std::array<const char *, 2> unknown{"1", "--cuont"};
+	cli::ParseResult result = test.TryRun("test", 2, unknown.data());
+	ASSERT_FALSE(result);
+	ASSERT_EQ(cli::ErrorCode::UNKNOWN_FLAG, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+	ASSERT_STREQ("--cuont", result.GetArgumentName());
+	ASSERT_STREQ("--count", result.GetSuggestion());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Unknown flag: --cuont.  Did you "
+	    "mean --count?",
+	    result.GetMessage());
+
+	const std::array<const char *, 5> twice{
+	    "--count", "1", "--count", "2", "3"};
+	result = test.TryRun("test", 5, twice.data());
+	ASSERT_EQ(cli::ErrorCode::TOO_MANY_VALUES, result.GetErrorCode());
+	ASSERT_EQ(2U, result.GetIndex());
+	ASSERT_STREQ("--count", result.GetArgumentName());
+
+	const std::array<const char *, 2> missing{"1", "--count"};
+	result = test.TryRun("test", 2, missing.data());
+	ASSERT_EQ(cli::ErrorCode::MISSING_VALUE, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+
+	const std::array<const char *, 1> none{"--count"};
+	result = test.TryRun("test", 0, none.data());
+	ASSERT_EQ(cli::ErrorCode::TOO_FEW_VALUES, result.GetErrorCode());
+	ASSERT_EQ(cli::ParseResult::npos, result.GetIndex());
+	ASSERT_STREQ("values", result.GetArgumentName());
+
+	const std::array<const char *, 4> invalid{"test", "--count", "x", "1"};
+	result = test.TryRun(4, invalid.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(2U, result.GetIndex());
+	ASSERT_STREQ("--count", result.GetArgumentName());
+#ifndef CLI_NO_EXCEPTIONS
+	ASSERT_TRUE(result.GetCause());
+#endif
+	ASSERT_FALSE(result.GetMessage().empty());
+
+	result = test.TryRun("test", -1, none.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_CALL, result.GetErrorCode());
+}
+
+
+#ifndef CLI_NO_EXCEPTIONS
+TEST(command_line, run_rethrows_cause)
+{
+	int count = 0;
+	cli::CommandLine test("test", {cli::Argument("--count", count)});
+
+	const std::array<const char *, 2> args{"--count", "x"};
+	const cli::ParseResult result = test.TryRun("test", 2, args.data());
+	try
+	{
+		test.Run("test", 2, args.data());
+		FAIL();
+	}
+	catch(const std::exception &e)
+	{
+		ASSERT_EQ(result.GetMessage(), e.what());
+	}
+}
+#endif
+
+
 } // namespace
@@ -0,0 +1,267 @@
+#include "cli/Argument.hpp"
+#include "cli/BooleanFlags.hpp"
+#include "cli/CommandLine.hpp"
+#include "cli/details/ConfigFile.hpp"
+
+#include "TempFile.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+
+struct ConfigEntry
+{
+	std::string section;
+	std::string key;
+	std::string value;
+	bool isTerminated;
+	std::size_t line;
+	std::size_t column;
+
+	bool operator==(const ConfigEntry &other) const
+	{
+		return section == other.section && key == other.key
+		    && value == other.value && isTerminated == other.isTerminated
+		    && line == other.line && column == other.column;
+	}
+};
+
+// reads every entry of a file, returning null on failure
+std::optional<std::vector<ConfigEntry>> ReadConfigFile(const std::string &path)
+{
+	cli::details::ConfigFile file;
+	EXPECT_TRUE(file.Open(path.c_str()));
+	std::vector<ConfigEntry> entries;
+	const bool isRead =
+	    file.Read([&](const cli::details::ConfigFile::Entry &entry) {
+		    entries.push_back(ConfigEntry{
+		        std::string(entry.section),
+		        entry.key,
+		        std::string(entry.value),
+		        entry.isTerminated,
+		        entry.line,
+		        entry.column});
+		    return true;
+	    });
+	if(!isRead)
+	{
+		return std::nullopt;
+	}
+	return entries;
+}
+
+
+TEST(config_file, syntax)
+{
+	const std::string path = WriteTempFile(
+	    "syntax.ini",
+	    "# comment\n"
+	    "; comment\n"
+	    "name = plain text  # comment\n"
+	    "\n"
+	    "[server]\r\n"
+	    "  port=80\r\n"
+	    "host = \"a \\\"quoted\\\"\\tvalue\"\n"
+	    "path = 'C:\\dir'\n"
+	    "ids = [1, \"two\",\n"
+	    "  3] # comment\n"
+	    "last = end");
+	const std::vector<ConfigEntry> expected{
+	    {"", "name", "plain text", true, 3, 8},
+	    {"server", "port", "80", true, 6, 8},
+	    {"server", "host", "a \"quoted\"\tvalue", true, 7, 8},
+	    {"server", "path", "C:\\dir", true, 8, 8},
+	    {"server", "ids", "1", false, 9, 8},
+	    {"server", "ids", "two", false, 9, 11},
+	    {"server", "ids", "3", false, 10, 3},
+	    {"server", "last", "end", true, 11, 8}};
+	ASSERT_EQ(expected, ReadConfigFile(path));
+}
+
+
+TEST(config_file, syntax_errors)
+{
+	const std::array<std::pair<const char *, const char *>, 7> files{{
+	    {"key value\n", "1:5: Expected '=' after the key."},
+	    {"ok = 1\n= value\n", "2:1: Expected a key."},
+	    {"key =\n", "1:6: Expected a value."},
+	    {"key = \"open\n", "1:12: Unterminated string."},
+	    {"key = \"a\" b\n", "1:11: Expected the end of the line."},
+	    {"[section\n", "1:9: Expected a section name and ']'."},
+	    {"key = [1, 2\n", "2:1: Unterminated array."},
+	}};
+	for(const auto &[contents, message] : files)
+	{
+		const std::string path = WriteTempFile("errors.ini", contents);
+		cli::details::ConfigFile file;
+		ASSERT_TRUE(file.Open(path.c_str()));
+		ASSERT_FALSE(file.Read(
+		    [](const cli::details::ConfigFile::Entry &) { return true; }));
+		const cli::details::ConfigFile::Error &error = file.GetError();
+		ASSERT_EQ(
+		    message,
+		    std::to_string(error.line) + ':' + std::to_string(error.column)
+		        + ": " + error.detail);
+	}
+}
+
+
+TEST(config_file, run)
+{
+	int threads = 0;
+	bool verbose = false;
+	std::vector<std::string> tags;
+	std::vector<int> ids;
+	std::string_view host;
+	std::optional<int> port;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("--threads", threads),
+	     cli::StoreTrue("--verbose", verbose),
+	     cli::Argument("--tag", tags, cli::arity = cli::Arity::Inclusive(0, 3)),
+	     cli::Argument(
+	         "--ids",
+	         ids,
+	         cli::separator = ',',
+	         cli::arity = cli::Arity::Unbounded()),
+	     cli::Argument("--server.host", host),
+	     cli::Argument("--server.port", port)});
+	cli::ParseContext context = test.MakeContext();
+	const std::string path = WriteTempFile(
+	    "run.ini",
+	    "threads = 4\n"
+	    "verbose = true\n"
+	    "tag = [a, b]\n"
+	    "ids = \"1,2\"\n"
+	    "[server]\n"
+	    "host = example.com\n"
+	    "port = 8080\n");
+	context.SetConfigFile(path.c_str());
+
+	// required flags are satisfied by the file
+	const std::array<const char *, 4> args{"--threads", "8", "--tag", "c"};
+	ASSERT_TRUE(test.TryRun(context, "test", 0, args.data()));
+	ASSERT_EQ(4, threads);
+	ASSERT_TRUE(verbose);
+	ASSERT_EQ((std::vector<std::string>{"a", "b"}), tags);
+	ASSERT_EQ((std::vector<int>{1, 2}), ids);
+	ASSERT_EQ("example.com", host);
+	ASSERT_EQ(8080, port);
+
+	// the command line overrides the file
+	tags.clear();
+	ids.clear();
+	ASSERT_TRUE(test.TryRun(context, "test", 4, args.data()));
+	ASSERT_EQ(8, threads);
+	ASSERT_EQ(std::vector<std::string>{"c"}, tags);
+}
+
+
+TEST(config_file, environment)
+{
+	bool verbose = false;
+	std::vector<int> ids;
+	int threads = 0;
+	cli::CommandLine test(
+	    "test",
+	    {cli::StoreTrue("--verbose", verbose, cli::environment = "VERBOSE"),
+	     cli::Argument(
+	         "--ids",
+	         ids,
+	         cli::separator = ',',
+	         cli::arity = cli::Arity::Unbounded(),
+	         cli::environment = "IDS"),
+	     cli::Argument("--threads", threads, cli::environment = "THREADS")});
+	cli::ParseContext context = test.MakeContext();
+	const std::string path = WriteTempFile(
+	    "environment.ini", "verbose = true\nids = \"1,2\"\nthreads = 4\n");
+	context.SetConfigFile(path.c_str());
+
+	// variables that give no values still override the file
+	std::array<const char *, 4> environment{
+	    "VERBOSE=false", "IDS=", "THREADS=2", nullptr};
+	context.SetEnvironment(environment.data());
+	ASSERT_TRUE(test.TryRun(context, "test", 0, environment.data()));
+	ASSERT_FALSE(verbose);
+	ASSERT_TRUE(ids.empty());
+	ASSERT_EQ(2, threads);
+
+	// unset variables do not
+	environment[0] = nullptr;
+	ASSERT_TRUE(test.TryRun(context, "test", 0, environment.data()));
+	ASSERT_TRUE(verbose);
+	ASSERT_EQ((std::vector<int>{1, 2}), ids);
+	ASSERT_EQ(4, threads);
+}
+
+
+TEST(config_file, run_errors)
+{
+	int threads = 0;
+	std::vector<int> ids;
+	bool verbose = false;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument(
+	         "--threads",
+	         threads,
+	         cli::arity = cli::Arity::Optional()),
+	     cli::Argument("--ids", ids, cli::arity = cli::Arity::Inclusive(0, 2)),
+	     cli::StoreTrue("--verbose", verbose)});
+	cli::ParseContext context = test.MakeContext();
+	const std::array<const char *, 1> args{"--verbose"};
+
+	const std::string unknown =
+	    WriteTempFile("unknown.ini", "threads = 1\n[server]\nport = 2\n");
+	context.SetConfigFile(unknown.c_str());
+	cli::ParseResult result = test.TryRun(context, "test", 0, args.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_CONFIG_FILE, result.GetErrorCode());
+	ASSERT_EQ(unknown, result.GetFile());
+	ASSERT_EQ(3U, result.GetLine());
+	ASSERT_EQ(8U, result.GetColumn());
+	ASSERT_EQ(
+	    unknown + ":3:8: Invalid config file.  Unknown key: port",
+	    result.GetMessage());
+
+	const std::string invalid = WriteTempFile("invalid.ini", "ids = [1, x]\n");
+	context.SetConfigFile(invalid.c_str());
+	result = test.TryRun(context, "test", 0, args.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetLine());
+	ASSERT_EQ(11U, result.GetColumn());
+	ASSERT_EQ(0U, result.GetMessage().find(invalid + ":1:11: "));
+
+	const std::string tooMany =
+	    WriteTempFile("too_many.ini", "ids = [1, 2]\nids = 3\n");
+	context.SetConfigFile(tooMany.c_str());
+	result = test.TryRun(context, "test", 0, args.data());
+	ASSERT_EQ(cli::ErrorCode::TOO_MANY_VALUES, result.GetErrorCode());
+	ASSERT_EQ(2U, result.GetLine());
+
+	const std::string syntax = WriteTempFile("syntax_error.ini", "a b\n");
+	context.SetConfigFile(syntax.c_str());
+	result = test.TryRun(context, "test", 0, args.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_CONFIG_FILE, result.GetErrorCode());
+	ASSERT_EQ(
+	    syntax + ":1:3: Invalid config file.  Expected '=' after the key.",
+	    result.GetMessage());
+
+	const std::string missing = ::testing::TempDir() + "missing.ini";
+	context.SetConfigFile(missing.c_str());
+	result = test.TryRun(context, "test", 0, args.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_CONFIG_FILE, result.GetErrorCode());
+	ASSERT_EQ(
+	    "Invalid config file.  Could not read: " + missing,
+	    result.GetMessage());
+}
+
+
+} // namespace
@@ -2,6 +2,8 @@
 
 #include "cli/details/Destination.hpp"
 
+#include "ErrorAssertions.hpp"
+
 namespace
 {
 
@@ -9,7 +11,7 @@ TEST(destination, int)
 {
 	int value = -1;
 	cli::details::Destination dest(value);
-	dest.Store("1");
+	dest.Store("1", 0);
 	ASSERT_EQ(1, value);
 }
 
@@ -21,18 +23,18 @@ TEST(destination, int_array)
 	cli::details::Destination dest(array);
 	cli::details::Destination cDest(cArray);
 
-	dest.Store("1");
-	cDest.Store("1");
+	dest.Store("1", 0);
+	cDest.Store("1", 0);
 	ASSERT_EQ(1, array[0]);
 	ASSERT_EQ(1, cArray[0]);
 
-	dest.Store("2");
-	cDest.Store("2");
+	dest.Store("2", 1);
+	cDest.Store("2", 1);
 	ASSERT_EQ(2, array[1]);
 	ASSERT_EQ(2, cArray[1]);
 
-	ASSERT_THROW(dest.Store("3"), std::runtime_error);
-	ASSERT_THROW(cDest.Store("3"), std::runtime_error);
+	CLI_ASSERT_ERROR(dest.Store("3", 2), std::runtime_error);
+	CLI_ASSERT_ERROR(cDest.Store("3", 2), std::runtime_error);
 }
 
 TEST(destination, char_array)
@@ -43,13 +45,44 @@ TEST(destination, char_array)
 	cli::details::Destination dest(array);
 	cli::details::Destination cDest(cArray);
 
-	ASSERT_THROW(dest.Store("testX"), std::invalid_argument);
-	ASSERT_THROW(dest.Store("testX"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(dest.Store("testX", 0), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cDest.Store("testX", 0), std::invalid_argument);
 
-	dest.Store("test");
-	cDest.Store("test");
+	dest.Store("test", 0);
+	cDest.Store("test", 0);
 	ASSERT_STREQ("test", array.data());
 	ASSERT_STREQ("test", cArray);
 }
 
+struct Object
+{
+	int value = -1;
+	std::array<int, 2> array{0, 0};
+};
+
+TEST(destination, member)
+{
+	const cli::details::Destination dest =
+	    cli::details::Destination::ForMember<&Object::value>();
+	const cli::details::Destination arrayDest =
+	    cli::details::Destination::ForMember<&Object::array>();
+	ASSERT_EQ(cli::details::TypeTag<Object>(), dest.GetObjectType());
+
+	Object first;
+	Object second;
+	dest.Store("1", 0, &first);
+	dest.Store("2", 0, &second);
+	arrayDest.Store("3", 1, &first);
+	ASSERT_EQ(1, first.value);
+	ASSERT_EQ(2, second.value);
+	ASSERT_EQ(3, first.array[1]);
+	ASSERT_EQ(&second.value, dest.Locate(&second));
+}
+
+TEST(destination, bound_has_no_object_type)
+{
+	int value = -1;
+	ASSERT_EQ(nullptr, cli::details::Destination(value).GetObjectType());
+}
+
 } // namespace
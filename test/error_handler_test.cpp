@@ -0,0 +1,86 @@
+#include "cli/Argument.hpp"
+#include "cli/CommandLine.hpp"
+#include "cli/ErrorHandler.hpp"
+
+#include "ErrorAssertions.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+
+struct Even
+{
+	int value = 0;
+};
+
+bool CLIParse(Even &even, const char *input)
+{
+	even.value = std::atoi(input);
+	return even.value % 2 == 0;
+}
+
+TEST(error_handler, user_parse_returning_bool)
+{
+	Even even;
+	cli::CommandLine test("test", {cli::Argument("--even", even)});
+
+	const std::array<const char *, 2> good{"--even", "4"};
+	ASSERT_TRUE(test.TryRun("test", 2, good.data()));
+	ASSERT_EQ(4, even.value);
+
+	const std::array<const char *, 2> bad{"--even", "3"};
+	const cli::ParseResult result = test.TryRun("test", 2, bad.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+	ASSERT_EQ("Invalid value.", result.GetMessage());
+	CLI_ASSERT_ERROR(test.Run("test", 2, bad.data()), std::invalid_argument);
+}
+
+TEST(error_handler, parse_failure_message)
+{
+	char name[4];
+	cli::CommandLine test("test", {cli::Argument("--name", name)});
+
+	const std::array<const char *, 2> args{"--name", "long"};
+	const cli::ParseResult result = test.TryRun("test", 2, args.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(
+	    "Command line argument does not fit in fixed size character array",
+	    result.GetMessage());
+}
+
+void PrintError(const char *message)
+{
+	std::fprintf(stderr, "handled: %s\n", message);
+}
+
+TEST(error_handler, set_returns_previous)
+{
+	ASSERT_EQ(nullptr, cli::SetErrorHandler(PrintError));
+	ASSERT_EQ(PrintError, cli::SetErrorHandler(nullptr));
+}
+
+#ifdef CLI_NO_EXCEPTIONS
+TEST(error_handler, called_on_error)
+{
+	int value = 0;
+	cli::CommandLine test("test", {cli::Argument("--value", value)});
+
+	const std::array<const char *, 1> unknown{"--other"};
+	ASSERT_DEATH(
+	    {
+		    cli::SetErrorHandler(PrintError);
+		    test.Run("test", 1, unknown.data());
+	    },
+	    "handled: Invalid command line arguments.  Unknown flag: --other");
+}
+#endif
+
+
+} // namespace
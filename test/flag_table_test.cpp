@@ -0,0 +1,104 @@
+#include "cli/details/EditDistance.hpp"
+#include "cli/details/FlagTable.hpp"
+#include "cli/details/PrefixTable.hpp"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using cli::details::FlagTable;
+
+TEST(flag_table, empty)
+{
+	FlagTable defaultTable;
+	ASSERT_EQ(FlagTable::npos, defaultTable.Find("--flag"));
+
+	FlagTable sizedTable(0);
+	ASSERT_EQ(FlagTable::npos, sizedTable.Find("--flag"));
+}
+
+TEST(flag_table, find)
+{
+	FlagTable table(2);
+	table.Insert("--foo", 3);
+	table.Insert("--bar", 7);
+
+	ASSERT_EQ(3, table.Find("--foo"));
+	ASSERT_EQ(7, table.Find("--bar"));
+	ASSERT_EQ(FlagTable::npos, table.Find("--baz"));
+	ASSERT_EQ(FlagTable::npos, table.Find("--fo"));
+	ASSERT_EQ(FlagTable::npos, table.Find(""));
+}
+
+TEST(flag_table, duplicate_keeps_first)
+{
+	FlagTable table(2);
+	table.Insert("--foo", 1);
+	table.Insert("--foo", 2);
+	ASSERT_EQ(1, table.Find("--foo"));
+}
+
+TEST(flag_table, many)
+{
+	std::vector<std::string> names;
+	for(std::size_t i = 0; i < 1000; ++i)
+	{
+		names.push_back("--flag" + std::to_string(i));
+	}
+	FlagTable table(names.size());
+	for(std::size_t i = 0; i < names.size(); ++i)
+	{
+		table.Insert(names[i], i);
+	}
+	for(std::size_t i = 0; i < names.size(); ++i)
+	{
+		ASSERT_EQ(i, table.Find(names[i]));
+	}
+	ASSERT_EQ(FlagTable::npos, table.Find("--flag1000"));
+}
+
+TEST(prefix_table, find)
+{
+	cli::details::PrefixTable table;
+	table.Insert("--verbose", 0);
+	table.Insert("--value", 1);
+	table.Insert("--values", 2);
+	table.Sort();
+
+	ASSERT_EQ(0U, table.Find("--verb").index);
+	ASSERT_EQ(0U, table.Find("--verbose").index);
+	// an exact name is preferred over longer names it is a prefix of
+	ASSERT_EQ(1U, table.Find("--value").index);
+	ASSERT_EQ(2U, table.Find("--values").index);
+	ASSERT_EQ(cli::details::PrefixTable::npos, table.Find("--x").index);
+	ASSERT_EQ(nullptr, table.Find("--x").first);
+
+	const cli::details::PrefixTable::Match match = table.Find("--v");
+	ASSERT_EQ(cli::details::PrefixTable::npos, match.index);
+	ASSERT_STREQ("--value", match.first);
+	ASSERT_STREQ("--values", match.second);
+}
+
+TEST(edit_distance, bounded)
+{
+	using cli::details::EditDistance;
+	ASSERT_EQ(0U, EditDistance("--count", "--count", 2));
+	ASSERT_EQ(1U, EditDistance("--cout", "--count", 2));
+	ASSERT_EQ(1U, EditDistance("--counts", "--count", 2));
+	ASSERT_EQ(1U, EditDistance("--cuont", "--count", 2));
+	ASSERT_EQ(2U, EditDistance("--cnout", "--count", 2));
+	ASSERT_EQ(3U, EditDistance("--verbose", "--count", 2));
+	ASSERT_EQ(3U, EditDistance("--c", "--count", 2));
+	ASSERT_EQ(1U, EditDistance("", "a", 2));
+	ASSERT_EQ(0U, EditDistance("", "", 2));
+	// a shared prefix and suffix are skipped before the length limit applies
+	const std::string longName(100, 'a');
+	ASSERT_EQ(1U, EditDistance(longName, longName + 'b', 2));
+	ASSERT_EQ(3U, EditDistance('b' + longName, longName + 'b', 2));
+}
+
+} // namespace
@@ -0,0 +1,129 @@
+#include "cli/Argument.hpp"
+#include "cli/CommandLine.hpp"
+#include "cli/Lazy.hpp"
+#include "cli/StaticArgument.hpp"
+#include "cli/StaticCommandLine.hpp"
+#include "cli/details/GetDefaultArity.hpp"
+
+#include "ErrorAssertions.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+TEST(lazy, converts_on_access)
+{
+	cli::Lazy<int> count;
+	cli::CommandLine test("test", {cli::Argument("--count", count)});
+	const std::array<const char *, 2> args{"--count", "12"};
+	ASSERT_TRUE(test.TryRun("test", 2, args.data()));
+	ASSERT_TRUE(count.IsPending());
+	ASSERT_EQ(12, count.Get());
+	ASSERT_FALSE(count.IsPending());
+	ASSERT_EQ(12, *count);
+}
+
+TEST(lazy, default_value)
+{
+	cli::Lazy<int> count(5);
+	cli::Lazy<std::vector<int>> values(std::vector<int>{1});
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("--count", count, cli::arity = cli::Arity::Optional()),
+	     cli::Argument("values", values)});
+	const std::array<const char *, 2> args{"2", "3"};
+	ASSERT_TRUE(test.TryRun("test", 2, args.data()));
+	ASSERT_EQ(5, count.Get());
+	// values are stored on top of the default like a std::vector destination
+	ASSERT_EQ((std::vector<int>{1, 2, 3}), values.Get());
+}
+
+TEST(lazy, lists)
+{
+	cli::Lazy<std::vector<int>> values;
+	cli::Lazy<std::vector<std::string>> tags;
+	cli::Lazy<std::array<int, 2>> pair;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("--tags", tags, cli::separator = ','),
+	     cli::Argument("--pair", pair),
+	     cli::Argument("values", values)});
+	const std::array<const char *, 8> args{
+	    "--tags", "a,bc,", "--pair", "4", "--pair", "5", "1", "2"};
+	ASSERT_TRUE(test.TryRun("test", 8, args.data()));
+	ASSERT_EQ((std::vector<int>{1, 2}), values.Get());
+	ASSERT_EQ((std::vector<std::string>{"a", "bc", ""}), tags.Get());
+	ASSERT_EQ((std::array<int, 2>{4, 5}), pair.Get());
+
+	// arity checks use the arity of the wrapped type
+	const std::array<const char *, 8> tooMany{
+	    "--tags", "a", "--pair", "1", "--pair", "2", "--pair", "3"};
+	ASSERT_EQ(
+	    cli::ErrorCode::TOO_MANY_VALUES,
+	    test.TryRun("test", 8, tooMany.data()).GetErrorCode());
+}
+
+TEST(lazy, default_arity)
+{
+	using cli::details::GetDefaultArity;
+	ASSERT_EQ(cli::Arity::Exactly(1), GetDefaultArity(cli::Lazy<int>()));
+	ASSERT_EQ(
+	    cli::Arity::Unbounded(),
+	    GetDefaultArity(cli::Lazy<std::vector<int>>()));
+	ASSERT_EQ(
+	    cli::Arity::NoMoreThan(3),
+	    GetDefaultArity(cli::Lazy<std::array<int, 3>>()));
+	ASSERT_EQ(
+	    cli::Arity::Optional(),
+	    GetDefaultArity(cli::Lazy<std::optional<int>>()));
+}
+
+TEST(lazy, errors_on_access)
+{
+	cli::Lazy<int> count(5);
+	cli::CommandLine test("test", {cli::Argument("--count", count)});
+	const std::array<const char *, 2> args{"--count", "x"};
+	// the run does not convert the value so it succeeds
+	ASSERT_TRUE(test.TryRun("test", 2, args.data()));
+	CLI_ASSERT_PARSE_ERROR(count.Validate(), std::invalid_argument);
+	// the string is kept so every access fails
+	ASSERT_TRUE(count.IsPending());
+	CLI_ASSERT_ERROR(count.Get(), std::invalid_argument);
+
+	const std::array<const char *, 2> valid{"--count", "7"};
+	ASSERT_TRUE(test.TryRun("test", 2, valid.data()));
+	ASSERT_EQ(7, count.Get());
+}
+
+TEST(lazy, later_runs)
+{
+	cli::Lazy<int> count;
+	cli::CommandLine test("test", {cli::Argument("--count", count)});
+	const std::array<const char *, 2> first{"--count", "1"};
+	const std::array<const char *, 2> second{"--count", "2"};
+	ASSERT_TRUE(test.TryRun("test", 2, first.data()));
+	ASSERT_EQ(1, count.Get());
+	ASSERT_TRUE(test.TryRun("test", 2, second.data()));
+	ASSERT_EQ(2, count.Get());
+}
+
+constexpr char lazyFlagName[] = "--flag";
+
+TEST(lazy, static_command_line)
+{
+	cli::Lazy<int> value;
+	cli::StaticCommandLine test(
+	    "test", cli::StaticArgument<lazyFlagName>(value));
+	const std::array<const char *, 2> args{"--flag", "4"};
+	ASSERT_FALSE(test.Run("test", 2, args.data()));
+	ASSERT_TRUE(value.IsPending());
+	ASSERT_EQ(4, value.Get());
+}
+
+} // namespace
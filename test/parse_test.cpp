@@ -1,7 +1,15 @@
 #include "cli/Parse.hpp"
 
+#include "ErrorAssertions.hpp"
+
 #include "gtest/gtest.h"
 
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <vector>
+
 namespace
 {
 
@@ -10,7 +18,37 @@ TEST(parse, int)
 	int value = -1;
 	cli::Parse(value, "12");
 	ASSERT_EQ(12, value);
-	ASSERT_THROW(cli::Parse(value, "bad"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, "bad"), std::invalid_argument);
+}
+
+TEST(parse, int_strict)
+{
+	int value = 0;
+	ASSERT_TRUE(cli::Parse(value, "+7"));
+	ASSERT_EQ(7, value);
+	ASSERT_TRUE(cli::Parse(value, "-2147483648"));
+	ASSERT_EQ(-2147483648LL, value);
+
+	value = 3;
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, ""), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, "12abc"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, "1.5"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, " 1"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, "+-1"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(
+	    cli::Parse(value, "2147483648"), std::invalid_argument);
+	ASSERT_EQ(3, value);
+
+	unsigned char byte = 0;
+	std::size_t size = 0;
+	ASSERT_TRUE(cli::Parse(size, "18446744073709551615"));
+	ASSERT_EQ(18446744073709551615ULL, size);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(size, "-1"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(
+	    cli::Parse(size, "18446744073709551616"), std::invalid_argument);
+	// character types still read a single character
+	ASSERT_TRUE(cli::Parse(byte, "7"));
+	ASSERT_EQ('7', byte);
 }
 
 TEST(parse, float)
@@ -18,7 +56,23 @@ TEST(parse, float)
 	float value = -1.0f;
 	cli::Parse(value, "12.34");
 	ASSERT_FLOAT_EQ(12.34f, value);
-	ASSERT_THROW(cli::Parse(value, "bad"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, "bad"), std::invalid_argument);
+}
+
+TEST(parse, double_strict)
+{
+	double value = 0.0;
+	ASSERT_TRUE(cli::Parse(value, "-1.5e3"));
+	ASSERT_DOUBLE_EQ(-1500.0, value);
+	ASSERT_TRUE(cli::Parse(value, "+.25"));
+	ASSERT_DOUBLE_EQ(0.25, value);
+
+	value = 2.0;
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, "1.5x"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, "1e999"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, "0x10"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, ""), std::invalid_argument);
+	ASSERT_DOUBLE_EQ(2.0, value);
 }
 
 TEST(parse, string)
@@ -34,8 +88,8 @@ TEST(parse, string)
 	cli::Parse(cArray, "test");
 	ASSERT_STREQ("test", cArray);
 
-	ASSERT_THROW(cli::Parse(array, "testX"), std::invalid_argument);
-	ASSERT_THROW(cli::Parse(cArray, "testX"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(array, "testX"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(cArray, "testX"), std::invalid_argument);
 }
 
 TEST(parse, optional)
@@ -47,7 +101,7 @@ TEST(parse, optional)
 	ASSERT_EQ(1, optional.value());
 
 	optional.reset();
-	ASSERT_THROW(cli::Parse(optional, "bad"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(optional, "bad"), std::invalid_argument);
 	ASSERT_FALSE(optional.has_value());
 }
 
@@ -66,7 +120,8 @@ TEST(parse, optional_vector)
 {
 	std::optional<std::vector<int>> maybeVector;
 
-	ASSERT_THROW(cli::Parse(maybeVector, "bad"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(
+	    cli::Parse(maybeVector, "bad"), std::invalid_argument);
 	ASSERT_FALSE(maybeVector.has_value());
 
 	cli::Parse(maybeVector, "1");
@@ -110,7 +165,7 @@ TEST(parse, map)
 	ASSERT_EQ(3, map.at("foo"));
 	ASSERT_EQ(2, map.at("bar"));
 
-	ASSERT_THROW(cli::Parse(map, "cat4"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(map, "cat4"), std::invalid_argument);
 }
 
 TEST(parse, unordered_map)
@@ -124,7 +179,7 @@ TEST(parse, unordered_map)
 	ASSERT_EQ(3, map.at("foo"));
 	ASSERT_EQ(2, map.at("bar"));
 
-	ASSERT_THROW(cli::Parse(map, "cat4"), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(map, "cat4"), std::invalid_argument);
 }
 
 struct Streamable
@@ -145,6 +200,7 @@ TEST(parse, streamable)
 	ASSERT_TRUE(value.streamCalled);
 }
 
+#ifndef CLI_NO_EXCEPTIONS
 struct EvilStreamable
 {};
 
@@ -159,6 +215,7 @@ TEST(parse, evil_streamable)
 	EvilStreamable evil;
 	ASSERT_THROW(cli::Parse(evil, "evil"), std::invalid_argument);
 }
+#endif
 
 struct UserParseable : Streamable
 {
@@ -178,4 +235,94 @@ TEST(parse, user_parseable)
 	EXPECT_FALSE(value.streamCalled);
 }
 
+struct ViewParseable
+{
+	std::string value;
+	int calls = 0;
+};
+
+bool CLIParse(ViewParseable &parseable, std::string_view input)
+{
+	parseable.value = input;
+	++parseable.calls;
+	return !input.empty();
+}
+
+TEST(parse, view_parseable)
+{
+	ViewParseable value;
+	ASSERT_TRUE(cli::Parse(value, "abc"));
+	ASSERT_EQ("abc", value.value);
+	ASSERT_TRUE(cli::Parse(value, std::string_view("defg", 2)));
+	ASSERT_EQ("de", value.value);
+	ASSERT_EQ(2, value.calls);
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(value, ""), std::invalid_argument);
+
+	// keys and values of maps are parsed from sub-ranges of the input
+	std::map<int, ViewParseable> byId;
+	ASSERT_TRUE(cli::Parse(byId, "7=seven"));
+	ASSERT_EQ("seven", byId.at(7).value);
+}
+
+TEST(parse, string_view_input)
+{
+	const std::string_view input = "12,-3.5,text,word";
+	int integer = 0;
+	double real = 0;
+	std::string string;
+	char array[5];
+	UserParseable user;
+	ASSERT_TRUE(cli::Parse(integer, input.substr(0, 2)));
+	ASSERT_EQ(12, integer);
+	ASSERT_TRUE(cli::Parse(real, input.substr(3, 4)));
+	ASSERT_DOUBLE_EQ(-3.5, real);
+	ASSERT_TRUE(cli::Parse(string, input.substr(8, 4)));
+	ASSERT_EQ("text", string);
+	ASSERT_TRUE(cli::Parse(array, input.substr(13)));
+	ASSERT_STREQ("word", array);
+	// parsers taking a const char * are given a null terminated copy
+	cli::Parse(user, input.substr(13));
+	ASSERT_TRUE(user.parseCalled);
+	Streamable streamable;
+	cli::Parse(streamable, input.substr(0, 2));
+	ASSERT_TRUE(streamable.streamCalled);
+
+	CLI_ASSERT_PARSE_ERROR(
+	    cli::Parse(integer, input.substr(0, 3)), std::invalid_argument);
+	CLI_ASSERT_PARSE_ERROR(
+	    cli::Parse(array, input.substr(8)), std::invalid_argument);
+	ASSERT_EQ(12, integer);
+
+	std::map<int, std::string> map;
+	ASSERT_TRUE(cli::Parse(map, std::string_view("1=one,2=two", 5)));
+	ASSERT_EQ((std::map<int, std::string>{{1, "one"}}), map);
+}
+
+TEST(parse, pmr_containers)
+{
+	std::pmr::monotonic_buffer_resource resource;
+	std::pmr::vector<std::pmr::string> strings(&resource);
+	std::pmr::set<std::pmr::string> set(&resource);
+	std::pmr::map<std::pmr::string, std::pmr::string> map(&resource);
+	const char *const longString = "a-string-that-does-not-fit-in-sso";
+
+	ASSERT_TRUE(cli::Parse(strings, longString));
+	ASSERT_TRUE(cli::Parse(set, longString));
+	ASSERT_TRUE(cli::Parse(map, "a-key-that-does-not-fit-in-sso=a-value"));
+	// elements are constructed with the resource of their container
+	ASSERT_EQ(longString, strings[0]);
+	ASSERT_EQ(&resource, strings[0].get_allocator().resource());
+	ASSERT_EQ(&resource, set.begin()->get_allocator().resource());
+	ASSERT_EQ(&resource, map.begin()->first.get_allocator().resource());
+	ASSERT_EQ(&resource, map.begin()->second.get_allocator().resource());
+	ASSERT_EQ("a-value", map.begin()->second);
+
+	std::vector<bool> bools;
+	ASSERT_TRUE(cli::Parse(bools, "1"));
+	ASSERT_EQ(std::vector<bool>{true}, bools);
+	std::vector<int> ints{1};
+	CLI_ASSERT_PARSE_ERROR(cli::Parse(ints, "x"), std::invalid_argument);
+	ASSERT_EQ(std::vector<int>{1}, ints);
+}
+
 } // namespace
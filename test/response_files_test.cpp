@@ -0,0 +1,185 @@
+#include "cli/Argument.hpp"
+#include "cli/BooleanFlags.hpp"
+#include "cli/CommandLine.hpp"
+
+#include "TempFile.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+
+using cli::arity;
+
+// writes a response file, returning "@path"
+std::string WriteResponseFile(const char *name, const std::string &contents)
+{
+	return '@' + WriteTempFile(name, contents);
+}
+
+
+
+TEST(response_files, newline_delimited)
+{
+	std::vector<std::string> files;
+	bool verbose = false;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("files", files), cli::StoreTrue("--verbose", verbose)},
+	    cli::responseFiles = true);
+
+	const std::string response =
+	    WriteResponseFile("newline.rsp", "a.txt\r\n\n--verbose\nb c.txt");
+	const std::array<const char *, 3> args{"first", response.c_str(), "last"};
+	ASSERT_TRUE(test.TryRun("test", 3, args.data()));
+	ASSERT_EQ(
+	    (std::vector<std::string>{"first", "a.txt", "b c.txt", "last"}), files);
+	ASSERT_TRUE(verbose);
+}
+
+
+TEST(response_files, null_delimited)
+{
+	std::vector<std::string> files;
+	cli::CommandLine test(
+	    "test", {cli::Argument("files", files)}, cli::responseFiles = true);
+
+	const std::string response = WriteResponseFile(
+	    "null.rsp", std::string("a\nb\0c d\0", 8) + std::string("e", 1));
+	const std::array<const char *, 1> args{response.c_str()};
+	ASSERT_TRUE(test.TryRun("test", 1, args.data()));
+	ASSERT_EQ((std::vector<std::string>{"a\nb", "c d", "e"}), files);
+}
+
+
+TEST(response_files, nested)
+{
+	std::vector<int> values;
+	cli::CommandLine test(
+	    "test", {cli::Argument("values", values)}, cli::responseFiles = true);
+
+	const std::string inner = WriteResponseFile("inner.rsp", "2\n3\n");
+	const std::string outer =
+	    WriteResponseFile("outer.rsp", "1\n" + inner + "\n4\n");
+	const std::array<const char *, 2> args{outer.c_str(), "5"};
+	ASSERT_TRUE(test.TryRun("test", 2, args.data()));
+	ASSERT_EQ((std::vector<int>{1, 2, 3, 4, 5}), values);
+}
+
+
+TEST(response_files, page_sized)
+{
+	// a file filling whole pages has no room for a null terminator in its
+	// mapping
+	std::vector<std::string> values;
+	cli::CommandLine test(
+	    "test", {cli::Argument("values", values)}, cli::responseFiles = true);
+
+	const std::string contents = "x\n" + std::string(4094, 'y');
+	const std::string response = WriteResponseFile("page.rsp", contents);
+	const std::array<const char *, 1> args{response.c_str()};
+	ASSERT_TRUE(test.TryRun("test", 1, args.data()));
+	ASSERT_EQ((std::vector<std::string>{"x", std::string(4094, 'y')}), values);
+}
+
+
+TEST(response_files, errors)
+{
+	std::vector<int> values;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("values", values, arity = cli::Arity::Unbounded())},
+	    cli::responseFiles = true);
+
+	const std::string missing = '@' + ::testing::TempDir() + "missing.rsp";
+	const std::array<const char *, 2> unreadable{"1", missing.c_str()};
+	cli::ParseResult result = test.TryRun("test", 2, unreadable.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_RESPONSE_FILE, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Could not read response file: "
+	        + missing,
+	    result.GetMessage());
+
+	const std::string self = '@' + ::testing::TempDir() + "self.rsp";
+	WriteResponseFile("self.rsp", self);
+	const std::array<const char *, 1> recursive{self.c_str()};
+	result = test.TryRun("test", 1, recursive.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_RESPONSE_FILE, result.GetErrorCode());
+	ASSERT_EQ(0U, result.GetIndex());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Response file includes itself: "
+	        + self,
+	    result.GetMessage());
+
+	// errors within a response file refer to the argument naming it
+	const std::string bad = WriteResponseFile("bad.rsp", "1\nx\n");
+	const std::array<const char *, 3> invalid{"1", "2", bad.c_str()};
+	result = test.TryRun("test", 3, invalid.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(2U, result.GetIndex());
+}
+
+
+TEST(response_files, repeated_files)
+{
+	std::vector<int> values;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("values", values, arity = cli::Arity::Unbounded())},
+	    cli::responseFiles = true);
+
+	// a file may be named more than once, as long as not by itself
+	const std::string leaf = WriteResponseFile("leaf.rsp", "1");
+	const std::string twice =
+	    WriteResponseFile("twice.rsp", leaf + '\n' + leaf);
+	const std::array<const char *, 2> args{twice.c_str(), leaf.c_str()};
+	ASSERT_TRUE(test.TryRun("test", 2, args.data()));
+	ASSERT_EQ((std::vector<int>{1, 1, 1}), values);
+
+	// cycles through other files are found
+	const std::string first = '@' + ::testing::TempDir() + "first.rsp";
+	const std::string second = WriteResponseFile("second.rsp", "2\n" + first);
+	WriteResponseFile("first.rsp", "1\n" + second + '\n' + second);
+	const std::array<const char *, 1> cycle{first.c_str()};
+	cli::ParseResult result = test.TryRun("test", 1, cycle.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_RESPONSE_FILE, result.GetErrorCode());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Response file includes itself: "
+	        + first,
+	    result.GetMessage());
+
+	// each file names the next twice, which would read 2^16 files
+	std::string next = leaf;
+	for(int i = 0; i < 16; ++i)
+	{
+		const std::string name = "double" + std::to_string(i) + ".rsp";
+		next = WriteResponseFile(name.c_str(), next + '\n' + next);
+	}
+	const std::array<const char *, 1> exponential{next.c_str()};
+	result = test.TryRun("test", 1, exponential.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_RESPONSE_FILE, result.GetErrorCode());
+	ASSERT_EQ(0U, result.GetIndex());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Too many response files: " + leaf,
+	    result.GetMessage());
+}
+
+
+TEST(response_files, disabled_by_default)
+{
+	std::vector<std::string> values;
+	cli::CommandLine test("test", {cli::Argument("values", values)});
+
+	const std::array<const char *, 1> args{"@user"};
+	ASSERT_TRUE(test.TryRun("test", 1, args.data()));
+	ASSERT_EQ((std::vector<std::string>{"@user"}), values);
+}
+
+
+} // namespace
@@ -0,0 +1,423 @@
+#include "cli/Argument.hpp"
+#include "cli/BooleanFlags.hpp"
+#include "cli/CommandLine.hpp"
+#include "cli/InfoFlags.hpp"
+#include "cli/Lazy.hpp"
+#include "cli/Serialize.hpp"
+
+#include "TempFile.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdio>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+
+// serializes a value into a writer and reads it back into another, strings
+// viewed by the copy point into the writer
+template <typename T>
+bool RoundTrip(const T &value, T &copy, cli::SnapshotWriter &writer)
+{
+	writer.Clear();
+	cli::Serialize(value, writer);
+	const std::string &data = writer.GetData();
+	cli::SnapshotReader reader(data.data(), data.data() + data.size());
+	return cli::Deserialize(copy, reader) && reader.GetRemaining() == 0;
+}
+
+// serializes a value and reads it back into another that owns its contents
+template <typename T> bool RoundTrip(const T &value, T &copy)
+{
+	cli::SnapshotWriter writer;
+	return RoundTrip(value, copy, writer);
+}
+
+enum class Color
+{
+	RED,
+	GREEN
+};
+
+struct Point
+{
+	int x = 0;
+	int y = 0;
+	// the number of times a Point was parsed
+	static inline int parses = 0;
+	// the version of the format written by CLISerialize()
+	static inline unsigned version = 0;
+};
+
+bool CLIParse(Point &point, std::string_view input)
+{
+	++Point::parses;
+	const std::size_t comma = input.find(',');
+	return comma != std::string_view::npos
+	    && cli::Parse(point.x, input.substr(0, comma))
+	    && cli::Parse(point.y, input.substr(comma + 1));
+}
+
+void CLISerialize(const Point &point, cli::SnapshotWriter &writer)
+{
+	cli::Serialize(point.x, writer);
+	cli::Serialize(point.y, writer);
+}
+
+bool CLIDeserialize(Point &point, cli::SnapshotReader &reader)
+{
+	return cli::Deserialize(point.x, reader)
+	    && cli::Deserialize(point.y, reader);
+}
+
+unsigned CLISerializeVersion(const Point *)
+{
+	return Point::version;
+}
+
+
+TEST(snapshot, serialize)
+{
+	static_assert(cli::IsSerializable_v<std::map<std::string, Point>>);
+	static_assert(!cli::IsSerializable_v<cli::Lazy<int>>);
+	static_assert(!cli::IsSerializable_v<std::vector<cli::Lazy<int>>>);
+
+	const std::vector<std::string> strings{"a", "", "bc"};
+	std::vector<std::string> stringsCopy{"old"};
+	ASSERT_TRUE(RoundTrip(strings, stringsCopy));
+	ASSERT_EQ(strings, stringsCopy);
+
+	const std::map<std::string, std::set<int>> map{{"x", {1, 2}}, {"y", {}}};
+	std::map<std::string, std::set<int>> mapCopy{{"z", {3}}};
+	ASSERT_TRUE(RoundTrip(map, mapCopy));
+	ASSERT_EQ(map, mapCopy);
+
+	const std::vector<bool> bools{true, false, true};
+	std::vector<bool> boolsCopy;
+	ASSERT_TRUE(RoundTrip(bools, boolsCopy));
+	ASSERT_EQ(bools, boolsCopy);
+
+	const std::optional<double> empty;
+	std::optional<double> emptyCopy = 1.5;
+	ASSERT_TRUE(RoundTrip(empty, emptyCopy));
+	ASSERT_FALSE(emptyCopy.has_value());
+
+	const std::array<Color, 2> colors{Color::GREEN, Color::RED};
+	std::array<Color, 2> colorsCopy{};
+	ASSERT_TRUE(RoundTrip(colors, colorsCopy));
+	ASSERT_EQ(colors, colorsCopy);
+
+	// views point into the snapshot, which must outlive them
+	cli::SnapshotWriter writer;
+	const char *const string = "text";
+	const char *stringCopy = nullptr;
+	ASSERT_TRUE(RoundTrip(string, stringCopy, writer));
+	ASSERT_STREQ(string, stringCopy);
+	const char *const null = nullptr;
+	ASSERT_TRUE(RoundTrip(null, stringCopy, writer));
+	ASSERT_EQ(nullptr, stringCopy);
+	const std::string_view view = "view";
+	std::string_view viewCopy;
+	ASSERT_TRUE(RoundTrip(view, viewCopy, writer));
+	ASSERT_EQ(view, viewCopy);
+
+	const Point point{3, -4};
+	Point pointCopy;
+	ASSERT_TRUE(RoundTrip(point, pointCopy));
+	ASSERT_EQ(3, pointCopy.x);
+	ASSERT_EQ(-4, pointCopy.y);
+}
+
+
+TEST(snapshot, truncated)
+{
+	cli::SnapshotWriter writer;
+	cli::Serialize(std::vector<std::string>{"abc", "def"}, writer);
+	const std::string &data = writer.GetData();
+	for(std::size_t size = 0; size < data.size(); ++size)
+	{
+		cli::SnapshotReader reader(data.data(), data.data() + size);
+		std::vector<std::string> value;
+		ASSERT_FALSE(cli::Deserialize(value, reader));
+	}
+
+	// sizes larger than the snapshot fail before anything is reserved
+	cli::SnapshotWriter huge;
+	huge.WriteSize(static_cast<std::size_t>(-1));
+	cli::SnapshotReader reader(
+	    huge.GetData().data(), huge.GetData().data() + huge.GetData().size());
+	std::vector<int> value;
+	ASSERT_FALSE(cli::Deserialize(value, reader));
+}
+
+
+TEST(snapshot, run)
+{
+	int threads = 0;
+	std::vector<Point> points;
+	std::string_view name;
+	bool verbose = false;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("points", points),
+	     cli::Argument("--threads", threads),
+	     cli::Argument("--name", name, cli::arity = cli::Arity::Optional()),
+	     cli::StoreTrue("--verbose", verbose),
+	     cli::Help("--help")},
+	    cli::responseFiles = true);
+	cli::ParseContext context = test.MakeContext();
+	const std::string snapshot = ::testing::TempDir() + "run.snapshot";
+	std::remove(snapshot.c_str());
+	context.SetSnapshotFile(snapshot.c_str());
+	const std::string response =
+	    '@' + WriteTempFile("run.rsp", "--threads\n4\n--verbose");
+	const std::array<const char *, 5> args{
+	    "--name", "main", "1,2", "3,4", response.c_str()};
+
+	// the first run parses and writes the snapshot
+	Point::parses = 0;
+	ASSERT_TRUE(test.TryRun(context, "test", 5, args.data()));
+	ASSERT_EQ(2, Point::parses);
+	ASSERT_EQ(4, threads);
+
+	// the second run reads it
+	threads = 0;
+	points.clear();
+	name = {};
+	verbose = false;
+	ASSERT_TRUE(test.TryRun(context, "test", 5, args.data()));
+	ASSERT_EQ(2, Point::parses);
+	ASSERT_EQ(4, threads);
+	ASSERT_EQ(2U, points.size());
+	ASSERT_EQ(3, points[1].x);
+	ASSERT_EQ("main", name);
+	ASSERT_TRUE(verbose);
+
+	// different arguments are parsed
+	ASSERT_TRUE(test.TryRun(context, "test", 3, args.data() + 2));
+	ASSERT_EQ(4, Point::parses);
+
+	// as is a changed response file
+	ASSERT_TRUE(test.TryRun(context, "test", 5, args.data()));
+	ASSERT_EQ(6, Point::parses);
+	WriteTempFile("run.rsp", "--threads\n16");
+	ASSERT_TRUE(test.TryRun(context, "test", 5, args.data()));
+	ASSERT_EQ(8, Point::parses);
+	ASSERT_EQ(16, threads);
+	ASSERT_TRUE(test.TryRun(context, "test", 5, args.data()));
+	ASSERT_EQ(8, Point::parses);
+
+	// a corrupt snapshot is replaced
+	WriteTempFile("run.snapshot", "corrupt");
+	ASSERT_TRUE(test.TryRun(context, "test", 5, args.data()));
+	ASSERT_EQ(10, Point::parses);
+	ASSERT_TRUE(test.TryRun(context, "test", 5, args.data()));
+	ASSERT_EQ(10, Point::parses);
+
+	// failed runs and help do not replace the snapshot
+	const std::array<const char *, 2> failing{"5,6", "--threads"};
+	ASSERT_FALSE(test.TryRun(context, "test", 2, failing.data()));
+	const std::array<const char *, 1> help{"--help"};
+	ASSERT_TRUE(test.TryRun(context, "test", 1, help.data()).IsExit());
+	ASSERT_TRUE(test.TryRun(context, "test", 5, args.data()));
+	ASSERT_EQ(11, Point::parses);
+	std::remove(snapshot.c_str());
+}
+
+
+// a value that fails to parse or deserialize while isBroken is set
+struct Fragile
+{
+	int value = 0;
+	static inline bool isBroken = false;
+};
+
+bool CLIParse(Fragile &fragile, std::string_view input)
+{
+	return !Fragile::isBroken && cli::Parse(fragile.value, input);
+}
+
+void CLISerialize(const Fragile &fragile, cli::SnapshotWriter &writer)
+{
+	cli::Serialize(fragile.value, writer);
+}
+
+bool CLIDeserialize(Fragile &fragile, cli::SnapshotReader &reader)
+{
+	return !Fragile::isBroken && cli::Deserialize(fragile.value, reader);
+}
+
+
+TEST(snapshot, invalid_value)
+{
+	int threads = 0;
+	std::string name;
+	Fragile fragile;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("--threads", threads),
+	     cli::Argument("--name", name),
+	     cli::Argument("--fragile", fragile)});
+	cli::ParseContext context = test.MakeContext();
+	const std::string snapshot = ::testing::TempDir() + "invalid.snapshot";
+	std::remove(snapshot.c_str());
+	context.SetSnapshotFile(snapshot.c_str());
+	const std::array<const char *, 6> args{
+	    "--fragile", "3", "--threads", "4", "--name", "main"};
+	Fragile::isBroken = false;
+	ASSERT_TRUE(test.TryRun(context, "test", 6, args.data()));
+
+	// the snapshot matches, but its last value can not be read, so it sets
+	// nothing and the run is parsed, failing before the other flags
+	threads = 0;
+	name.clear();
+	fragile.value = 0;
+	Fragile::isBroken = true;
+	const cli::ParseResult result =
+	    test.TryRun(context, "test", 6, args.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+	ASSERT_EQ(0, threads);
+	ASSERT_EQ("", name);
+	ASSERT_EQ(0, fragile.value);
+	Fragile::isBroken = false;
+	std::remove(snapshot.c_str());
+}
+
+
+TEST(snapshot, environment)
+{
+	int threads = 0;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument(
+	        "--threads", threads, cli::environment = "SNAPSHOT_THREADS")});
+	cli::ParseContext context = test.MakeContext();
+	const std::string snapshot = ::testing::TempDir() + "env.snapshot";
+	std::remove(snapshot.c_str());
+	context.SetSnapshotFile(snapshot.c_str());
+	std::array<const char *, 3> environment{
+	    "OTHER=1", "SNAPSHOT_THREADS=2", nullptr};
+	context.SetEnvironment(environment.data());
+	const char *const noArgs[] = {nullptr};
+
+	ASSERT_TRUE(test.TryRun(context, "test", 0, noArgs));
+	ASSERT_EQ(2, threads);
+	threads = 0;
+	ASSERT_TRUE(test.TryRun(context, "test", 0, noArgs));
+	ASSERT_EQ(2, threads);
+
+	// unbound variables do not matter, bound ones do
+	environment[0] = "OTHER=2";
+	threads = 0;
+	ASSERT_TRUE(test.TryRun(context, "test", 0, noArgs));
+	ASSERT_EQ(2, threads);
+	environment[1] = "SNAPSHOT_THREADS=3";
+	ASSERT_TRUE(test.TryRun(context, "test", 0, noArgs));
+	ASSERT_EQ(3, threads);
+	std::remove(snapshot.c_str());
+}
+
+
+TEST(snapshot, command_strings)
+{
+	std::string_view name;
+	cli::CommandLine test("test", {cli::Argument("--name", name)});
+	cli::ParseContext context = test.MakeContext();
+	const std::string snapshot = ::testing::TempDir() + "string.snapshot";
+	std::remove(snapshot.c_str());
+	context.SetSnapshotFile(snapshot.c_str());
+
+	// command strings neither write a snapshot
+	ASSERT_TRUE(test.TryRun(context, "test", "--name main"));
+	ASSERT_EQ(nullptr, std::fopen(snapshot.c_str(), "rb"));
+
+	// nor read one written by argv with the same arguments, views of an in
+	// place run point into its buffer
+	const std::array<const char *, 2> args{"--name", "main"};
+	ASSERT_TRUE(test.TryRun(context, "test", 2, args.data()));
+	std::string buffer = "--name main";
+	ASSERT_TRUE(test.TryRunInPlace(
+	    context, "test", buffer.data(), buffer.data() + buffer.size()));
+	ASSERT_EQ(buffer.data() + 7, name.data());
+	std::remove(snapshot.c_str());
+}
+
+
+TEST(snapshot, types)
+{
+	const std::string snapshot = ::testing::TempDir() + "types.snapshot";
+	std::remove(snapshot.c_str());
+	const std::array<const char *, 4> args{
+	    "--x", "1065353216", "--point", "1,2"};
+	int x = 0;
+	Point point;
+	cli::CommandLine ints(
+	    "test",
+	    {cli::Argument("--x", x), cli::Argument("--point", point)});
+	cli::ParseContext context = ints.MakeContext();
+	context.SetSnapshotFile(snapshot.c_str());
+	ASSERT_TRUE(ints.TryRun(context, "test", 4, args.data()));
+	ASSERT_EQ(1065353216, x);
+
+	// the same names with a float parse instead of reading the bits of the
+	// int, which are 1.0f
+	float y = 0;
+	cli::CommandLine floats(
+	    "test",
+	    {cli::Argument("--x", y), cli::Argument("--point", point)});
+	ASSERT_TRUE(floats.TryRun(context, "test", 4, args.data()));
+	ASSERT_EQ(1065353216.0f, y);
+
+	// a user defined type is parsed again when its version changes
+	y = 0;
+	const int parses = Point::parses;
+	ASSERT_TRUE(floats.TryRun(context, "test", 4, args.data()));
+	ASSERT_EQ(1065353216.0f, y);
+	ASSERT_EQ(parses, Point::parses);
+	++Point::version;
+	cli::CommandLine versioned(
+	    "test",
+	    {cli::Argument("--x", y), cli::Argument("--point", point)});
+	ASSERT_TRUE(versioned.TryRun(context, "test", 4, args.data()));
+	ASSERT_EQ(parses + 1, Point::parses);
+	Point::version = 0;
+	std::remove(snapshot.c_str());
+
+	ASSERT_NE(
+	    cli::GetSerializeFingerprint<int>(),
+	    cli::GetSerializeFingerprint<unsigned>());
+	ASSERT_NE(
+	    cli::GetSerializeFingerprint<std::vector<int>>(),
+	    cli::GetSerializeFingerprint<std::set<int>>());
+	ASSERT_EQ(
+	    cli::GetSerializeFingerprint<std::string>(),
+	    cli::GetSerializeFingerprint<std::string_view>());
+	ASSERT_NE(
+	    (cli::GetSerializeFingerprint<std::map<int, std::string>>()),
+	    (cli::GetSerializeFingerprint<std::map<std::string, int>>()));
+}
+
+
+TEST(snapshot, not_serializable)
+{
+	cli::Lazy<int> count;
+	cli::CommandLine test("test", {cli::Argument("--count", count)});
+	cli::ParseContext context = test.MakeContext();
+	context.SetSnapshotFile("unused.snapshot");
+	const std::array<const char *, 2> args{"--count", "1"};
+	ASSERT_EQ(
+	    cli::ErrorCode::INVALID_CALL,
+	    test.TryRun(context, "test", 2, args.data()).GetErrorCode());
+}
+
+
+} // namespace
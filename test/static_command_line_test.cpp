@@ -0,0 +1,133 @@
+#include "cli/StaticArgument.hpp"
+#include "cli/StaticCommandLine.hpp"
+
+#include "ErrorAssertions.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+
+using cli::arity;
+using cli::help;
+
+constexpr char flagName[] = "--flag";
+constexpr char valuesName[] = "values";
+constexpr char boolName[] = "--bool";
+constexpr char falseName[] = "--no-bool";
+constexpr char arrayName[] = "--array";
+constexpr char helpName[] = "--help";
+
+
+TEST(static_command_line, flag)
+{
+	std::optional<int> value;
+	cli::StaticCommandLine test(
+	    "test", cli::StaticArgument<flagName>(value, help = "test flag"));
+	std::array<const char *, 2> args{"--flag", "1"};
+	ASSERT_FALSE(test.Run("test", 2, args.data()));
+	ASSERT_TRUE(value.has_value());
+	ASSERT_EQ(1, *value);
+}
+
+
+TEST(static_command_line, positional)
+{
+	std::vector<int> values;
+	bool boolFlag;
+	cli::StaticCommandLine test(
+	    "test",
+	    cli::StaticStoreTrue<boolName>(boolFlag),
+	    cli::StaticArgument<valuesName>(
+	        values, arity = cli::Arity::AtLeast(1)));
+	std::array<const char *, 3> args{"1", "--bool", "2"};
+	test.Run("test", 3, args.data());
+	ASSERT_TRUE(boolFlag);
+	ASSERT_EQ((std::vector<int>{1, 2}), values);
+
+	CLI_ASSERT_ERROR(test.Run("test", 0, args.data()), std::invalid_argument);
+}
+
+
+TEST(static_command_line, repeated_runs)
+{
+	bool trueFlag;
+	bool falseFlag;
+	cli::StaticCommandLine test(
+	    "test",
+	    cli::StaticStoreTrue<boolName>(trueFlag),
+	    cli::StaticStoreFalse<falseName>(falseFlag));
+	std::array<const char *, 2> args{"--bool", "--no-bool"};
+	for(int run = 0; run < 2; ++run)
+	{
+		test.Run("test", 2, args.data());
+		ASSERT_TRUE(trueFlag);
+		ASSERT_FALSE(falseFlag);
+	}
+}
+
+
+TEST(static_command_line, array)
+{
+	std::array<int, 2> array{0, 0};
+	cli::StaticCommandLine test("test", cli::StaticArgument<arrayName>(array));
+	std::array<const char *, 4> args{"--array", "1", "--array", "2"};
+	test.Run("test", 4, args.data());
+	ASSERT_EQ(1, array[0]);
+	ASSERT_EQ(2, array[1]);
+
+	std::array<const char *, 6> tooMany{
+	    "--array", "1", "--array", "2", "--array", "3"};
+	CLI_ASSERT_ERROR(
+	    test.Run("test", 6, tooMany.data()), std::invalid_argument);
+}
+
+
+TEST(static_command_line, errors)
+{
+	int value = 0;
+	cli::StaticCommandLine test("test", cli::StaticArgument<flagName>(value));
+
+	std::array<const char *, 1> unknown{"--flags"};
+	CLI_ASSERT_ERROR(
+	    test.Run("test", 1, unknown.data()), std::invalid_argument);
+
+	std::array<const char *, 1> missingValue{"--flag"};
+	CLI_ASSERT_ERROR(
+	    test.Run("test", 1, missingValue.data()), std::invalid_argument);
+
+	std::array<const char *, 1> unhandled{"1"};
+	CLI_ASSERT_ERROR(
+	    test.Run("test", 1, unhandled.data()), std::invalid_argument);
+
+	std::array<const char *, 4> twice{"--flag", "1", "--flag", "2"};
+	CLI_ASSERT_ERROR(test.Run("test", 4, twice.data()), std::invalid_argument);
+
+	std::array<const char *, 2> bad{"--flag", "bad"};
+	CLI_ASSERT_ERROR(test.Run("test", 2, bad.data()), std::invalid_argument);
+}
+
+
+TEST(static_command_line, help)
+{
+	int value = 0;
+	cli::StaticCommandLine test(
+	    "test",
+	    cli::StaticHelp<helpName>(),
+	    cli::StaticArgument<flagName>(value, help = "test flag"));
+	ASSERT_EQ("test [--help] --flag flag", test.GetUsage("test"));
+
+	testing::internal::CaptureStdout();
+	std::array<const char *, 1> args{"--help"};
+	ASSERT_TRUE(test.Run("test", 1, args.data()));
+	ASSERT_EQ(test.GetHelp("test"), testing::internal::GetCapturedStdout());
+}
+
+
+} // namespace
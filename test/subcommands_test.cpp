@@ -0,0 +1,171 @@
+#include "cli/Argument.hpp"
+#include "cli/BooleanFlags.hpp"
+#include "cli/CommandLine.hpp"
+#include "cli/InfoFlags.hpp"
+#include "cli/Subcommands.hpp"
+
+#include "ErrorAssertions.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace
+{
+
+// a program with two subcommands that counts how often each is built
+struct Program
+{
+	std::string message;
+	bool all = false;
+	int depth = 0;
+	std::size_t commitBuilds = 0;
+	std::size_t cloneBuilds = 0;
+
+	cli::Subcommands MakeSubcommands()
+	{
+		return cli::Subcommands(
+		    "test program",
+		    {cli::Subcommand(
+		         "commit",
+		         [this]() {
+			         ++commitBuilds;
+			         return cli::CommandLine(
+			             "records changes",
+			             {cli::Argument("--message", message),
+			              cli::StoreTrue("--all", all)});
+		         },
+		         cli::help = "records changes"),
+		     cli::Subcommand(
+		         "clone",
+		         [this]() {
+			         ++cloneBuilds;
+			         return cli::CommandLine(
+			             "copies a repository",
+			             {cli::Argument(
+			                 "--depth",
+			                 depth,
+			                 cli::arity = cli::Arity::Optional())});
+		         },
+		         cli::help = "copies a repository")},
+		    {cli::Help("--help", cli::shortName = 'h'),
+		     cli::Version("--version", "1.0")});
+	}
+};
+
+TEST(subcommands, dispatch)
+{
+	Program program;
+	cli::Subcommands test = program.MakeSubcommands();
+	ASSERT_EQ(nullptr, test.GetSelected());
+	ASSERT_EQ(nullptr, test.GetCommandLine());
+
+	const std::array<const char *, 4> args{"commit", "--message", "m", "--all"};
+	ASSERT_TRUE(test.TryRun("test", 4, args.data()));
+	ASSERT_STREQ("commit", test.GetSelected());
+	ASSERT_EQ(0U, test.GetSelectedIndex());
+	ASSERT_NE(nullptr, test.GetCommandLine());
+	ASSERT_EQ("m", program.message);
+	ASSERT_TRUE(program.all);
+	// only the chosen subcommand is built
+	ASSERT_EQ(1U, program.commitBuilds);
+	ASSERT_EQ(0U, program.cloneBuilds);
+
+	const std::array<const char *, 2> clone{"prog", "clone"};
+	ASSERT_TRUE(test.TryRun(2, clone.data()));
+	ASSERT_STREQ("clone", test.GetSelected());
+	ASSERT_EQ(1U, program.cloneBuilds);
+}
+
+TEST(subcommands, errors)
+{
+	Program program;
+	cli::Subcommands test = program.MakeSubcommands();
+
+	cli::ParseResult result = test.TryRun("test", 0, nullptr);
+	ASSERT_EQ(cli::ErrorCode::INVALID_CALL, result.GetErrorCode());
+
+	const std::array<const char *, 1> none{"prog"};
+	result = test.TryRun(1, none.data());
+	ASSERT_EQ(cli::ErrorCode::MISSING_COMMAND, result.GetErrorCode());
+	ASSERT_EQ(cli::ParseResult::npos, result.GetIndex());
+
+	const std::array<const char *, 2> unknown{"prog", "pull"};
+	result = test.TryRun(2, unknown.data());
+	ASSERT_EQ(cli::ErrorCode::UNKNOWN_COMMAND, result.GetErrorCode());
+	ASSERT_EQ(1U, result.GetIndex());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Unknown command: pull",
+	    result.GetMessage());
+	ASSERT_EQ(nullptr, test.GetSelected());
+	ASSERT_EQ(nullptr, result.GetSuggestion());
+
+	const std::array<const char *, 2> typo{"prog", "comit"};
+	result = test.TryRun(2, typo.data());
+	ASSERT_EQ(cli::ErrorCode::UNKNOWN_COMMAND, result.GetErrorCode());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Unknown command: comit.  Did you "
+	    "mean commit?",
+	    result.GetMessage());
+
+	const std::array<const char *, 2> flag{"prog", "--verbose"};
+	result = test.TryRun(2, flag.data());
+	ASSERT_EQ(cli::ErrorCode::UNKNOWN_FLAG, result.GetErrorCode());
+
+	// indices of failures within the subcommand are indices into argv
+	const std::array<const char *, 4> invalid{"prog", "clone", "--depth", "x"};
+	result = test.TryRun(4, invalid.data());
+	ASSERT_EQ(cli::ErrorCode::INVALID_VALUE, result.GetErrorCode());
+	ASSERT_EQ(3U, result.GetIndex());
+	ASSERT_EQ(0U, program.commitBuilds);
+
+	CLI_ASSERT_ERROR(
+	    cli::Subcommands(
+	        "test",
+	        {cli::Subcommand(
+	            "--commit", []() { return cli::CommandLine("test", {}); })}),
+	    std::invalid_argument);
+}
+
+TEST(subcommands, help)
+{
+	Program program;
+	cli::Subcommands test = program.MakeSubcommands();
+	ASSERT_EQ(
+	    "test [--help] [--version] command [arguments]...",
+	    test.GetUsage("test"));
+	ASSERT_EQ(
+	    "test program\n\n"
+	    "Usage: \n"
+	    "  test [--help] [--version] command [arguments]...\n\n"
+	    "Commands: \n"
+	    "  commit: records changes\n"
+	    "  clone: copies a repository\n\n"
+	    "Arguments: \n"
+	    "  -h, --help: prints this help message and exits\n"
+	    "  --version: prints version and exits\n",
+	    test.GetHelp("test"));
+	ASSERT_EQ(0U, program.commitBuilds + program.cloneBuilds);
+
+	testing::internal::CaptureStdout();
+	const std::array<const char *, 1> args{"--help"};
+	ASSERT_TRUE(test.Run("test", 1, args.data()));
+	ASSERT_EQ(test.GetHelp("test"), testing::internal::GetCapturedStdout());
+	testing::internal::CaptureStdout();
+	const std::array<const char *, 1> shortArgs{"-h"};
+	ASSERT_TRUE(test.Run("test", 1, shortArgs.data()));
+	ASSERT_EQ(test.GetHelp("test"), testing::internal::GetCapturedStdout());
+	ASSERT_EQ(nullptr, test.GetSelected());
+
+	// the help of a subcommand only builds that subcommand
+	const std::string commitHelp = test.GetHelp("test", "commit");
+	ASSERT_NE(std::string::npos, commitHelp.find("test commit"));
+	ASSERT_NE(std::string::npos, commitHelp.find("--message"));
+	ASSERT_EQ(1U, program.commitBuilds);
+	ASSERT_EQ(0U, program.cloneBuilds);
+	ASSERT_EQ("", test.GetHelp("test", "pull"));
+}
+
+} // namespace
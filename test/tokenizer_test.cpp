@@ -0,0 +1,151 @@
+#include "cli/Argument.hpp"
+#include "cli/BooleanFlags.hpp"
+#include "cli/CommandLine.hpp"
+#include "cli/details/Tokenizer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using cli::details::Tokenizer;
+
+std::vector<std::string> Tokens(const Tokenizer &tokenizer)
+{
+	return std::vector<std::string>(
+	    tokenizer.GetArguments(),
+	    tokenizer.GetArguments() + tokenizer.GetCount());
+}
+
+std::vector<std::string> Tokenize(const std::string &input)
+{
+	Tokenizer tokenizer;
+	EXPECT_EQ(
+	    Tokenizer::Status::OK, tokenizer.Tokenize(input.data(), input.size()));
+	return Tokens(tokenizer);
+}
+
+TEST(tokenizer, whitespace)
+{
+	ASSERT_EQ(std::vector<std::string>{}, Tokenize(""));
+	ASSERT_EQ(std::vector<std::string>{}, Tokenize(" \t\r\n "));
+	ASSERT_EQ(
+	    (std::vector<std::string>{"a", "bc", "d"}), Tokenize("  a bc\t\td\n"));
+}
+
+TEST(tokenizer, quotes)
+{
+	ASSERT_EQ(
+	    (std::vector<std::string>{"a b", "c\"d", "e'f"}),
+	    Tokenize("'a b' 'c\"d' \"e'f\""));
+	ASSERT_EQ(
+	    (std::vector<std::string>{"", "", "xyz"}),
+	    Tokenize("'' \"\" x'y'\"z\""));
+	ASSERT_EQ(
+	    (std::vector<std::string>{"$x `y` \"q\" \\ \\n"}),
+	    Tokenize(R"("\$x \`y\` \"q\" \\ \n")"));
+	ASSERT_EQ((std::vector<std::string>{"ab"}), Tokenize("\"a\\\nb\""));
+}
+
+TEST(tokenizer, escapes)
+{
+	ASSERT_EQ(
+	    (std::vector<std::string>{"a b", "'", "\"", "\\", "ab"}),
+	    Tokenize(R"(a\ b \' \" \\ a\)"
+	             "\nb"));
+	ASSERT_EQ((std::vector<std::string>{"\\'"}), Tokenize(R"('\'\''')"));
+
+	// escaped newlines between arguments are not arguments
+	ASSERT_EQ((std::vector<std::string>{"a", "b"}), Tokenize("a \\\n b"));
+	ASSERT_EQ((std::vector<std::string>{"a", "b"}), Tokenize("a\\\n\\\n b"));
+	ASSERT_EQ((std::vector<std::string>{"a"}), Tokenize("\\\na \\\n"));
+}
+
+TEST(tokenizer, errors)
+{
+	Tokenizer tokenizer;
+	ASSERT_EQ(
+	    Tokenizer::Status::UNTERMINATED_QUOTE, tokenizer.Tokenize("a 'b", 4));
+	ASSERT_EQ(1, tokenizer.GetCount());
+	ASSERT_EQ(
+	    Tokenizer::Status::UNTERMINATED_QUOTE,
+	    tokenizer.Tokenize("\"b\\\"", 4));
+	ASSERT_EQ(
+	    Tokenizer::Status::TRAILING_BACKSLASH, tokenizer.Tokenize("a b\\", 4));
+	ASSERT_EQ(1, tokenizer.GetCount());
+}
+
+TEST(tokenizer, long_input)
+{
+	// every special character at every offset of a vector
+	const std::string specials = " \t\n\v\f\r'\"\\";
+	for(const char special : specials)
+	{
+		for(std::size_t offset = 0; offset < 70; ++offset)
+		{
+			std::string input(70, 'x');
+			input[offset] = special;
+			const char *const begin = input.data();
+			const char *const end = begin + input.size();
+			ASSERT_EQ(begin + offset, Tokenizer::FindSpecial(begin, end));
+			ASSERT_EQ(begin + offset, Tokenizer::FindSpecialScalar(begin, end));
+		}
+	}
+	// bytes with the high bit set are not whitespace
+	const std::string high(40, '\x89');
+	ASSERT_EQ(
+	    high.data() + high.size(),
+	    Tokenizer::FindSpecial(high.data(), high.data() + high.size()));
+
+	const std::string word(100, 'w');
+	const std::string quoted(100, 'q');
+	ASSERT_EQ(
+	    (std::vector<std::string>{word + quoted + word, word}),
+	    Tokenize(word + "'" + quoted + "'" + word + "  " + word));
+}
+
+TEST(tokenizer, in_place)
+{
+	char input[] = "--name 'a b'\"c\"";
+	Tokenizer tokenizer;
+	ASSERT_EQ(
+	    Tokenizer::Status::OK,
+	    tokenizer.TokenizeInPlace(input, input + sizeof(input) - 1));
+	ASSERT_EQ((std::vector<std::string>{"--name", "a bc"}), Tokens(tokenizer));
+	ASSERT_EQ(input, tokenizer.GetArguments()[0]);
+	ASSERT_EQ(input + 7, tokenizer.GetArguments()[1]);
+}
+
+TEST(tokenizer, command_line)
+{
+	std::vector<std::string> files;
+	bool verbose = false;
+	cli::CommandLine test(
+	    "test",
+	    {cli::Argument("files", files), cli::StoreTrue("--verbose", verbose)});
+
+	ASSERT_TRUE(test.TryRun("test", "--verbose 'my file.txt' b\\ c"));
+	ASSERT_TRUE(verbose);
+	ASSERT_EQ((std::vector<std::string>{"my file.txt", "b c"}), files);
+
+	files.clear();
+	ASSERT_TRUE(test.TryRun("test", ""));
+	ASSERT_TRUE(files.empty());
+
+	const cli::ParseResult result = test.TryRun("test", "a \"b");
+	ASSERT_EQ(cli::ErrorCode::INVALID_COMMAND_STRING, result.GetErrorCode());
+	ASSERT_EQ(1, result.GetIndex());
+	ASSERT_EQ(
+	    "Invalid command line arguments.  Unterminated quote in command "
+	    "string.",
+	    result.GetMessage());
+
+	const cli::ParseResult unknown = test.TryRun("test", "a --bad");
+	ASSERT_EQ(cli::ErrorCode::UNKNOWN_FLAG, unknown.GetErrorCode());
+	ASSERT_EQ(1, unknown.GetIndex());
+}
+
+} // namespace